@@ -18,10 +18,13 @@
 #include <pybind11/embed.h>
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <utility>
 
 #include "cinn/auto_schedule/database/jsonfile_database.h"
+#include "cinn/auto_schedule/measure/isolated_runner.h"
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
 #include "cinn/auto_schedule/measure/simple_builder.h"
 #include "cinn/auto_schedule/measure/simple_runner.h"
@@ -41,22 +44,37 @@ namespace auto_schedule {
 AutoTuner::AutoTuner(const common::Target& target, hlir::framework::Graph* graph) : target_(target), graph_(graph) {}
 
 void AutoTuner::Initialize(const Config& config, hlir::framework::GraphCompiler* graph_compiler) {
+  config_ = config;
+  CHECK_GT(config_.checkpoint_interval_rounds, 0) << "Invalid checkpoint_interval_rounds";
+  CHECK_GT(config_.num_kept_checkpoints, 0) << "Invalid num_kept_checkpoints";
   // create builder, runner, and schedule measurer
-  builder_           = std::make_unique<SimpleBuilder>(graph_compiler);
-  runner_            = std::make_unique<SimpleRunner>(config.runner_repeat_times);
-  schedule_measurer_ = std::make_unique<ScheduleMeasurer>(builder_.get(), runner_.get());
+  builder_ = std::make_unique<SimpleBuilder>(graph_compiler);
+  if (config.runner_adaptive_repeat) {
+    runner_ = std::make_unique<SimpleRunner>(config.runner_adaptive_config);
+  } else {
+    runner_ = std::make_unique<SimpleRunner>(config.runner_repeat_times);
+  }
+  if (config.runner_isolated) {
+    runner_ = std::make_unique<IsolatedRunner>(std::move(runner_), config.runner_timeout_ms);
+  }
+  schedule_measurer_ = std::make_unique<ScheduleMeasurer>(builder_.get(), runner_.get(), config.measure_num_threads);
 
   // initialize database
   database_ = std::move(Database::Make(config.database_config));
 
+  const auto& dtype_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  const auto& shape_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
+  op_lowerer_            = std::make_unique<hlir::framework::OpLowerer>(dtype_dict, shape_dict, target_);
+
   // create tasks
   TaskCreator task_creator;
   tasks_ = task_creator.CreateTuneTaskOpLevel(graph_);
+  if (config.tune_fusion) {
+    FusionTuner fusion_tuner(
+        graph_, op_lowerer_.get(), schedule_measurer_.get(), database_.get(), config.fusion_tuner_config);
+    tasks_ = task_creator.CreateTuneTaskOpLevel(fusion_tuner.Tune(graph_->fusion_groups), target_);
+  }
 
-  const auto& dtype_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
-  const auto& shape_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
-
-  op_lowerer_                        = std::make_unique<hlir::framework::OpLowerer>(dtype_dict, shape_dict, target_);
   InitialTaskRegistry* task_registry = InitialTaskRegistry::Global();
   for (auto i = 0; i < tasks_.size(); ++i) {
     auto&& task = tasks_[i];
@@ -75,7 +93,8 @@ void AutoTuner::Initialize(const Config& config, hlir::framework::GraphCompiler*
   });
 
   // create task scheduler
-  task_scheduler_ = TaskScheduler::Make(tasks_, config.task_schedule_config, config.task_schedule_strategy);
+  task_scheduler_ =
+      TaskScheduler::Make(tasks_, config.task_schedule_config, config.task_schedule_strategy, database_.get());
 }
 
 void PrintResult(std::shared_ptr<hlir::framework::Graph::Group> group) {
@@ -125,22 +144,34 @@ void PrintResult(const TuningResult& result) {
   VLOG(3) << "###### TuningResult End ######";
 }
 
-TuningResult AutoTuner::Tune(const TuningOptions& options) {
+TuningResult AutoTuner::Tune(const TuningOptions& options) { return TuneRounds(options, 0); }
+
+TuningResult AutoTuner::Resume(const TuningOptions& options) {
+  int finished_rounds = LoadCheckpoint();
+  if (finished_rounds >= options.num_tuning_rounds) {
+    // the result isn't saved in the checkpoint, so tune the last round again to produce it
+    LOG(INFO) << "All the " << finished_rounds << " rounds have been tuned, tune the last round again";
+    finished_rounds = options.num_tuning_rounds - 1;
+  }
+  return TuneRounds(options, finished_rounds);
+}
+
+TuningResult AutoTuner::TuneRounds(const TuningOptions& options, int start_round) {
   CHECK_GT(options.num_tuning_rounds, 0) << "Invalid config";
-  VLOG(3) << "Begin tuning with round num=" << options.num_tuning_rounds << ", tasks size=" << tasks_.size();
+  VLOG(3) << "Begin tuning with round num=" << options.num_tuning_rounds << ", start round=" << start_round
+          << ", tasks size=" << tasks_.size();
 
   TuningResult result;
   result.subgraphs.resize(tasks_.size());
   result.function_groups.resize(tasks_.size());
-  // A task only tunes schedule now, so we populate its sub_graph
-  // as default result of graph tuning, and that should be updated
-  // once we support graph tuning.
+  // The fusion partition is tuned on creating tasks, so a task
+  // populates its sub_graph as the result of graph tuning.
   for (auto i = 0; i < tasks_.size(); ++i) {
     auto&& task         = tasks_.at(i);
     result.subgraphs[i] = task.subgraph;
   }
 
-  for (int r = 0; r < options.num_tuning_rounds; ++r) {
+  for (int r = start_round; r < options.num_tuning_rounds; ++r) {
     VLOG(3) << "<<<<<< Round " << r << " >>>>>>";
     int run_id = -1;
     task_scheduler_->Reset();
@@ -153,11 +184,153 @@ TuningResult AutoTuner::Tune(const TuningOptions& options) {
       // update the best schedules searched so far.
       result.function_groups.at(run_id) = std::move(function_group);
     }
+    if (!config_.checkpoint_dir.empty() &&
+        ((r + 1) % config_.checkpoint_interval_rounds == 0 || r + 1 == options.num_tuning_rounds)) {
+      SaveCheckpoint(r + 1);
+    }
+  }
+
+  if (start_round > 0) {
+    // a task not dispatched in the resumed rounds is optimized on the records tuned before without measurement
+    TuningOptions resumed_options      = options;
+    resumed_options.num_measure_trials = 0;
+    for (int i = 0; i < tasks_.size(); ++i) {
+      if (result.function_groups.at(i).empty()) {
+        result.function_groups.at(i) = task_optimizers_.at(i)->Optimize(resumed_options);
+      }
+    }
   }
 
   PrintResult(result);
   return result;
 }
 
+namespace {
+constexpr char kCheckpointMagic[] = "cinn_auto_tuner_checkpoint";
+constexpr int kCheckpointVersion  = 3;
+
+// The prefix of the files saving the state of a task optimizer at a checkpoint
+std::string TaskCheckpointPrefix(const std::string& dir, int task_id, int checkpoint_id) {
+  return utils::StringFormat("%s/task_%d.checkpoint_%d", dir.c_str(), task_id, checkpoint_id);
+}
+
+// The file saving the state of the tuner at a checkpoint
+std::string TunerCheckpointPath(const std::string& dir, int checkpoint_id) {
+  return utils::StringFormat("%s/auto_tuner.checkpoint_%d.state", dir.c_str(), checkpoint_id);
+}
+
+// The file referring to the id of the latest checkpoint
+std::string LatestCheckpointPath(const std::string& dir) { return dir + "/auto_tuner.state"; }
+
+void RemoveCheckpoint(const std::string& dir, int checkpoint_id, int num_tasks) {
+  for (int i = 0; i < num_tasks; ++i) {
+    for (const char* suffix : {".cost_model", ".samples", ".state"}) {
+      std::remove((TaskCheckpointPrefix(dir, i, checkpoint_id) + suffix).c_str());
+    }
+  }
+  std::remove(TunerCheckpointPath(dir, checkpoint_id).c_str());
+}
+
+// Write a file by writer into a temporary one and then rename it to path,
+// so the file is either replaced entirely or left intact
+template <typename WriterT>
+void WriteFileAtomically(const std::string& path, WriterT&& writer) {
+  std::ofstream os(path + ".tmp");
+  CHECK(os.is_open()) << "Failed to open " << path << ".tmp to save the checkpoint";
+  writer(os);
+  os.close();
+  CHECK(!os.fail()) << "Failed to save the checkpoint to " << path << ".tmp";
+  CHECK_EQ(std::rename((path + ".tmp").c_str(), path.c_str()), 0) << "Failed to replace " << path;
+}
+}  // namespace
+
+// All the files of a checkpoint are named by a new checkpoint id, and then the file referring to
+// the latest id is replaced atomically, so an interrupted checkpoint leaves the last one intact.
+// Only the latest Config::num_kept_checkpoints checkpoints are kept.
+void AutoTuner::SaveCheckpoint(int finished_rounds) {
+  const std::string& dir = config_.checkpoint_dir;
+  CHECK(hlir::framework::MakeDirectory(dir + "/", S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH))
+      << "Failed to create the checkpoint directory " << dir;
+  int checkpoint_id = last_checkpoint_id_ + 1;
+  for (int i = 0; i < task_optimizers_.size(); ++i) {
+    task_optimizers_[i]->SaveCheckpoint(TaskCheckpointPrefix(dir, i, checkpoint_id));
+  }
+
+  WriteFileAtomically(TunerCheckpointPath(dir, checkpoint_id), [&](std::ofstream& os) {
+    os << finished_rounds << " " << tasks_.size() << "\n";
+    // the task keys to check the checkpoint is resumed on the same tasks
+    for (const auto& task : tasks_) {
+      os << task.serialized_key.size() << "\n" << task.serialized_key << "\n";
+    }
+    for (int i = 0; i < task_optimizers_.size(); ++i) {
+      os << task_optimizers_[i]->NumMeasuredTrials() << (i + 1 == task_optimizers_.size() ? "\n" : " ");
+    }
+    os << task_scheduler_->Name() << "\n";
+    task_scheduler_->SaveState(os);
+  });
+  WriteFileAtomically(LatestCheckpointPath(dir), [&](std::ofstream& os) {
+    os << kCheckpointMagic << " " << kCheckpointVersion << "\n" << checkpoint_id << "\n";
+  });
+
+  if (checkpoint_id >= config_.num_kept_checkpoints) {
+    RemoveCheckpoint(dir, checkpoint_id - config_.num_kept_checkpoints, tasks_.size());
+  }
+  last_checkpoint_id_ = checkpoint_id;
+  VLOG(3) << "Save the checkpoint-" << checkpoint_id << " after " << finished_rounds << " rounds into " << dir;
+}
+
+int AutoTuner::LoadCheckpoint() {
+  CHECK(!config_.checkpoint_dir.empty()) << "No checkpoint_dir to resume the tuning from";
+  if (config_.database_config.type == DatabaseType::kMemory) {
+    LOG(WARNING) << "The records measured before the checkpoint are lost with the memory database";
+  }
+  const std::string& dir = config_.checkpoint_dir;
+  std::ifstream latest_is(LatestCheckpointPath(dir));
+  if (!latest_is.is_open()) {
+    LOG(WARNING) << "No checkpoint in " << dir << ", tune from scratch";
+    return 0;
+  }
+  std::string magic;
+  int version       = 0;
+  int checkpoint_id = 0;
+  latest_is >> magic >> version >> checkpoint_id;
+  CHECK(!latest_is.fail() && magic == kCheckpointMagic && version == kCheckpointVersion)
+      << LatestCheckpointPath(dir) << " isn't a checkpoint of version " << kCheckpointVersion;
+
+  std::string state_path = TunerCheckpointPath(dir, checkpoint_id);
+  std::ifstream is(state_path);
+  CHECK(is.is_open()) << "Failed to open " << state_path << " to load the checkpoint";
+  int finished_rounds = 0;
+  size_t num_tasks    = 0;
+  is >> finished_rounds >> num_tasks;
+  CHECK_EQ(num_tasks, tasks_.size()) << "The checkpoint is saved with different tasks";
+  for (const auto& task : tasks_) {
+    size_t key_size = 0;
+    is >> key_size;
+    is.get();
+    std::string key(key_size, '\0');
+    is.read(&key[0], key_size);
+    CHECK(key == task.serialized_key) << "The checkpoint is saved with different tasks, mismatched key:\n" << key;
+  }
+  std::vector<int> num_measured_trials(num_tasks);
+  for (auto& num_trials : num_measured_trials) {
+    is >> num_trials;
+  }
+  std::string scheduler_name;
+  is >> scheduler_name;
+  CHECK_EQ(scheduler_name, task_scheduler_->Name()) << "The checkpoint is saved with a different task scheduler";
+  task_scheduler_->LoadState(is);
+  CHECK(!is.fail()) << "Failed to load the checkpoint from " << state_path;
+
+  for (int i = 0; i < task_optimizers_.size(); ++i) {
+    task_optimizers_[i]->LoadCheckpoint(TaskCheckpointPrefix(dir, i, checkpoint_id));
+    CHECK_EQ(task_optimizers_[i]->NumMeasuredTrials(), num_measured_trials[i])
+        << "The checkpoint of Task-" << i << " is inconsistent with " << state_path;
+  }
+  last_checkpoint_id_ = checkpoint_id;
+  LOG(INFO) << "Resume the tuning from the checkpoint after " << finished_rounds << " rounds in " << dir;
+  return finished_rounds;
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -18,7 +18,9 @@
 #include <string>
 #include <vector>
 
+#include "cinn/auto_schedule/graph_tuner/fusion_tuner.h"
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
+#include "cinn/auto_schedule/measure/simple_runner.h"
 #include "cinn/auto_schedule/task/task_optimizer.h"
 #include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/auto_schedule/task_scheduler/task_scheduler.h"
@@ -32,7 +34,7 @@ namespace cinn {
 namespace auto_schedule {
 
 // This class is entrance of auto-tune, users can use it
-// to tune graph (not supported yet) and search a series of schedules
+// to tune the fusion of graph and search a series of schedules
 // that maybe more likely to obtain better performance.
 // Internally, it creates necessary components and use them to perform tuning.
 class AutoTuner {
@@ -43,7 +45,29 @@ class AutoTuner {
     std::string task_schedule_strategy = "round_robin";
     TaskScheduler::Config task_schedule_config;
     int runner_repeat_times = 1;
+    // repeat the runs by runner_adaptive_config instead of runner_repeat_times if true
+    bool runner_adaptive_repeat = false;
+    SimpleRunner::AdaptiveConfig runner_adaptive_config;
+    // run each candidate in a forked worker process, so a crashed or hung candidate doesn't kill the tuning.
+    // The parallel loops of host kernels run on the thread_pool backend in a worker, while the program
+    // compiled with the tuned schedules runs on FLAGS_cinn_host_parallel_backend, openmp by default, so
+    // set it to thread_pool too for the measured costs to rank the schedules of parallel loops faithfully
+    bool runner_isolated = false;
+    // the time limit of running a candidate in a worker process, unit: ms
+    int runner_timeout_ms = 60000;
+    // the number of threads building the candidates while a single thread runs them, see ScheduleMeasurer,
+    // it falls back to 1 if the builder is not thread-safe
+    int measure_num_threads = 1;
     DatabaseConfig database_config;
+    // tune the fusion partition of the graph by measurement before creating tasks on it
+    bool tune_fusion = false;
+    FusionTuner::Config fusion_tuner_config;
+    // the directory to save the checkpoints of tuning, no checkpoint is saved if empty
+    std::string checkpoint_dir;
+    // save a checkpoint every checkpoint_interval_rounds tuning rounds
+    int checkpoint_interval_rounds = 1;
+    // the number of the latest checkpoints kept in checkpoint_dir, the older ones are removed
+    int num_kept_checkpoints = 1;
   };
 
   AutoTuner(const common::Target& target, hlir::framework::Graph* graph);
@@ -54,7 +78,26 @@ class AutoTuner {
   // Perform the tuning process and return the final result
   TuningResult Tune(const TuningOptions& options);
 
+  // Continue the tuning process from the checkpoint in Config::checkpoint_dir,
+  // it tunes the rounds not finished yet, or from scratch if there is no checkpoint.
+  // The records measured before should be kept in a file database.
+  // The random state of each evolutionary search is restored, but its search space forks
+  // a new one from it, so the resumed rounds don't sample exactly as an uninterrupted tuning.
+  TuningResult Resume(const TuningOptions& options);
+
+  // Restore the latest checkpoint in Config::checkpoint_dir and return
+  // the number of rounds finished, 0 if there is no checkpoint
+  int LoadCheckpoint();
+
  private:
+  // Tune from the start_round-th round to the last one
+  TuningResult TuneRounds(const TuningOptions& options, int start_round);
+
+  // Save the cost models, random states, trial counts and scheduler progress after finished_rounds rounds
+  void SaveCheckpoint(int finished_rounds);
+
+  Config config_;
+
   const common::Target& target_;
   hlir::framework::Graph* graph_;
   std::unique_ptr<hlir::framework::OpLowerer> op_lowerer_;
@@ -73,6 +116,9 @@ class AutoTuner {
 
   // The database to store tuning record
   std::unique_ptr<Database> database_;
+
+  // The id of the last checkpoint saved or loaded, -1 if there is none
+  int last_checkpoint_id_ = -1;
 };
 
 }  // namespace auto_schedule
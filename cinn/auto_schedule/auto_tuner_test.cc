@@ -14,12 +14,21 @@
 
 #include "cinn/auto_schedule/auto_tuner.h"
 
+#include <dirent.h>
 #include <glog/logging.h>
+#include <google/protobuf/util/json_util.h>
+#include <google/protobuf/util/message_differencer.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <map>
+#include <set>
 
+#include "cinn/auto_schedule/database/jsonfile_database.h"
 #include "cinn/common/target.h"
 #include "cinn/frontend/net_builder.h"
 #include "cinn/frontend/optimize.h"
@@ -74,7 +83,7 @@ class TestAutoTuner : public ::testing::Test {
     FLAGS_cinn_ir_schedule = true;
     std::unordered_set<std::string> fetch_ids;
     auto program   = CreateAddReluProgram();
-    auto graph     = cinn::frontend::Optimize(&program, fetch_ids, target);
+    graph          = cinn::frontend::Optimize(&program, fetch_ids, target);
     compiled_scope = BuildScope(target, graph);
     graph_compiler = std::make_unique<GraphCompiler>(target, compiled_scope, graph);
     tuner          = std::make_unique<AutoTuner>(target, graph.get());
@@ -107,7 +116,6 @@ class TestAutoTuner : public ::testing::Test {
     ASSERT_EQ(1, compile_options.lowered_funcs.size());
     VLOG(6) << "Print lowered_funcs before building";
     VLOG(6) << compile_options.lowered_funcs[0][0];
-    VLOG(6) << compile_options.lowered_funcs[1][0];
     auto runtime_program = graph_compiler->Build(compile_options).runtime_program;
     ASSERT_EQ(1, runtime_program->size());
     runtime_program->Execute();
@@ -140,6 +148,113 @@ class TestAutoTuner : public ::testing::Test {
   }
 };
 
+// The names of the files in dir
+std::vector<std::string> ListFiles(const std::string& dir) {
+  std::vector<std::string> files;
+  DIR* dp = opendir(dir.c_str());
+  if (dp == nullptr) {
+    return files;
+  }
+  while (struct dirent* entry = readdir(dp)) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      files.push_back(name);
+    }
+  }
+  closedir(dp);
+  return files;
+}
+
+void RemoveDirectory(const std::string& dir) {
+  for (const auto& name : ListFiles(dir)) {
+    std::remove((dir + "/" + name).c_str());
+  }
+  rmdir(dir.c_str());
+}
+
+// The number of files in dir whose names contain the substring
+int CountFiles(const std::string& dir, const std::string& substring) {
+  auto files = ListFiles(dir);
+  return std::count_if(
+      files.begin(), files.end(), [&](const std::string& name) { return name.find(substring) != std::string::npos; });
+}
+
+// The best record of every task in the record file
+std::map<std::string, TuningRecord> GetBestRecords(const DatabaseConfig& config) {
+  std::set<std::string> task_keys;
+  for (const auto& line : ReadLinesFromFile(config.record_file_path, false)) {
+    proto::TuningRecord record_proto;
+    CHECK(google::protobuf::util::JsonStringToMessage(line, &record_proto).ok());
+    task_keys.insert(record_proto.task_key());
+  }
+  auto database = Database::Make(config);
+  std::map<std::string, TuningRecord> best_records;
+  for (const auto& key : task_keys) {
+    best_records[key] = database->GetTopK(key, 1).front();
+  }
+  return best_records;
+}
+
+TEST_F(TestAutoTuner, CheckpointAndResume) {
+  FLAGS_auto_schedule_use_cost_model = true;
+  std::string checkpoint_dir         = "./auto_tuner_checkpoint_test";
+  RemoveDirectory(checkpoint_dir);
+
+  AutoTuner::Config tuning_config;
+  tuning_config.task_schedule_strategy           = "round_robin";
+  tuning_config.checkpoint_dir                   = checkpoint_dir;
+  tuning_config.num_kept_checkpoints             = 2;
+  tuning_config.database_config.type             = DatabaseType::kJSONFile;
+  tuning_config.database_config.record_file_path = checkpoint_dir + "_record.json";
+  std::remove(tuning_config.database_config.record_file_path.c_str());
+
+  TuningOptions tuning_options;
+  tuning_options.num_tuning_rounds         = 3;
+  tuning_options.num_measure_trials        = 4;
+  tuning_options.num_samples_per_iteration = 2;
+  // stop after 3 rounds, a checkpoint is saved after each of them
+  auto result = InitializeAndTune(tuning_config, tuning_options);
+  BasicCheckResult(result);
+  int num_tasks = result.function_groups.size();
+  // only the checkpoints after the last 2 rounds are kept, each of them has 3 files per task and the state of tuner
+  ASSERT_EQ(CountFiles(checkpoint_dir, "checkpoint_0"), 0);
+  ASSERT_EQ(CountFiles(checkpoint_dir, "checkpoint_1"), 3 * num_tasks + 1);
+  ASSERT_EQ(CountFiles(checkpoint_dir, "checkpoint_2"), 3 * num_tasks + 1);
+  ASSERT_EQ(ListFiles(checkpoint_dir).size(), 2 * (3 * num_tasks + 1) + 1);
+  auto best_records = GetBestRecords(tuning_config.database_config);
+  ASSERT_FALSE(best_records.empty());
+
+  // a new tuner restores the rounds finished and the records measured before
+  tuner = std::make_unique<AutoTuner>(target, graph.get());
+  tuner->Initialize(tuning_config, graph_compiler.get());
+  ASSERT_EQ(tuner->LoadCheckpoint(), 3);
+  auto database = Database::Make(tuning_config.database_config);
+  for (const auto& key_record : best_records) {
+    auto restored = database->GetTopK(key_record.first, 1);
+    ASSERT_EQ(restored.size(), 1UL);
+    ASSERT_EQ(restored[0].execution_cost, key_record.second.execution_cost);
+    ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(restored[0].trace, key_record.second.trace));
+  }
+
+  // resume the 4th round, which saves the 4th checkpoint and removes the 2nd one
+  tuning_options.num_tuning_rounds = 4;
+  result                           = tuner->Resume(tuning_options);
+  BasicCheckResult(result);
+  ApplyTunedAndRun(result);
+  ASSERT_EQ(CountFiles(checkpoint_dir, "checkpoint_1"), 0);
+  ASSERT_EQ(CountFiles(checkpoint_dir, "checkpoint_2"), 3 * num_tasks + 1);
+  ASSERT_EQ(CountFiles(checkpoint_dir, "checkpoint_3"), 3 * num_tasks + 1);
+  ASSERT_EQ(ListFiles(checkpoint_dir).size(), 2 * (3 * num_tasks + 1) + 1);
+  // the records are kept, so the best ones are not worse after resuming
+  for (const auto& key_record : GetBestRecords(tuning_config.database_config)) {
+    ASSERT_TRUE(best_records.count(key_record.first) == 0 ||
+                key_record.second.execution_cost <= best_records.at(key_record.first).execution_cost);
+  }
+
+  RemoveDirectory(checkpoint_dir);
+  std::remove(tuning_config.database_config.record_file_path.c_str());
+}
+
 TEST_F(TestAutoTuner, ZeroMeasure_DisableCostModel) {
   FLAGS_auto_schedule_use_cost_model = false;
   ZeroMeasure();
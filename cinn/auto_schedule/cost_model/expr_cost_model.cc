@@ -17,6 +17,7 @@
 #include <glog/logging.h>
 
 #include <atomic>
+#include <string>
 #include <vector>
 
 #include "cinn/auto_schedule/cost_model/feature.h"
@@ -24,6 +25,7 @@
 #include "cinn/auto_schedule/search_space/search_state.h"
 #include "cinn/common/target.h"
 #include "cinn/ir/ir_schedule.h"
+#include "cinn/utils/multi_threading.h"
 
 namespace cinn {
 namespace auto_schedule {
@@ -35,42 +37,55 @@ float ExprCostModel::Predict(const ir::ModuleExpr& sample, const common::Target&
   FeatureExtractor extractor;
   Feature feature                    = extractor.Extract(sample, target);
   std::vector<float> feature_numbers = feature.ToFixedSizeVector();
-  std::vector<float> pred            = XgbCostModel::Predict({feature_numbers});
+  std::vector<float> pred            = GbdtCostModel::Predict({feature_numbers});
   return pred[0];
 }
 
+std::vector<float> ExprCostModel::Predict(const std::vector<const ir::ModuleExpr*>& samples,
+                                          const common::Target& target) const {
+  if (trained_times_.load() == 0) {
+    return std::vector<float>(samples.size(), SearchState::NOT_INIT_COST);
+  }
+  if (samples.empty()) {
+    return {};
+  }
+  return GbdtCostModel::Predict(ExtractFeatures(samples, target));
+}
+
 void ExprCostModel::Train(const std::vector<const ir::ModuleExpr*>& samples,
                           const std::vector<float>& labels,
                           const common::Target& target) {
   trained_times_.store(1);
-  size_t total_size = samples.size();
-  CHECK_EQ(total_size, labels.size()) << "Samples must have same size as labels";
-  std::vector<std::vector<float>> train_feature_numbers(total_size);
-  FeatureExtractor extractor;
-  for (size_t i = 0; i < total_size; ++i) {
-    CHECK(samples[i] != nullptr) << "Train samples cannot be nullptr";
-    Feature feature          = extractor.Extract(*samples[i], target);
-    train_feature_numbers[i] = feature.ToFixedSizeVector();
-  }
-
-  XgbCostModel::Train(train_feature_numbers, labels);
+  CHECK_EQ(samples.size(), labels.size()) << "Samples must have same size as labels";
+  GbdtCostModel::Train(ExtractFeatures(samples, target), labels);
 }
 
 void ExprCostModel::Update(const std::vector<const ir::ModuleExpr*>& samples,
                            const std::vector<float>& labels,
                            const common::Target& target) {
   ++trained_times_;
-  size_t total_size = samples.size();
-  CHECK_EQ(total_size, labels.size()) << "Samples must have same size as labels";
-  std::vector<std::vector<float>> train_feature_numbers(total_size);
-  FeatureExtractor extractor;
-  for (size_t i = 0; i < total_size; ++i) {
-    CHECK(samples[i] != nullptr) << "Train samples cannot be nullptr";
-    Feature feature          = extractor.Extract(*samples[i], target);
-    train_feature_numbers[i] = feature.ToFixedSizeVector();
-  }
+  CHECK_EQ(samples.size(), labels.size()) << "Samples must have same size as labels";
+  GbdtCostModel::Update(ExtractFeatures(samples, target), labels);
+}
 
-  XgbCostModel::Update(train_feature_numbers, labels);
+void ExprCostModel::Load(const std::string& path) {
+  GbdtCostModel::Load(path);
+  trained_times_.store(NumTrees() > 0 ? 1 : 0);
+}
+
+std::vector<std::vector<float>> ExprCostModel::ExtractFeatures(const std::vector<const ir::ModuleExpr*>& samples,
+                                                               const common::Target& target) const {
+  std::vector<std::vector<float>> feature_numbers(samples.size());
+  if (samples.empty()) {
+    return feature_numbers;
+  }
+  auto extract_fn = [&samples, &target, &feature_numbers](int index) {
+    CHECK(samples[index] != nullptr) << "Samples cannot be nullptr";
+    FeatureExtractor extractor;
+    feature_numbers[index] = extractor.Extract(*samples[index], target).ToFixedSizeVector();
+  };
+  utils::parallel_run(extract_fn, utils::SequenceDispatcher(0, samples.size()), -1);
+  return feature_numbers;
 }
 
 }  // namespace auto_schedule
@@ -15,9 +15,10 @@
 #pragma once
 
 #include <atomic>
+#include <string>
 #include <vector>
 
-#include "cinn/auto_schedule/cost_model/xgb_cost_model.h"
+#include "cinn/auto_schedule/cost_model/gbdt_cost_model.h"
 #include "cinn/ir/ir_schedule.h"
 
 namespace cinn {
@@ -27,9 +28,12 @@ namespace auto_schedule {
  * A C++ cost model which trains and predicts on ir::Expr
  *
  */
-class ExprCostModel : public XgbCostModel {
+class ExprCostModel : public GbdtCostModel {
  public:
   virtual float Predict(const ir::ModuleExpr& sample, const common::Target& target) const;
+  // Predict a batch of samples, whose features are extracted in parallel and then predicted by one model call
+  virtual std::vector<float> Predict(const std::vector<const ir::ModuleExpr*>& samples,
+                                     const common::Target& target) const;
   void Train(const std::vector<const ir::ModuleExpr*>& samples,
              const std::vector<float>& labels,
              const common::Target& target);
@@ -37,7 +41,14 @@ class ExprCostModel : public XgbCostModel {
               const std::vector<float>& labels,
               const common::Target& target);
 
+  // Load the trees saved before, a model with any tree is regarded as trained
+  void Load(const std::string& path) override;
+
  private:
+  // Extract the fixed size feature vectors of samples with multiple threads
+  std::vector<std::vector<float>> ExtractFeatures(const std::vector<const ir::ModuleExpr*>& samples,
+                                                  const common::Target& target) const;
+
   std::atomic<int> trained_times_{0};
 };
 
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/cost_model/expr_cost_model.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cinn/auto_schedule/search_space/search_state.h"
+#include "cinn/common/context.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/lang/compute.h"
+#include "cinn/lang/lower.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Lower B = A + 1 of shape [m, n] and split its loops as the factors
+ir::ModuleExpr CreateModuleExpr(int m, int n, const std::vector<int>& factors, const common::Target& target) {
+  Context::Global().ResetNameId();
+  lang::Placeholder<float> A("A", {ir::Expr(m), ir::Expr(n)});
+  ir::Tensor B = lang::Compute(
+      {ir::Expr(m), ir::Expr(n)}, [&](Var i, Var j) { return A(i, j) + ir::Expr(1.f); }, "B");
+  auto funcs = lang::LowerVec("AddOne", poly::CreateStages({A, B}), {A, B}, {}, {}, nullptr, target, true);
+
+  ir::IRSchedule ir_sch(ir::ModuleExpr({funcs[0]->body}));
+  if (!factors.empty()) {
+    ir_sch.Split("B", 0, factors);
+  }
+  return ir_sch.GetModule();
+}
+
+TEST(ExprCostModel, BatchedPredict) {
+  common::Target target = common::DefaultHostTarget();
+  std::vector<ir::ModuleExpr> modules;
+  std::vector<float> labels;
+  for (int m : {16, 32, 64, 128}) {
+    modules.push_back(CreateModuleExpr(m, 32, {}, target));
+    labels.push_back(m);
+    modules.push_back(CreateModuleExpr(m, 32, {m / 4, 4}, target));
+    labels.push_back(m / 2);
+  }
+  std::vector<const ir::ModuleExpr*> samples;
+  for (const auto& module : modules) {
+    samples.push_back(&module);
+  }
+
+  ExprCostModel cost_model;
+  // an untrained model doesn't initialize the costs
+  std::vector<float> costs = cost_model.Predict(samples, target);
+  ASSERT_EQ(costs.size(), samples.size());
+  for (float cost : costs) {
+    ASSERT_EQ(cost, SearchState::NOT_INIT_COST);
+  }
+
+  cost_model.Train(samples, labels, target);
+  costs = cost_model.Predict(samples, target);
+  ASSERT_EQ(costs.size(), samples.size());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    ASSERT_FLOAT_EQ(costs[i], cost_model.Predict(*samples[i], target));
+  }
+  ASSERT_TRUE(cost_model.Predict(std::vector<const ir::ModuleExpr*>(), target).empty());
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
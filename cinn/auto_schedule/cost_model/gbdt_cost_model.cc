@@ -0,0 +1,387 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/cost_model/gbdt_cost_model.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include "cinn/utils/multi_threading.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+namespace {
+constexpr char kModelMagic[]   = "cinn_gbdt_cost_model";
+constexpr int kModelVersion    = 1;
+constexpr char kSamplesMagic[] = "cinn_gbdt_samples";
+constexpr int kSamplesVersion  = 1;
+// the number of samples predicted by a job
+constexpr int kPredictBlockSize = 256;
+
+// The best split of a node on a feature, samples in the bins less than split_bin go to left
+struct Split {
+  double gain{0.0};
+  int split_bin{-1};
+};
+}  // namespace
+
+GbdtCostModel::GbdtCostModel() : GbdtCostModel(Params()) {}
+
+GbdtCostModel::GbdtCostModel(const Params& params) : params_(params) {
+  CHECK_GT(params_.num_rounds, 0) << "num_rounds should be greater than 0";
+  CHECK_GT(params_.max_depth, 0) << "max_depth should be greater than 0";
+  CHECK(params_.max_bins >= 2 && params_.max_bins <= 256) << "max_bins should be in [2, 256]";
+}
+
+int GbdtCostModel::NumThreads(int num_jobs) const {
+  int num_threads = params_.num_threads > 0 ? params_.num_threads : std::thread::hardware_concurrency();
+  return std::max(1, std::min(num_threads, num_jobs));
+}
+
+void GbdtCostModel::Train(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) {
+  CHECK(!samples.empty()) << "Train samples cannot be empty";
+  CHECK_EQ(samples.size(), labels.size()) << "Samples must have same size as labels";
+  num_features_ = samples[0].size();
+  for (auto& sample : samples) {
+    CHECK_EQ(sample.size(), num_features_) << "Samples must have same feature size";
+  }
+
+  trees_.clear();
+  samples_     = samples;
+  labels_      = labels;
+  base_score_  = std::accumulate(labels.begin(), labels.end(), 0.0) / labels.size();
+  predictions_ = std::vector<float>(samples.size(), base_score_);
+  Boost();
+}
+
+void GbdtCostModel::Update(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) {
+  CHECK_EQ(samples.size(), labels.size()) << "Samples must have same size as labels";
+  if (samples.empty()) {
+    return;
+  }
+  if (trees_.empty() && samples_.empty()) {
+    Train(samples, labels);
+    return;
+  }
+  for (auto& sample : samples) {
+    CHECK_EQ(sample.size(), num_features_) << "Samples must have same feature size as the trained ones";
+  }
+  // the new samples start from the predictions of the current trees, so the new trees fit their residuals
+  std::vector<float> predictions = Predict(samples);
+  samples_.insert(samples_.end(), samples.begin(), samples.end());
+  labels_.insert(labels_.end(), labels.begin(), labels.end());
+  predictions_.insert(predictions_.end(), predictions.begin(), predictions.end());
+  Boost();
+}
+
+void GbdtCostModel::Boost() {
+  int num_samples = samples_.size();
+  // quantize each feature into at most max_bins bins split by the cut points
+  std::vector<std::vector<float>> cuts(num_features_);
+  std::vector<uint8_t> bins(static_cast<size_t>(num_samples) * num_features_);
+  auto quantize_fn = [&](int feature) {
+    std::vector<float> values(num_samples);
+    for (int i = 0; i < num_samples; ++i) {
+      values[i] = samples_[i][feature];
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    auto& feature_cuts = cuts[feature];
+    if (values.size() <= params_.max_bins) {
+      feature_cuts.assign(values.begin() + 1, values.end());
+    } else {
+      // the quantiles of the distinct values
+      for (int k = 1; k < params_.max_bins; ++k) {
+        feature_cuts.push_back(values[static_cast<size_t>(k) * values.size() / params_.max_bins]);
+      }
+      feature_cuts.erase(std::unique(feature_cuts.begin(), feature_cuts.end()), feature_cuts.end());
+    }
+    for (int i = 0; i < num_samples; ++i) {
+      auto it = std::upper_bound(feature_cuts.begin(), feature_cuts.end(), samples_[i][feature]);
+      bins[static_cast<size_t>(i) * num_features_ + feature] = it - feature_cuts.begin();
+    }
+  };
+  utils::parallel_run(quantize_fn, utils::SequenceDispatcher(0, num_features_), NumThreads(num_features_));
+
+  std::vector<float> grads(num_samples);
+  std::vector<int> leaves;
+  for (int round = 0; round < params_.num_rounds; ++round) {
+    // the gradients of the squared error, whose hessians are all 1
+    for (int i = 0; i < num_samples; ++i) {
+      grads[i] = predictions_[i] - labels_[i];
+    }
+    Tree tree = BuildTree(bins, cuts, grads, &leaves);
+    for (int i = 0; i < num_samples; ++i) {
+      predictions_[i] += tree[leaves[i]].value;
+    }
+    trees_.emplace_back(std::move(tree));
+  }
+  VLOG(4) << "Boost " << params_.num_rounds << " rounds on " << num_samples << " samples, total " << trees_.size()
+          << " trees";
+}
+
+GbdtCostModel::Tree GbdtCostModel::BuildTree(const std::vector<uint8_t>& bins,
+                                             const std::vector<std::vector<float>>& cuts,
+                                             const std::vector<float>& grads,
+                                             std::vector<int>* leaves) const {
+  int num_samples = grads.size();
+  Tree tree(1);
+  // the node each sample belongs to
+  std::vector<int>& positions = *leaves;
+  positions.assign(num_samples, 0);
+  std::vector<int> split_bins(1, -1);
+
+  std::vector<int> level_nodes = {0};
+  for (int depth = 0; !level_nodes.empty(); ++depth) {
+    int num_nodes = level_nodes.size();
+    // the index of each node of this level in level_nodes
+    std::vector<int> slots(tree.size(), -1);
+    for (int s = 0; s < num_nodes; ++s) {
+      slots[level_nodes[s]] = s;
+    }
+    std::vector<double> sum_grads(num_nodes, 0.0), sum_hess(num_nodes, 0.0);
+    for (int i = 0; i < num_samples; ++i) {
+      int s = slots[positions[i]];
+      if (s >= 0) {
+        sum_grads[s] += grads[i];
+        sum_hess[s] += 1.0;
+      }
+    }
+    auto score = [this](double g, double h) { return g * g / (h + params_.lambda); };
+
+    // find the best split of every node on each feature from the histograms
+    std::vector<Split> splits(static_cast<size_t>(num_nodes) * num_features_);
+    auto find_split_fn = [&](int feature) {
+      int num_bins = cuts[feature].size() + 1;
+      if (num_bins < 2) {
+        return;
+      }
+      std::vector<double> hist_grads(num_nodes * num_bins, 0.0), hist_hess(num_nodes * num_bins, 0.0);
+      for (int i = 0; i < num_samples; ++i) {
+        int s = slots[positions[i]];
+        if (s >= 0) {
+          int bin = bins[static_cast<size_t>(i) * num_features_ + feature];
+          hist_grads[s * num_bins + bin] += grads[i];
+          hist_hess[s * num_bins + bin] += 1.0;
+        }
+      }
+      for (int s = 0; s < num_nodes; ++s) {
+        double parent_score = score(sum_grads[s], sum_hess[s]);
+        auto& best          = splits[static_cast<size_t>(s) * num_features_ + feature];
+
+        double left_grads = 0.0, left_hess = 0.0;
+        for (int bin = 1; bin < num_bins; ++bin) {
+          left_grads += hist_grads[s * num_bins + bin - 1];
+          left_hess += hist_hess[s * num_bins + bin - 1];
+          double right_grads = sum_grads[s] - left_grads, right_hess = sum_hess[s] - left_hess;
+          if (left_hess < params_.min_child_weight || right_hess < params_.min_child_weight) {
+            continue;
+          }
+          double gain = score(left_grads, left_hess) + score(right_grads, right_hess) - parent_score;
+          if (gain > best.gain) {
+            best.gain      = gain;
+            best.split_bin = bin;
+          }
+        }
+      }
+    };
+    if (depth < params_.max_depth) {
+      utils::parallel_run(find_split_fn, utils::SequenceDispatcher(0, num_features_), NumThreads(num_features_));
+    }
+
+    std::vector<int> next_level_nodes;
+    for (int s = 0; s < num_nodes; ++s) {
+      int node    = level_nodes[s];
+      int feature = -1;
+      Split best;
+      for (int f = 0; f < num_features_; ++f) {
+        const auto& split = splits[static_cast<size_t>(s) * num_features_ + f];
+        if (split.split_bin > 0 && split.gain > best.gain) {
+          best    = split;
+          feature = f;
+        }
+      }
+      if (feature < 0 || best.gain <= std::numeric_limits<float>::epsilon()) {
+        tree[node].value = -sum_grads[s] / (sum_hess[s] + params_.lambda) * params_.learning_rate;
+        continue;
+      }
+      tree[node].feature   = feature;
+      tree[node].threshold = cuts[feature][best.split_bin - 1];
+      tree[node].left      = tree.size();
+      tree[node].right     = tree.size() + 1;
+      split_bins[node]     = best.split_bin;
+      next_level_nodes.push_back(tree[node].left);
+      next_level_nodes.push_back(tree[node].right);
+      tree.resize(tree.size() + 2);
+      split_bins.resize(tree.size(), -1);
+    }
+
+    // move the samples of the split nodes to the children
+    for (int i = 0; i < num_samples; ++i) {
+      int node = positions[i];
+      if (slots[node] >= 0 && tree[node].feature >= 0) {
+        int bin      = bins[static_cast<size_t>(i) * num_features_ + tree[node].feature];
+        positions[i] = bin < split_bins[node] ? tree[node].left : tree[node].right;
+      }
+    }
+    level_nodes = std::move(next_level_nodes);
+  }
+  return tree;
+}
+
+float GbdtCostModel::PredictOne(const std::vector<float>& sample) const {
+  CHECK_EQ(sample.size(), num_features_) << "Samples must have same feature size as the trained ones";
+  float result = base_score_;
+  for (const auto& tree : trees_) {
+    int node = 0;
+    while (tree[node].feature >= 0) {
+      node = sample[tree[node].feature] < tree[node].threshold ? tree[node].left : tree[node].right;
+    }
+    result += tree[node].value;
+  }
+  return result;
+}
+
+std::vector<float> GbdtCostModel::Predict(const std::vector<std::vector<float>>& samples) const {
+  std::vector<float> results(samples.size(), base_score_);
+  if (trees_.empty()) {
+    return results;
+  }
+  int num_blocks      = (samples.size() + kPredictBlockSize - 1) / kPredictBlockSize;
+  auto predict_blocks = [&](int block) {
+    int end = std::min<int>((block + 1) * kPredictBlockSize, samples.size());
+    for (int i = block * kPredictBlockSize; i < end; ++i) {
+      results[i] = PredictOne(samples[i]);
+    }
+  };
+  if (num_blocks > 0) {
+    utils::parallel_run(predict_blocks, utils::SequenceDispatcher(0, num_blocks), NumThreads(num_blocks));
+  }
+  return results;
+}
+
+void GbdtCostModel::Save(const std::string& path) {
+  std::ofstream os(path);
+  CHECK(os.is_open()) << "Failed to open " << path << " to save the cost model";
+  os << std::setprecision(std::numeric_limits<float>::max_digits10);
+  os << kModelMagic << " " << kModelVersion << "\n";
+  os << num_features_ << " " << base_score_ << " " << trees_.size() << "\n";
+  for (const auto& tree : trees_) {
+    os << tree.size() << "\n";
+    for (const auto& node : tree) {
+      os << node.feature << " " << node.threshold << " " << node.left << " " << node.right << " " << node.value << "\n";
+    }
+  }
+  os.close();
+  CHECK(!os.fail()) << "Failed to save the cost model to " << path;
+}
+
+void GbdtCostModel::Load(const std::string& path) {
+  std::ifstream is(path);
+  CHECK(is.is_open()) << "Failed to open " << path << " to load the cost model";
+  std::string magic;
+  int version = 0;
+  is >> magic >> version;
+  CHECK(magic == kModelMagic && version == kModelVersion) << path << " isn't a cost model of version " << kModelVersion;
+
+  size_t num_trees = 0;
+  is >> num_features_ >> base_score_ >> num_trees;
+  trees_.assign(num_trees, Tree());
+  for (auto& tree : trees_) {
+    size_t num_nodes = 0;
+    is >> num_nodes;
+    tree.resize(num_nodes);
+    for (auto& node : tree) {
+      is >> node.feature >> node.threshold >> node.left >> node.right >> node.value;
+    }
+  }
+  CHECK(!is.fail()) << "Failed to load the cost model from " << path;
+  // the children are always placed after their parent
+  for (const auto& tree : trees_) {
+    CHECK(!tree.empty()) << "Empty tree in " << path;
+    for (int i = 0; i < tree.size(); ++i) {
+      if (tree[i].feature >= 0) {
+        CHECK(tree[i].feature < num_features_ && tree[i].left > i && tree[i].left < tree.size() && tree[i].right > i &&
+              tree[i].right < tree.size())
+            << "Invalid tree node in " << path;
+      }
+    }
+  }
+
+  samples_.clear();
+  labels_.clear();
+  predictions_.clear();
+}
+
+void GbdtCostModel::SaveSamples(const std::string& path) const {
+  std::ofstream os(path);
+  CHECK(os.is_open()) << "Failed to open " << path << " to save the samples";
+  os << std::setprecision(std::numeric_limits<float>::max_digits10);
+  os << kSamplesMagic << " " << kSamplesVersion << "\n";
+  os << samples_.size() << " " << num_features_ << "\n";
+  for (size_t i = 0; i < samples_.size(); ++i) {
+    os << labels_[i];
+    for (float value : samples_[i]) {
+      os << " " << value;
+    }
+    os << "\n";
+  }
+  os.close();
+  CHECK(!os.fail()) << "Failed to save the samples to " << path;
+}
+
+void GbdtCostModel::LoadSamples(const std::string& path) {
+  std::ifstream is(path);
+  CHECK(is.is_open()) << "Failed to open " << path << " to load the samples";
+  std::string magic;
+  int version = 0;
+  is >> magic >> version;
+  CHECK(magic == kSamplesMagic && version == kSamplesVersion)
+      << path << " isn't a sample file of version " << kSamplesVersion;
+
+  size_t num_samples = 0;
+  int num_features   = 0;
+  is >> num_samples >> num_features;
+  CHECK(!is.fail()) << "Failed to load the samples from " << path;
+  if (num_samples == 0) {
+    return;
+  }
+  CHECK(trees_.empty() || num_features == num_features_)
+      << "The samples in " << path << " have " << num_features << " features, but the trees take " << num_features_;
+  std::vector<std::vector<float>> samples(num_samples, std::vector<float>(num_features));
+  std::vector<float> labels(num_samples);
+  for (size_t i = 0; i < num_samples; ++i) {
+    is >> labels[i];
+    for (auto& value : samples[i]) {
+      is >> value;
+    }
+  }
+  CHECK(!is.fail()) << "Failed to load the samples from " << path;
+
+  // the predictions of the samples are recovered from the trees
+  num_features_ = num_features;
+  predictions_  = Predict(samples);
+  samples_      = std::move(samples);
+  labels_       = std::move(labels);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,112 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cinn/common/cost_model.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+/**
+ * A C++ cost model of gradient boosted regression trees, trained with the squared error like the default
+ * objective of xgboost.
+ *
+ * The trees are grown depth-wise on the histograms of the quantized features, and both the histograms and the
+ * predictions are computed with multiple threads. Train fits new trees from scratch, while Update appends the
+ * samples to the ones seen before and boosts more rounds on top of the current trees.
+ */
+class GbdtCostModel : public CostModel {
+ public:
+  struct Params {
+    // the number of trees added by each Train or Update
+    int num_rounds{10};
+    int max_depth{6};
+    float learning_rate{0.3f};
+    // L2 regularization on the leaf values
+    float lambda{1.0f};
+    // the minimum sum of hessians in a child
+    float min_child_weight{1.0f};
+    // the maximum number of bins to quantize a feature, at most 256
+    int max_bins{256};
+    // the number of threads, -1 means the hardware limit
+    int num_threads{-1};
+  };
+
+  GbdtCostModel();
+  explicit GbdtCostModel(const Params& params);
+  ~GbdtCostModel() = default;
+
+  void Train(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) override;
+
+  std::vector<float> Predict(const std::vector<std::vector<float>>& samples) const override;
+
+  void Update(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) override;
+
+  void Save(const std::string& path) override;
+
+  // Load the trees saved before, the samples trained with are not saved so a later Update boosts on the new samples
+  void Load(const std::string& path) override;
+
+  // Save the samples and labels accumulated so far, used to checkpoint the model together with Save
+  void SaveSamples(const std::string& path) const;
+
+  // Load the samples saved by SaveSamples after Load, so a later Update boosts on all the samples seen before
+  void LoadSamples(const std::string& path);
+
+  size_t NumSamples() const { return samples_.size(); }
+
+  size_t NumTrees() const { return trees_.size(); }
+
+ private:
+  // A leaf if feature < 0, otherwise a sample goes to left if its feature is less than the threshold
+  struct TreeNode {
+    int feature{-1};
+    float threshold{0.0f};
+    int left{-1};
+    int right{-1};
+    float value{0.0f};
+  };
+  using Tree = std::vector<TreeNode>;
+
+  // Add params_.num_rounds trees fitting the residuals of the accumulated samples
+  void Boost();
+
+  // Grow a tree on the quantized samples, and store the leaf of each sample into leaves
+  Tree BuildTree(const std::vector<uint8_t>& bins,
+                 const std::vector<std::vector<float>>& cuts,
+                 const std::vector<float>& grads,
+                 std::vector<int>* leaves) const;
+
+  float PredictOne(const std::vector<float>& sample) const;
+
+  int NumThreads(int num_jobs) const;
+
+  Params params_;
+  int num_features_{0};
+  float base_score_{0.5f};
+  std::vector<Tree> trees_;
+
+  // the samples accumulated by Train and Update, and their predictions by the current trees
+  std::vector<std::vector<float>> samples_;
+  std::vector<float> labels_;
+  std::vector<float> predictions_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,162 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/cost_model/gbdt_cost_model.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace cinn {
+namespace auto_schedule {
+
+// y = 2 * x0 + (x1 > 5 ? 3 : 0) + x2 * x3, x4 is noise
+void MakeSamples(int num_samples, int seed, std::vector<std::vector<float>>* samples, std::vector<float>* labels) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(0.0f, 10.0f);
+  samples->clear();
+  labels->clear();
+  for (int i = 0; i < num_samples; ++i) {
+    std::vector<float> sample(5);
+    for (auto& value : sample) {
+      value = dist(rng);
+    }
+    labels->push_back(2 * sample[0] + (sample[1] > 5 ? 3 : 0) + sample[2] * sample[3]);
+    samples->push_back(std::move(sample));
+  }
+}
+
+float MeanSquaredError(const std::vector<float>& predictions, const std::vector<float>& labels) {
+  double error = 0.0;
+  for (size_t i = 0; i < labels.size(); ++i) {
+    error += (predictions[i] - labels[i]) * (predictions[i] - labels[i]);
+  }
+  return error / labels.size();
+}
+
+TEST(GbdtCostModel, TrainAndPredict) {
+  std::vector<std::vector<float>> samples, test_samples;
+  std::vector<float> labels, test_labels;
+  MakeSamples(1000, 0, &samples, &labels);
+  MakeSamples(200, 1, &test_samples, &test_labels);
+
+  GbdtCostModel cost_model;
+  // an untrained model predicts a constant
+  auto pred = cost_model.Predict(test_samples);
+  ASSERT_EQ(pred.size(), test_samples.size());
+  ASSERT_FLOAT_EQ(pred[0], pred[1]);
+
+  cost_model.Train(samples, labels);
+  ASSERT_EQ(cost_model.NumTrees(), 10);
+  float train_error = MeanSquaredError(cost_model.Predict(samples), labels);
+  float test_error  = MeanSquaredError(cost_model.Predict(test_samples), test_labels);
+  // the variance of the labels is about 700
+  VLOG(6) << "train error: " << train_error << ", test error: " << test_error;
+  EXPECT_LT(train_error, 20.0f);
+  EXPECT_LT(test_error, 40.0f);
+
+  // incremental boosting rounds keep the existing trees
+  std::vector<std::vector<float>> new_samples;
+  std::vector<float> new_labels;
+  MakeSamples(500, 2, &new_samples, &new_labels);
+  cost_model.Update(new_samples, new_labels);
+  ASSERT_EQ(cost_model.NumTrees(), 20);
+  EXPECT_LT(MeanSquaredError(cost_model.Predict(test_samples), test_labels), test_error);
+}
+
+TEST(GbdtCostModel, MultiThreadedPredict) {
+  std::vector<std::vector<float>> samples;
+  std::vector<float> labels;
+  MakeSamples(2000, 0, &samples, &labels);
+
+  GbdtCostModel::Params params;
+  params.num_threads = 1;
+  GbdtCostModel single_thread_model(params);
+  single_thread_model.Train(samples, labels);
+  params.num_threads = 4;
+  GbdtCostModel multi_thread_model(params);
+  multi_thread_model.Train(samples, labels);
+
+  auto single_thread_pred = single_thread_model.Predict(samples);
+  auto multi_thread_pred  = multi_thread_model.Predict(samples);
+  ASSERT_EQ(single_thread_pred.size(), multi_thread_pred.size());
+  for (size_t i = 0; i < single_thread_pred.size(); ++i) {
+    ASSERT_FLOAT_EQ(single_thread_pred[i], multi_thread_pred[i]);
+  }
+}
+
+TEST(GbdtCostModel, SaveAndLoad) {
+  std::vector<std::vector<float>> samples;
+  std::vector<float> labels;
+  MakeSamples(500, 0, &samples, &labels);
+
+  GbdtCostModel cost_model;
+  cost_model.Train(samples, labels);
+  auto pred = cost_model.Predict(samples);
+
+  std::string path = "./test_gbdt_cost_model.txt";
+  cost_model.Save(path);
+  GbdtCostModel load_cost_model;
+  load_cost_model.Load(path);
+  std::remove(path.c_str());
+  ASSERT_EQ(load_cost_model.NumTrees(), cost_model.NumTrees());
+  auto load_pred = load_cost_model.Predict(samples);
+  ASSERT_EQ(pred.size(), load_pred.size());
+  for (size_t i = 0; i < pred.size(); ++i) {
+    ASSERT_FLOAT_EQ(pred[i], load_pred[i]);
+  }
+
+  // boost on top of the loaded trees
+  load_cost_model.Update(samples, labels);
+  ASSERT_EQ(load_cost_model.NumTrees(), 2 * cost_model.NumTrees());
+  EXPECT_LT(MeanSquaredError(load_cost_model.Predict(samples), labels), MeanSquaredError(pred, labels));
+}
+
+TEST(GbdtCostModel, SaveAndLoadSamples) {
+  std::vector<std::vector<float>> samples, new_samples;
+  std::vector<float> labels, new_labels;
+  MakeSamples(500, 0, &samples, &labels);
+  MakeSamples(200, 1, &new_samples, &new_labels);
+
+  GbdtCostModel cost_model;
+  cost_model.Train(samples, labels);
+  std::string model_path   = "./test_gbdt_cost_model.txt";
+  std::string samples_path = "./test_gbdt_cost_model_samples.txt";
+  cost_model.Save(model_path);
+  cost_model.SaveSamples(samples_path);
+
+  GbdtCostModel load_cost_model;
+  load_cost_model.Load(model_path);
+  load_cost_model.LoadSamples(samples_path);
+  std::remove(model_path.c_str());
+  std::remove(samples_path.c_str());
+  ASSERT_EQ(load_cost_model.NumSamples(), samples.size());
+
+  // the resumed model boosts on all the samples like the one never saved
+  cost_model.Update(new_samples, new_labels);
+  load_cost_model.Update(new_samples, new_labels);
+  ASSERT_EQ(load_cost_model.NumSamples(), samples.size() + new_samples.size());
+  auto pred      = cost_model.Predict(new_samples);
+  auto load_pred = load_cost_model.Predict(new_samples);
+  for (size_t i = 0; i < pred.size(); ++i) {
+    ASSERT_NEAR(pred[i], load_pred[i], 1e-3 * std::abs(pred[i]) + 1e-3);
+  }
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,307 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/database/binary_file_database.h"
+
+#include <glog/logging.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include "cinn/auto_schedule/auto_schedule.pb.h"
+#include "cinn/auto_schedule/task/task_registry.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+namespace {
+constexpr char kRecordMagic[] = "CINNTRDB";
+constexpr char kIndexMagic[]  = "CINNTIDX";
+constexpr uint64_t kMagicSize = 8;
+// the index size and the index magic at the end of the file
+constexpr uint64_t kTrailerSize = 8 + kMagicSize;
+
+template <typename T>
+void WriteFixed(std::ostream* os, T value) {
+  char buf[sizeof(T)];
+  for (int i = 0; i < sizeof(T); ++i) {
+    buf[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  os->write(buf, sizeof(T));
+}
+
+template <typename T>
+bool ReadFixed(std::istream* is, T* value) {
+  unsigned char buf[sizeof(T)];
+  if (!is->read(reinterpret_cast<char*>(buf), sizeof(T))) {
+    return false;
+  }
+  *value = 0;
+  for (int i = 0; i < sizeof(T); ++i) {
+    *value |= static_cast<T>(buf[i]) << (8 * i);
+  }
+  return true;
+}
+
+// the key size, the payload size and the checksum before each record
+constexpr uint64_t kRecordHeaderSize = 12;
+
+// FNV-1a hash of the task_key and the payload, to detect the torn records when scanning a file
+uint32_t Checksum(const std::string& task_key, const std::string& payload) {
+  uint32_t hash = 2166136261u;
+  for (const std::string* str : {&task_key, &payload}) {
+    for (char c : *str) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+// write a record and return the number of bytes written
+uint64_t WriteRecord(std::ostream* os, const std::string& task_key, const std::string& payload) {
+  WriteFixed<uint32_t>(os, task_key.size());
+  WriteFixed<uint32_t>(os, payload.size());
+  WriteFixed<uint32_t>(os, Checksum(task_key, payload));
+  os->write(task_key.data(), task_key.size());
+  os->write(payload.data(), payload.size());
+  return kRecordHeaderSize + task_key.size() + payload.size();
+}
+
+// read the record at the current position, return false if it is incomplete or broken
+bool ReadRecord(std::istream* is, uint64_t max_size, std::string* task_key, std::string* payload) {
+  uint32_t key_size = 0, payload_size = 0, checksum = 0;
+  if (!ReadFixed(is, &key_size) || !ReadFixed(is, &payload_size) || !ReadFixed(is, &checksum)) {
+    return false;
+  }
+  if (kRecordHeaderSize + key_size + payload_size > max_size) {
+    return false;
+  }
+  task_key->resize(key_size);
+  payload->resize(payload_size);
+  if (!is->read(&(*task_key)[0], key_size) || !is->read(&(*payload)[0], payload_size)) {
+    return false;
+  }
+  return Checksum(*task_key, *payload) == checksum;
+}
+
+void WriteFooter(std::ostream* os, const std::unordered_map<std::string, std::vector<uint64_t>>& key2offsets) {
+  // sort the keys to make the file content stable
+  std::vector<const std::string*> keys;
+  for (const auto& kv : key2offsets) {
+    keys.push_back(&kv.first);
+  }
+  std::sort(keys.begin(), keys.end(), [](const std::string* lhs, const std::string* rhs) { return *lhs < *rhs; });
+
+  proto::TuningRecordIndex index;
+  for (const auto* key : keys) {
+    auto* entry = index.add_entries();
+    entry->set_task_key(*key);
+    for (uint64_t offset : key2offsets.at(*key)) {
+      entry->add_offsets(offset);
+    }
+  }
+  std::string index_str;
+  CHECK(index.SerializeToString(&index_str)) << "Failed to serialize the index of tuning records";
+  os->write(index_str.data(), index_str.size());
+  WriteFixed<uint64_t>(os, index_str.size());
+  os->write(kIndexMagic, kMagicSize);
+}
+}  // namespace
+
+BinaryFileDatabase::BinaryFileDatabase(int capacity_per_task,
+                                       const std::string& record_file_path,
+                                       bool allow_new_file)
+    : Database(capacity_per_task), record_file_path_(record_file_path) {
+  VLOG(3) << "Auto schedule will save/load tuning records on binary file:" << record_file_path;
+  std::ifstream is(record_file_path_, std::ifstream::binary);
+  if (!is.good()) {
+    CHECK(allow_new_file) << "File doesn't exist: " << record_file_path_;
+    std::ofstream os(record_file_path_, std::ofstream::binary);
+    CHECK(os.good()) << "Cannot create new file: " << record_file_path_;
+    os.write(kRecordMagic, kMagicSize);
+    records_end_ = kMagicSize;
+    return;
+  }
+
+  std::string magic(kMagicSize, '\0');
+  is.read(&magic[0], kMagicSize);
+  CHECK(is.good() && magic == kRecordMagic) << "Not a binary tuning record file: " << record_file_path_;
+  is.seekg(0, std::ifstream::end);
+  uint64_t file_size = is.tellg();
+
+  // read the index from the footer if it is valid, otherwise rebuild it by scanning the records
+  uint64_t index_size = 0;
+  if (file_size >= kMagicSize + kTrailerSize) {
+    is.seekg(file_size - kTrailerSize);
+    if (ReadFixed(&is, &index_size) && is.read(&magic[0], kMagicSize) && magic == kIndexMagic &&
+        index_size <= file_size - kMagicSize - kTrailerSize) {
+      std::string index_str(index_size, '\0');
+      is.seekg(file_size - kTrailerSize - index_size);
+      proto::TuningRecordIndex index;
+      if (is.read(&index_str[0], index_size) && index.ParseFromString(index_str)) {
+        for (const auto& entry : index.entries()) {
+          key2offsets_[entry.task_key()].assign(entry.offsets().begin(), entry.offsets().end());
+        }
+        records_end_ = file_size - kTrailerSize - index_size;
+        has_tail_    = true;
+        VLOG(3) << "Read the index of " << key2offsets_.size() << " task keys from " << record_file_path_;
+        return;
+      }
+    }
+  }
+  LOG(INFO) << "The index footer of " << record_file_path_ << " is missing or broken, rebuild it by scanning";
+  is.clear();
+  ScanRecords(&is, file_size);
+}
+
+BinaryFileDatabase::~BinaryFileDatabase() { Flush(); }
+
+void BinaryFileDatabase::ScanRecords(std::istream* is, uint64_t file_size) {
+  uint64_t pos = kMagicSize;
+  std::string task_key, payload;
+  is->seekg(pos);
+  while (ReadRecord(is, file_size - pos, &task_key, &payload)) {
+    key2offsets_[task_key].push_back(pos);
+    pos += kRecordHeaderSize + task_key.size() + payload.size();
+  }
+  if (pos < file_size) {
+    LOG(WARNING) << "Ignore the broken tail of " << file_size - pos << " bytes in " << record_file_path_;
+  }
+  records_end_ = pos;
+  has_tail_    = pos < file_size;
+  index_dirty_ = true;
+}
+
+void BinaryFileDatabase::TruncateTail() {
+  if (!has_tail_) return;
+  CHECK_EQ(::truncate(record_file_path_.c_str(), records_end_), 0) << "Cannot truncate file: " << record_file_path_;
+  has_tail_ = false;
+}
+
+void BinaryFileDatabase::Flush() {
+  if (!index_dirty_) return;
+  TruncateTail();
+  std::ofstream os(record_file_path_, std::ofstream::binary | std::ofstream::app);
+  CHECK(os.good()) << "Cannot open the file to write: " << record_file_path_;
+  WriteFooter(&os, key2offsets_);
+  os.flush();
+  CHECK(os.good()) << "Failed to write the index footer to " << record_file_path_;
+  has_tail_    = true;
+  index_dirty_ = false;
+}
+
+bool BinaryFileDatabase::Commit(const TuningRecord& record) {
+  std::string payload;
+  CHECK(record.ToProto().SerializeToString(&payload))
+      << "Failed to serialize record to binary, task key = " << record.task_key;
+  TruncateTail();
+  std::ofstream os(record_file_path_, std::ofstream::binary | std::ofstream::app);
+  CHECK(os.good()) << "Cannot open the file to write: " << record_file_path_;
+  uint64_t offset = records_end_;
+  records_end_ += WriteRecord(&os, record.task_key, payload);
+  os.flush();
+  CHECK(os.good()) << "Failed to write record to " << record_file_path_;
+
+  key2offsets_[record.task_key].push_back(offset);
+  index_dirty_ = true;
+  return true;
+}
+
+void BinaryFileDatabase::LoadRecords(const std::string& task_key) {
+  if (loaded_keys_.count(task_key)) return;
+  std::ifstream is(record_file_path_, std::ifstream::binary);
+  LoadRecords(task_key, &is);
+}
+
+void BinaryFileDatabase::LoadRecords(const std::string& task_key, std::istream* is) {
+  if (!loaded_keys_.insert(task_key).second) return;
+  auto it = key2offsets_.find(task_key);
+  if (it == key2offsets_.end()) return;
+
+  CHECK(is->good()) << "Cannot open the file to read: " << record_file_path_;
+  std::string key, payload;
+  for (uint64_t offset : it->second) {
+    is->seekg(offset);
+    CHECK(ReadRecord(is, records_end_ - offset, &key, &payload) && key == task_key)
+        << "Broken record of task_key=" << task_key << " at offset " << offset << " in " << record_file_path_;
+
+    proto::TuningRecord record_proto;
+    CHECK(record_proto.ParseFromString(payload)) << "Failed to parse record at offset " << offset;
+    Insert(TuningRecord(record_proto));
+  }
+  VLOG(4) << "Load " << it->second.size() << " TuningRecords with task_key=" << task_key;
+}
+
+void BinaryFileDatabase::LoadAllRecords() {
+  InitialTaskRegistry* task_registry = InitialTaskRegistry::Global();
+  std::ifstream is(record_file_path_, std::ifstream::binary);
+  for (const auto& kv : key2offsets_) {
+    if (task_registry->Has(kv.first)) {
+      LoadRecords(kv.first, &is);
+    }
+  }
+}
+
+std::vector<std::string> BinaryFileDatabase::GetAllTaskKeys() {
+  std::vector<std::string> keys = Database::GetAllTaskKeys();
+  for (const auto& kv : key2offsets_) {
+    if (!key2record_.count(kv.first)) {
+      keys.push_back(kv.first);
+    }
+  }
+  return keys;
+}
+
+size_t BinaryFileDatabase::Compact(const std::string& record_file_path, int capacity_per_task) {
+  const std::string tmp_file_path = record_file_path + ".compact";
+  size_t num_kept = 0, num_total = 0;
+  {
+    BinaryFileDatabase db(capacity_per_task, record_file_path, false);
+    std::ifstream is(record_file_path, std::ifstream::binary);
+    for (const auto& kv : db.key2offsets_) {
+      num_total += kv.second.size();
+      db.LoadRecords(kv.first, &is);
+    }
+
+    std::ofstream os(tmp_file_path, std::ofstream::binary | std::ofstream::trunc);
+    CHECK(os.good()) << "Cannot create new file: " << tmp_file_path;
+    os.write(kRecordMagic, kMagicSize);
+    uint64_t pos = kMagicSize;
+    std::unordered_map<std::string, std::vector<uint64_t>> key2offsets;
+    std::string payload;
+    for (const auto& kv : db.key2record_) {
+      for (const TuningRecord& record : kv.second) {
+        CHECK(record.ToProto().SerializeToString(&payload))
+            << "Failed to serialize record to binary, task key = " << record.task_key;
+        key2offsets[kv.first].push_back(pos);
+        pos += WriteRecord(&os, kv.first, payload);
+        ++num_kept;
+      }
+    }
+    WriteFooter(&os, key2offsets);
+    os.flush();
+    CHECK(os.good()) << "Failed to write file: " << tmp_file_path;
+    // the source file is replaced below, so it mustn't be touched at destruction
+    db.index_dirty_ = false;
+  }
+  CHECK_EQ(std::rename(tmp_file_path.c_str(), record_file_path.c_str()), 0)
+      << "Cannot replace " << record_file_path << " with the compacted file " << tmp_file_path;
+  LOG(INFO) << "Compact " << record_file_path << ": keep " << num_kept << " of " << num_total << " records";
+  return num_kept;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
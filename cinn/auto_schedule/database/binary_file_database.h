@@ -0,0 +1,97 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/auto_schedule/database/database.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+/**
+ * BinaryFileDatabase is a database implemented by a binary log file to save/load underlying data.
+ *
+ * The file consists of a magic header, the records and an optional index footer:
+ *   header: "CINNTRDB"
+ *   record: [key size: u32][record size: u32][checksum: u32][task_key][serialized proto::TuningRecord]
+ *   footer: [serialized proto::TuningRecordIndex][index size: u64]["CINNTIDX"]
+ * All the integers are little-endian. Only the footer is read at construction, and the records of a task_key
+ * are read and parsed the first time the key is accessed. New records are appended after the last record,
+ * which drops the footer, and the footer is rewritten by Flush() or at destruction. A file without a valid footer,
+ * such as one left by a crashed process, is recovered by scanning the records until the first torn one.
+ *
+ * The file should not be written by more than one database at the same time.
+ */
+class BinaryFileDatabase : public Database {
+ public:
+  /*!
+   * \brief Build a BinaryFileDatabase object from a binary record file.
+   * \param capacity_per_task The max number of candidates stored.
+   * \param record_file_path The path of the record file.
+   * \param allow_new_file Whether to create new file when the given path is not found.
+   */
+  BinaryFileDatabase(int capacity_per_task, const std::string& record_file_path, bool allow_new_file);
+  ~BinaryFileDatabase();
+
+  // write the index footer if it is out of date, so the next construction needn't scan the records
+  void Flush();
+
+  /*!
+   * \brief Rewrite a record file keeping only the top capacity_per_task records of each task_key.
+   * \param record_file_path The path of the record file.
+   * \param capacity_per_task The max number of records kept for each task_key.
+   * \return The number of records kept.
+   */
+  static size_t Compact(const std::string& record_file_path, int capacity_per_task);
+
+ protected:
+  // append the newly added record to the record file
+  bool Commit(const TuningRecord& record) override;
+  // read the records with specified key from the record file
+  void LoadRecords(const std::string& task_key) override;
+  // read the records of all registered keys from the record file
+  void LoadAllRecords() override;
+  // return the keys in the index without reading the records
+  std::vector<std::string> GetAllTaskKeys() override;
+
+ private:
+  void LoadRecords(const std::string& task_key, std::istream* is);
+  // build the index by scanning the records from the beginning
+  void ScanRecords(std::istream* is, uint64_t file_size);
+  // cut the footer or the broken tail after the last record
+  void TruncateTail();
+
+  // the name of the binary file to save tuning records
+  std::string record_file_path_;
+  // map task_key to the offsets of its records in the file
+  std::unordered_map<std::string, std::vector<uint64_t>> key2offsets_;
+  // the keys whose records have been read into memory
+  std::unordered_set<std::string> loaded_keys_;
+  // the end of the last record
+  uint64_t records_end_ = 0;
+  // whether there are bytes after the last record, i.e. the footer or a broken tail
+  bool has_tail_ = false;
+  // whether the index differs from the footer on file
+  bool index_dirty_ = false;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,182 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/database/binary_file_database.h"
+
+#include <google/protobuf/util/message_differencer.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "cinn/auto_schedule/search_space/search_state.h"
+#include "cinn/auto_schedule/task/task_registry.h"
+#include "cinn/cinn.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/optim/ir_copy.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Create an IRSchedule of a simple copy function, and regist it with task_key
+ir::IRSchedule MakeIRSchedule(const std::string& task_key) {
+  Placeholder<float> A("A", {Expr(32), Expr(32)});
+  ir::Tensor B = Compute(
+      {Expr(32), Expr(32)}, [&A](Var i, Var j) { return A(i, j); }, "B");
+  auto funcs = cinn::lang::LowerVec(
+      "test_func", CreateStages({A, B}), {A, B}, {}, {}, nullptr, common::DefaultHostTarget(), true);
+
+  std::vector<Expr> exprs;
+  for (auto&& func : funcs) {
+    exprs.emplace_back(optim::IRCopy(func->body));
+  }
+  InitialTaskRegistry::Global()->Regist(task_key, ir::ModuleExpr(exprs));
+  return ir::IRSchedule(ir::ModuleExpr(exprs));
+}
+
+TuningRecord MakeRecord(const std::string& task_key, double execution_cost, float predicted_cost = 1.0) {
+  return TuningRecord(task_key, SearchState(MakeIRSchedule(task_key), predicted_cost), execution_cost);
+}
+
+uint64_t FileSize(const std::string& file_path) {
+  std::ifstream is(file_path, std::ifstream::binary | std::ifstream::ate);
+  return is.tellg();
+}
+
+class TestBinaryFileDatabase : public ::testing::Test {
+ public:
+  void SetUp() override { std::remove(record_file_path.c_str()); }
+  void TearDown() override { std::remove(record_file_path.c_str()); }
+
+  std::string record_file_path = "/tmp/test_record.bin";
+};
+
+TEST_F(TestBinaryFileDatabase, Basic) {
+  BinaryFileDatabase test_db(2, record_file_path, true);
+  test_db.AddRecord(MakeRecord("k1", 1.0));
+  test_db.AddRecord(MakeRecord("k2", 2.0));
+  test_db.AddRecord(MakeRecord("k2", 3.0));
+  test_db.AddRecord(MakeRecord("k3", 3.0));
+  test_db.AddRecord(MakeRecord("k3", 4.0));
+  test_db.AddRecord(MakeRecord("k3", 5.0));
+  test_db.AddRecord(MakeRecord("k4", 4.0));
+
+  ASSERT_EQ(test_db.Size(), 6);
+  auto records = test_db.LookUp("k3");
+  ASSERT_EQ(test_db.Count("k3"), 2);
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0].execution_cost, 3.0);
+  EXPECT_EQ(records[1].execution_cost, 4.0);
+}
+
+TEST_F(TestBinaryFileDatabase, Reload) {
+  ir::IRSchedule ir_sch = MakeIRSchedule("k1");
+  ir_sch.Fuse("B", {0, 1});
+  TuningRecord record("k1", SearchState(std::move(ir_sch), 1.5), 1.0);
+  {
+    BinaryFileDatabase test_db(2, record_file_path, true);
+    test_db.AddRecord(record);
+    test_db.AddRecord(MakeRecord("k2", 2.0));
+    test_db.AddRecord(MakeRecord("k2", 3.0));
+    test_db.AddRecord(MakeRecord("k2", 1.0));
+  }
+
+  // the new database reads the records from the index footer
+  BinaryFileDatabase new_db(2, record_file_path, false);
+  auto loaded_records = new_db.LookUp("k1");
+  ASSERT_EQ(loaded_records.size(), 1);
+  EXPECT_EQ(loaded_records[0].task_key, record.task_key);
+  EXPECT_EQ(loaded_records[0].execution_cost, record.execution_cost);
+  EXPECT_FLOAT_EQ(loaded_records[0].predicted_cost, record.predicted_cost);
+  google::protobuf::util::MessageDifferencer dif;
+  dif.TreatAsSet(ir::proto::ScheduleDesc_Step::descriptor()->FindFieldByName("attrs"));
+  EXPECT_TRUE(dif.Compare(record.trace, loaded_records[0].trace));
+
+  auto k2_records = new_db.GetTopK("k2", 2);
+  ASSERT_EQ(k2_records.size(), 2);
+  EXPECT_EQ(k2_records[0].execution_cost, 1.0);
+  EXPECT_EQ(k2_records[1].execution_cost, 2.0);
+  ASSERT_EQ(new_db.Size(), 3);
+
+  // append to a file with footer
+  new_db.AddRecord(MakeRecord("k1", 0.5));
+  new_db.Flush();
+  BinaryFileDatabase another_db(2, record_file_path, false);
+  ASSERT_EQ(another_db.Count("k1"), 2);
+  EXPECT_EQ(another_db.LookUp("k1")[0].execution_cost, 0.5);
+}
+
+TEST_F(TestBinaryFileDatabase, RecoverWithoutFooter) {
+  {
+    BinaryFileDatabase test_db(2, record_file_path, true);
+    test_db.AddRecord(MakeRecord("k1", 1.0));
+    test_db.AddRecord(MakeRecord("k2", 2.0));
+  }
+  // break the footer as if the process crashed when writing it
+  {
+    std::ofstream os(record_file_path, std::ofstream::binary | std::ofstream::app);
+    os << "broken";
+  }
+
+  {
+    BinaryFileDatabase test_db(2, record_file_path, false);
+    ASSERT_EQ(test_db.Count("k1"), 1);
+    ASSERT_EQ(test_db.Count("k2"), 1);
+    test_db.AddRecord(MakeRecord("k2", 1.0));
+  }
+  BinaryFileDatabase new_db(2, record_file_path, false);
+  ASSERT_EQ(new_db.Size(), 3);
+  EXPECT_EQ(new_db.LookUp("k2")[0].execution_cost, 1.0);
+}
+
+TEST_F(TestBinaryFileDatabase, Compact) {
+  {
+    BinaryFileDatabase test_db(10, record_file_path, true);
+    for (int i = 0; i < 10; ++i) {
+      test_db.AddRecord(MakeRecord("k1", 10.0 - i));
+      test_db.AddRecord(MakeRecord("k2", 20.0 + i));
+    }
+  }
+  uint64_t size_before = FileSize(record_file_path);
+  ASSERT_EQ(BinaryFileDatabase::Compact(record_file_path, 2), 4);
+  ASSERT_LT(FileSize(record_file_path), size_before);
+
+  BinaryFileDatabase new_db(10, record_file_path, false);
+  ASSERT_EQ(new_db.Size(), 4);
+  auto k1_records = new_db.LookUp("k1");
+  ASSERT_EQ(k1_records.size(), 2);
+  EXPECT_EQ(k1_records[0].execution_cost, 1.0);
+  EXPECT_EQ(k1_records[1].execution_cost, 2.0);
+  auto k2_records = new_db.LookUp("k2");
+  ASSERT_EQ(k2_records.size(), 2);
+  EXPECT_EQ(k2_records[0].execution_cost, 20.0);
+  EXPECT_EQ(k2_records[1].execution_cost, 21.0);
+}
+
+TEST_F(TestBinaryFileDatabase, Make) {
+  DatabaseConfig config;
+  config.type              = DatabaseType::kBinaryFile;
+  config.record_file_path  = record_file_path;
+  config.capacity_per_task = 2;
+  {
+    auto db = Database::Make(config);
+    db->AddRecord(MakeRecord("k1", 1.0));
+  }
+  auto db = Database::Make(config);
+  ASSERT_EQ(db->Count("k1"), 1);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,33 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A tool to shrink a binary tuning record file, usage:
+//   compact_tuning_records --record_file_path=/tmp/tuning_record.bin --capacity_per_task=2
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "cinn/auto_schedule/database/binary_file_database.h"
+
+DEFINE_string(record_file_path, "", "The path of the binary tuning record file to compact.");
+DEFINE_int32(capacity_per_task, 2, "The max number of records kept for each task_key.");
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  CHECK(!FLAGS_record_file_path.empty()) << "--record_file_path is required";
+
+  cinn::auto_schedule::BinaryFileDatabase::Compact(FLAGS_record_file_path, FLAGS_capacity_per_task);
+  return 0;
+}
@@ -18,7 +18,11 @@
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/util/json_util.h>
 
+#include <limits>
+
+#include "cinn/auto_schedule/database/binary_file_database.h"
 #include "cinn/auto_schedule/database/jsonfile_database.h"
+#include "cinn/auto_schedule/database/record_transfer.h"
 #include "cinn/auto_schedule/task/task_registry.h"
 #include "cinn/ir/ir_schedule.h"
 #include "cinn/ir/schedule_desc.h"
@@ -48,6 +52,8 @@ std::unique_ptr<Database> Database::Make(const DatabaseConfig& config) {
     return std::make_unique<Database>(config.capacity_per_task);
   } else if (config.type == DatabaseType::kJSONFile) {
     return std::make_unique<JSONFileDatabase>(config.capacity_per_task, config.record_file_path, true);
+  } else if (config.type == DatabaseType::kBinaryFile) {
+    return std::make_unique<BinaryFileDatabase>(config.capacity_per_task, config.record_file_path, true);
   }
 
   LOG(FATAL) << "Unimplemented database type.";
@@ -65,11 +71,13 @@ void Database::Insert(const TuningRecord& record) {
 bool Database::AddRecord(const TuningRecord& record) {
   CHECK(!record.task_key.empty()) << "task_key of TuningRecord can't be empty";
 
+  LoadRecords(record.task_key);
   Insert(record);
   return Commit(record);
 }
 
 std::vector<TuningRecord> Database::LookUp(const std::string& task_key) {
+  LoadRecords(task_key);
   auto fit = key2record_.find(task_key);
   if (fit == key2record_.end()) {
     return {};
@@ -82,6 +90,7 @@ std::vector<TuningRecord> Database::LookUp(const std::string& task_key) {
 }
 
 std::vector<TuningRecord> Database::GetTopK(const std::string& task_key, int k) {
+  LoadRecords(task_key);
   auto fit = key2record_.find(task_key);
   if (fit == key2record_.end() || k <= 0) {
     return {};
@@ -102,7 +111,49 @@ std::vector<TuningRecord> Database::GetTopK(const std::string& task_key, int k)
   return results;
 }
 
+std::vector<TuningRecord> Database::GetTopKSimilar(const std::string& task_key, int k) {
+  TaskKeyStructure structure = ParseTaskKey(task_key);
+  if (structure.var_names.empty()) {
+    return {};
+  }
+
+  std::string similar_key;
+  double min_distance = std::numeric_limits<double>::max();
+  for (const std::string& key : GetAllTaskKeys()) {
+    if (key == task_key) {
+      continue;
+    }
+    TaskKeyStructure candidate = ParseTaskKey(key);
+    if (candidate.structural_key != structure.structural_key) {
+      continue;
+    }
+    double distance = ShapeDistance(structure, candidate);
+    // break ties by the key to be deterministic
+    if (distance < min_distance || (distance == min_distance && !similar_key.empty() && key < similar_key)) {
+      min_distance = distance;
+      similar_key  = key;
+    }
+  }
+  if (similar_key.empty()) {
+    return {};
+  }
+  VLOG(4) << "The most similar task of:\n"
+          << task_key << "\nis:\n"
+          << similar_key << "\nwith distance " << min_distance;
+  return GetTopK(similar_key, k);
+}
+
+std::vector<std::string> Database::GetAllTaskKeys() {
+  std::vector<std::string> keys;
+  keys.reserve(key2record_.size());
+  for (const auto& kv : key2record_) {
+    keys.push_back(kv.first);
+  }
+  return keys;
+}
+
 size_t Database::Size() {
+  LoadAllRecords();
   auto res =
       std::accumulate(key2record_.begin(), key2record_.end(), size_t(0), [](size_t res, const auto& kv) -> size_t {
         return std::move(res) + kv.second.size();
@@ -111,6 +162,7 @@ size_t Database::Size() {
 }
 
 size_t Database::Count(const std::string& task_key) {
+  LoadRecords(task_key);
   auto fit = key2record_.find(task_key);
   if (fit == key2record_.end()) {
     return 0;
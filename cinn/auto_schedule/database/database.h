@@ -55,7 +55,7 @@ struct TuningRecord {
   };
 };
 
-enum class DatabaseType : int { kMemory, kJSONFile };
+enum class DatabaseType : int { kMemory, kJSONFile, kBinaryFile };
 
 struct DatabaseConfig {
   DatabaseType type            = DatabaseType::kMemory;
@@ -70,7 +70,7 @@ struct DatabaseConfig {
 class Database {
  public:
   explicit Database(int capacity_per_task);
-  ~Database() = default;
+  virtual ~Database() = default;
 
   // Create a Database with the specific config
   static std::unique_ptr<Database> Make(const DatabaseConfig& config);
@@ -81,6 +81,9 @@ class Database {
   std::vector<TuningRecord> LookUp(const std::string& task_key);
   // return the states of the top k in sorted candidates
   std::vector<TuningRecord> GetTopK(const std::string& task_key, int k);
+  // return the top k records of the task which has the same structure as the specified one
+  // but is the closest in shape, or empty if there is no such task
+  std::vector<TuningRecord> GetTopKSimilar(const std::string& task_key, int k);
   // return the total number of stored candidates
   size_t Size();
   // return the number of stored candidates with specified key
@@ -91,6 +94,13 @@ class Database {
   virtual bool Commit(const TuningRecord& record) { return true; }
   // insert a newly added record into memory storage
   void Insert(const TuningRecord& record);
+  // load the records with specified key from underlying storage into memory on demand,
+  // the storage which loads all records at construction does nothing here
+  virtual void LoadRecords(const std::string& task_key) {}
+  // load the records of all keys from underlying storage into memory
+  virtual void LoadAllRecords() {}
+  // return the keys of all tasks with records, including those not loaded yet
+  virtual std::vector<std::string> GetAllTaskKeys();
 
   // map task_key to its records
   std::unordered_map<std::string, std::multiset<TuningRecord, TuningRecord::Compare>> key2record_;
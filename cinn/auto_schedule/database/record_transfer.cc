@@ -0,0 +1,148 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/database/record_transfer.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "cinn/ir/schedule_desc.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+TaskKeyStructure ParseTaskKey(const std::string& task_key) {
+  static const std::string kDelimiters = " (,\n";
+  TaskKeyStructure structure;
+  std::unordered_map<std::string, int> name2index;
+  size_t copied = 0;
+  size_t arrow  = 0;
+  while ((arrow = task_key.find("->", arrow)) != std::string::npos) {
+    size_t name_begin = task_key.find_last_of(kDelimiters, arrow);
+    name_begin        = name_begin == std::string::npos ? 0 : name_begin + 1;
+    size_t dims_begin = task_key.find('[', arrow);
+    size_t dims_end   = task_key.find(']', arrow);
+    if (name_begin < copied || dims_begin == std::string::npos || dims_end == std::string::npos ||
+        dims_end < dims_begin) {
+      arrow += 2;
+      continue;
+    }
+
+    std::string name = task_key.substr(name_begin, arrow - name_begin);
+    auto it          = name2index.find(name);
+    if (it == name2index.end()) {
+      it = name2index.emplace(name, structure.var_names.size()).first;
+      structure.var_names.push_back(name);
+      std::vector<int> shape;
+      std::string dims = task_key.substr(dims_begin + 1, dims_end - dims_begin - 1);
+      for (size_t pos = 0; pos < dims.size();) {
+        size_t comma = std::min(dims.find(',', pos), dims.size());
+        shape.push_back(std::atoi(dims.substr(pos, comma - pos).c_str()));
+        pos = comma + 1;
+      }
+      structure.var_shapes.push_back(std::move(shape));
+    }
+    structure.structural_key.append(task_key, copied, name_begin - copied);
+    structure.structural_key.append("v" + std::to_string(it->second));
+    structure.structural_key.append(task_key, arrow, dims_begin - arrow);
+    copied = dims_end + 1;
+    arrow  = copied;
+  }
+  structure.structural_key.append(task_key, copied, std::string::npos);
+  return structure;
+}
+
+double ShapeDistance(const TaskKeyStructure& lhs, const TaskKeyStructure& rhs) {
+  if (lhs.var_shapes.size() != rhs.var_shapes.size()) {
+    return std::numeric_limits<double>::max();
+  }
+  double distance = 0.0;
+  for (size_t i = 0; i < lhs.var_shapes.size(); ++i) {
+    const auto& lhs_shape = lhs.var_shapes[i];
+    const auto& rhs_shape = rhs.var_shapes[i];
+    if (lhs_shape.size() != rhs_shape.size()) {
+      return std::numeric_limits<double>::max();
+    }
+    for (size_t j = 0; j < lhs_shape.size(); ++j) {
+      if (lhs_shape[j] != rhs_shape[j]) {
+        distance += lhs_shape[j] > 0 && rhs_shape[j] > 0 ? std::abs(std::log(double(lhs_shape[j]) / rhs_shape[j]))
+                                                         : 1.0;
+      }
+    }
+  }
+  return distance;
+}
+
+bool ApplySimilarRecord(const TuningRecord& record, const std::string& task_key, ir::IRSchedule* schedule) {
+  TaskKeyStructure source = ParseTaskKey(record.task_key);
+  TaskKeyStructure target = ParseTaskKey(task_key);
+  if (source.structural_key != target.structural_key) {
+    VLOG(4) << "The record of task:\n" << record.task_key << "\nhas a different structure from task:\n" << task_key;
+    return false;
+  }
+
+  // rename a name or a name derived from it by appending a suffix, such as the block of a reduce init,
+  // and try the longer names first in case one is the prefix of another
+  std::vector<std::pair<std::string, std::string>> renames;
+  for (size_t i = 0; i < source.var_names.size(); ++i) {
+    if (source.var_names[i] != target.var_names[i]) {
+      renames.emplace_back(source.var_names[i], target.var_names[i]);
+    }
+  }
+  std::sort(renames.begin(), renames.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first.size() > rhs.first.size();
+  });
+  auto rename_fn = [&renames](std::string* name) {
+    for (const auto& rename : renames) {
+      const std::string& old_name = rename.first;
+      if (name->compare(0, old_name.size(), old_name) == 0 &&
+          (name->size() == old_name.size() || name->at(old_name.size()) == '_')) {
+        name->replace(0, old_name.size(), rename.second);
+        return;
+      }
+    }
+  };
+
+  ir::proto::ScheduleDesc trace = record.trace;
+  if (!renames.empty()) {
+    for (auto& step : *trace.mutable_steps()) {
+      for (auto& attr : *step.mutable_attrs()) {
+        if (attr.dtype() == ir::proto::ScheduleDesc_Attr_DataType_STRING) {
+          rename_fn(attr.mutable_s());
+        } else if (attr.dtype() == ir::proto::ScheduleDesc_Attr_DataType_STRINGS) {
+          for (auto& s : *attr.mutable_strings()) {
+            rename_fn(&s);
+          }
+        }
+      }
+    }
+  }
+
+  try {
+    ir::ScheduleDesc::ReplayWithProto(trace, schedule, /*without_post_schedule=*/false, /*adapt_tile_factors=*/true);
+  } catch (std::exception& e) {
+    VLOG(4) << "Failed to apply the record of task:\n" << record.task_key << "\nerror: " << e.what();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
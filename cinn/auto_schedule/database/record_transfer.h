@@ -0,0 +1,57 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/database/database.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// The structure of a task_key serialized by TuneTask, where each variable is
+// printed as `name->dtype[shape]`. Two tasks with the same op structure but
+// different shapes or variable names have the same structural_key.
+struct TaskKeyStructure {
+  // the task_key with each variable replaced by the order it first appears and its dtype
+  std::string structural_key;
+  // the names of variables in the order they first appear
+  std::vector<std::string> var_names;
+  // the shapes of variables in var_names
+  std::vector<std::vector<int>> var_shapes;
+};
+
+// Parse the variables of a task_key
+TaskKeyStructure ParseTaskKey(const std::string& task_key);
+
+// Return the distance between the shapes of two tasks with the same structure, that is the sum of |log(a / b)|
+// over the dimensions of all variables, or the max value of double if the ranks of variables differ
+double ShapeDistance(const TaskKeyStructure& lhs, const TaskKeyStructure& rhs);
+
+/**
+ * \brief Apply the trace of a record tuned on a similar task to the schedule of a task. The variable
+ * names in the string attributes, such as block names, are renamed to those of the task, and the tile
+ * factors are re-derived for the extents of the task.
+ * @param record The record tuned on a task with the same structural_key.
+ * @param task_key The task_key of the schedule.
+ * @param schedule The initial schedule of the task, which should be discarded if failed.
+ * @return Whether the trace is applied successfully.
+ */
+bool ApplySimilarRecord(const TuningRecord& record, const std::string& task_key, ir::IRSchedule* schedule);
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,120 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/database/record_transfer.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
+#include "cinn/lang/lower.h"
+#include "cinn/optim/ir_copy.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// a task_key in the format of TuneTask::SerializeToString
+std::string MakeTaskKey(const std::string& in, const std::string& out, int m, int n) {
+  std::string shape = "[" + std::to_string(m) + "," + std::to_string(n) + "]";
+  return "Target<linux,x86,64>\n\nGroup {\n  (" + out + "->float32" + shape + ") = relu(" + in + "->float32" + shape +
+         ")\n}\n";
+}
+
+// the schedule of the task computing out = relu(in) with the shape [m, n]
+ir::IRSchedule MakeSchedule(const std::string& in, const std::string& out, int m, int n) {
+  Placeholder<float> A(in, {Expr(m), Expr(n)});
+  auto B = Compute(
+      {Expr(m), Expr(n)}, [&A](Var i, Var j) { return lang::Relu(A(i, j)); }, out);
+  auto funcs = lang::LowerVec(
+      "test_record_transfer", CreateStages({A, B}), {A, B}, {}, {}, nullptr, common::DefaultHostTarget(), true);
+  std::vector<Expr> exprs;
+  for (auto&& func : funcs) {
+    exprs.emplace_back(optim::IRCopy(func->body));
+  }
+  return ir::IRSchedule(ir::ModuleExpr(exprs));
+}
+
+TEST(RecordTransfer, ParseTaskKey) {
+  TaskKeyStructure structure = ParseTaskKey(MakeTaskKey("x", "y", 32, 64));
+  ASSERT_EQ(structure.var_names, std::vector<std::string>({"y", "x"}));
+  ASSERT_EQ(structure.var_shapes, std::vector<std::vector<int>>({{32, 64}, {32, 64}}));
+  ASSERT_EQ(structure.structural_key, "Target<linux,x86,64>\n\nGroup {\n  (v0->float32) = relu(v1->float32)\n}\n");
+
+  // the same structure with different names and shapes
+  TaskKeyStructure similar = ParseTaskKey(MakeTaskKey("x_1", "y_1", 64, 64));
+  ASSERT_EQ(similar.structural_key, structure.structural_key);
+  ASSERT_DOUBLE_EQ(ShapeDistance(structure, similar), 2 * std::log(2.0));
+  ASSERT_DOUBLE_EQ(ShapeDistance(structure, structure), 0.0);
+
+  // a variable used twice is referred by the same index
+  TaskKeyStructure reused = ParseTaskKey("Group {\n  (y->float32[4]) = add(x->float32[4], x->float32[4])\n}\n");
+  ASSERT_EQ(reused.var_names.size(), 2);
+  ASSERT_EQ(reused.structural_key, "Group {\n  (v0->float32) = add(v1->float32, v1->float32)\n}\n");
+
+  // the key without any variable is kept as is
+  ASSERT_EQ(ParseTaskKey("k1").structural_key, "k1");
+  ASSERT_TRUE(ParseTaskKey("k1").var_names.empty());
+}
+
+TEST(RecordTransfer, GetTopKSimilar) {
+  Database database(2);
+  auto state = SearchState(ir::IRSchedule());
+  database.AddRecord(TuningRecord(MakeTaskKey("x", "y", 32, 32), state, 1.0));
+  database.AddRecord(TuningRecord(MakeTaskKey("x", "y", 128, 128), state, 2.0));
+  database.AddRecord(TuningRecord("Group {\n  (y->float32[64,64]) = exp(x->float32[64,64])\n}\n", state, 3.0));
+
+  // the closest in shape with the same ops is picked
+  auto records = database.GetTopKSimilar(MakeTaskKey("a", "b", 64, 32), 2);
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].task_key, MakeTaskKey("x", "y", 32, 32));
+  records = database.GetTopKSimilar(MakeTaskKey("a", "b", 128, 64), 2);
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].task_key, MakeTaskKey("x", "y", 128, 128));
+
+  // the task itself is excluded
+  records = database.GetTopKSimilar(MakeTaskKey("x", "y", 32, 32), 1);
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].task_key, MakeTaskKey("x", "y", 128, 128));
+  ASSERT_TRUE(database.GetTopKSimilar("Group {\n  (y->float32[64,64]) = tanh(x->float32[64,64])\n}\n", 1).empty());
+}
+
+TEST(RecordTransfer, ApplySimilarRecord) {
+  ir::IRSchedule tuned_sch = MakeSchedule("A", "B", 32, 32);
+  auto loops               = tuned_sch.GetLoops("B");
+  tuned_sch.Split(loops[0], tuned_sch.SamplePerfectTile(loops[0], 2, 8, {4, 8}));
+  TuningRecord record(MakeTaskKey("A", "B", 32, 32), SearchState(std::move(tuned_sch)), 1.0);
+
+  // the block is renamed and the tile factors fit the new extent
+  const std::string task_key = MakeTaskKey("C", "D", 64, 32);
+  ir::IRSchedule schedule    = MakeSchedule("C", "D", 64, 32);
+  ASSERT_TRUE(ApplySimilarRecord(record, task_key, &schedule));
+  loops = schedule.GetLoops("D");
+  ASSERT_EQ(loops.size(), 3);
+  EXPECT_EQ(ir::GetLoopExtent(loops[0]), 8);
+  EXPECT_EQ(ir::GetLoopExtent(loops[1]), 8);
+  EXPECT_EQ(ir::GetLoopExtent(loops[2]), 32);
+
+  // a record of another structure is not applied
+  ir::IRSchedule other_schedule = MakeSchedule("C", "D", 64, 32);
+  const std::string other_key   = "Group {\n  (D->float32[64,32]) = exp(C->float32[64,32])\n}\n";
+  ASSERT_FALSE(ApplySimilarRecord(record, other_key, &other_schedule));
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,179 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/graph_tuner/fusion_tuner.h"
+
+#include <glog/logging.h>
+
+#include <exception>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "cinn/auto_schedule/search_space/search_state.h"
+#include "cinn/auto_schedule/task/task_optimizer.h"
+#include "cinn/auto_schedule/task/tune_task.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+using ::cinn::hlir::framework::Node;
+using ::cinn::hlir::framework::NodeData;
+
+FusionTuner::FusionTuner(const hlir::framework::Graph* graph,
+                         hlir::framework::OpLowerer* op_lowerer,
+                         ScheduleMeasurer* schedule_measurer,
+                         Database* database,
+                         const Config& config)
+    : target_(graph->target_),
+      shape_dict_(graph->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape")),
+      dtype_dict_(graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype")),
+      op_lowerer_(op_lowerer),
+      schedule_measurer_(schedule_measurer),
+      database_(database),
+      config_(config) {
+  CHECK(op_lowerer_ != nullptr) << "op_lowerer can't be nullptr";
+  CHECK(schedule_measurer_ != nullptr) << "schedule_measurer can't be nullptr";
+  CHECK(database_ != nullptr) << "database can't be nullptr";
+}
+
+std::vector<SubGraphPtr> FusionTuner::Tune(const std::vector<SubGraphPtr>& groups) {
+  std::vector<SubGraphPtr> results;
+  // the sub-groups emitted separately, a sub-group recomputed in several fused groups is emitted only once
+  std::unordered_set<hlir::framework::Graph::Group*> emitted_sub_groups;
+  for (const auto& group : groups) {
+    if (group->fused_sub_groups.size() <= 1) {
+      results.push_back(group);
+      continue;
+    }
+
+    std::vector<SubGraphPtr> sub_groups = SortSubGroups(group);
+    double fused_cost                   = MeasureGroup(group);
+    double split_cost                   = 0.0;
+    for (const auto& sub_group : sub_groups) {
+      if (!emitted_sub_groups.count(sub_group.get())) {
+        split_cost += MeasureGroup(sub_group);
+      }
+    }
+    VLOG(3) << "Fused group:" << group->group_id << " with " << sub_groups.size()
+            << " sub-groups, fused cost=" << fused_cost << "us, split cost=" << split_cost << "us";
+
+    if (split_cost < fused_cost * config_.split_cost_ratio) {
+      VLOG(3) << "Split the fused group:" << group->group_id;
+      for (const auto& sub_group : sub_groups) {
+        if (emitted_sub_groups.insert(sub_group.get()).second) {
+          results.push_back(sub_group);
+        }
+      }
+    } else {
+      results.push_back(group);
+    }
+  }
+  VLOG(3) << "Tuned fusion groups size:" << results.size() << ", the initial size:" << groups.size();
+  return results;
+}
+
+double FusionTuner::MeasureGroup(const SubGraphPtr& group) {
+  // the input/output names of a group are changed in lowering, so revert them like TaskOptimizer
+  auto initial_input_names  = group->input_names;
+  auto initial_output_names = group->output_names;
+
+  TuneTask task(group);
+  task.target = target_;
+  double cost = std::numeric_limits<double>::max();
+  try {
+    task.Initialize(shape_dict_, dtype_dict_, op_lowerer_);
+    std::string measured_key = TaskOptimizer::ManualMeasuredKey(task);
+    auto records             = database_->GetTopK(measured_key, 1);
+    if (!records.empty()) {
+      cost = records[0].execution_cost;
+    } else {
+      std::vector<MeasureInput> inputs(1);
+      inputs.back().task          = &task;
+      inputs.back().lowered_funcs = op_lowerer_->Lower(task.subgraph);
+      MeasureResult result        = schedule_measurer_->Measure(inputs).front();
+      if (result.error_msg.empty()) {
+        cost = result.execution_cost;
+        std::vector<ir::Expr> func_bodys;
+        for (const ir::LoweredFunc& func : inputs.back().lowered_funcs) {
+          func_bodys.push_back(func->body);
+        }
+        SearchState state(ir::IRSchedule(ir::ModuleExpr(std::move(func_bodys))));
+        database_->AddRecord(TuningRecord(measured_key, state, cost));
+      } else {
+        LOG(WARNING) << "Failed to measure group:" << group->group_id << ", error:" << result.error_msg;
+      }
+    }
+  } catch (std::exception& e) {
+    LOG(WARNING) << "Failed to lower group:" << group->group_id << ", error:" << e.what();
+  }
+
+  group->input_names  = initial_input_names;
+  group->output_names = initial_output_names;
+  return cost;
+}
+
+std::vector<SubGraphPtr> FusionTuner::SortSubGroups(const SubGraphPtr& group) const {
+  const auto& sub_groups = group->fused_sub_groups;
+  std::unordered_map<const Node*, int> node2index;
+  for (int i = 0; i < sub_groups.size(); ++i) {
+    for (const Node* node : sub_groups[i]->nodes) {
+      node2index[node] = i;
+    }
+  }
+
+  // count the producers of each sub-group inside the fused group
+  std::vector<std::unordered_set<int>> consumers(sub_groups.size());
+  std::vector<int> num_producers(sub_groups.size(), 0);
+  for (int i = 0; i < sub_groups.size(); ++i) {
+    for (const Node* node : sub_groups[i]->nodes) {
+      for (const auto& out_link : node->outlinks()) {
+        const auto* node_data = out_link->sink()->safe_as<NodeData>();
+        CHECK(node_data) << "var node invalid";
+        for (const auto& consumer_link : node_data->outlinks()) {
+          auto it = node2index.find(consumer_link->sink()->safe_as<Node>());
+          if (it != node2index.end() && it->second != i && consumers[i].insert(it->second).second) {
+            ++num_producers[it->second];
+          }
+        }
+      }
+    }
+  }
+
+  // pick the first ready one each time to keep the original order as much as possible
+  std::vector<SubGraphPtr> sorted;
+  std::vector<bool> visited(sub_groups.size(), false);
+  while (sorted.size() < sub_groups.size()) {
+    int ready = -1;
+    for (int i = 0; i < sub_groups.size(); ++i) {
+      if (!visited[i] && num_producers[i] == 0) {
+        ready = i;
+        break;
+      }
+    }
+    CHECK_NE(ready, -1) << "The sub-groups of group:" << group->group_id << " have a cycle";
+    visited[ready] = true;
+    sorted.push_back(sub_groups[ready]);
+    for (int consumer : consumers[ready]) {
+      --num_producers[consumer];
+    }
+  }
+  return sorted;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
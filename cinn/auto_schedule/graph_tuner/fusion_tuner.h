@@ -0,0 +1,78 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/database/database.h"
+#include "cinn/auto_schedule/measure/schedule_measurer.h"
+#include "cinn/auto_schedule/tuning.h"
+#include "cinn/common/target.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/op_lowering.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+/**
+ * Tune the fusion partition of a graph by measuring the alternatives of each fused group.
+ *
+ * A group merged by FusionMergePass keeps the groups of OpFusionPass it consists of as fused_sub_groups.
+ * For each such group, the tuner measures it fused as a whole against its sub-groups compiled separately,
+ * where the intermediate variables between the sub-groups are materialized, and keeps the cheaper one.
+ * A sub-group recomputed in several fused groups is emitted at most once, so splitting a later group reuses
+ * the variables materialized before instead of recomputing them.
+ *
+ * The groups are measured with their manual schedules, and the costs are stored in the database with the
+ * same keys as the manual schedules measured by TaskOptimizer, so neither of them measures a group twice.
+ */
+class FusionTuner {
+ public:
+  struct Config {
+    // a fused group is split only if the total cost of its sub-groups is less than this ratio of its own cost,
+    // so the decision of FusionMergePass isn't flipped by the noise of measurement
+    double split_cost_ratio = 0.95;
+  };
+
+  FusionTuner(const hlir::framework::Graph* graph,
+              hlir::framework::OpLowerer* op_lowerer,
+              ScheduleMeasurer* schedule_measurer,
+              Database* database,
+              const Config& config);
+
+  // Return the tuned partition of the groups, which should be in topological order
+  std::vector<SubGraphPtr> Tune(const std::vector<SubGraphPtr>& groups);
+
+ private:
+  // Return the measured cost of a group with its manual schedule, or the max value of double if it fails
+  double MeasureGroup(const SubGraphPtr& group);
+
+  // Return the sub-groups of a fused group in topological order
+  std::vector<SubGraphPtr> SortSubGroups(const SubGraphPtr& group) const;
+
+  const common::Target& target_;
+  const absl::flat_hash_map<std::string, hlir::framework::shape_t>& shape_dict_;
+  const absl::flat_hash_map<std::string, common::Type>& dtype_dict_;
+  hlir::framework::OpLowerer* op_lowerer_;
+  ScheduleMeasurer* schedule_measurer_;
+  Database* database_;
+  Config config_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,193 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/graph_tuner/fusion_tuner.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/utils/data_util.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace auto_schedule {
+
+using ::cinn::hlir::framework::BuildScope;
+using ::cinn::hlir::framework::Graph;
+using ::cinn::hlir::framework::GraphCompiler;
+using ::cinn::hlir::framework::Node;
+using ::cinn::hlir::framework::NodeData;
+
+class DummyBuilder : public ScheduleBuilder {
+ public:
+  BuildResult Build(const MeasureInput& input) override { return BuildResult(); }
+};
+
+// A runner whose cost only depends on the number of nodes in a group
+class NodeCountRunner : public ScheduleRunner {
+ public:
+  explicit NodeCountRunner(std::function<double(int)> cost_fn) : cost_fn_(cost_fn) {}
+
+  MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) override {
+    ++num_runs;
+    MeasureResult result;
+    result.execution_cost = cost_fn_(input.task->subgraph->CollectNodes().size());
+    return result;
+  }
+
+  int num_runs = 0;
+
+ private:
+  std::function<double(int)> cost_fn_;
+};
+
+// Check no group consumes a variable produced by a later group
+bool IsTopologicalOrder(const std::vector<SubGraphPtr>& groups) {
+  std::unordered_map<const Node*, int> node2index;
+  for (int i = 0; i < groups.size(); ++i) {
+    for (const Node* node : groups[i]->CollectNodes()) {
+      node2index[node] = i;
+    }
+  }
+  for (int i = 0; i < groups.size(); ++i) {
+    for (const Node* node : groups[i]->CollectNodes()) {
+      for (const auto& in_link : node->inlinks()) {
+        const auto* producer = in_link->source()->safe_as<NodeData>()->source_node.get();
+        auto it              = node2index.find(producer);
+        if (it != node2index.end() && it->second > i) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+class TestFusionTuner : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_cinn_ir_schedule = true;
+    frontend::NetBuilder builder("fusion_tuner");
+    auto a  = builder.CreateInput(Float(32), {32, 32}, "A");
+    auto b  = builder.CreateInput(Float(32), {32, 32}, "B");
+    auto c  = builder.CreateInput(Float(32), {32, 32}, "C");
+    auto d  = builder.CreateInput(Float(32), {32, 32}, "D");
+    auto e  = builder.Add(a, b);
+    out_f   = builder.Add(e, c)->id;
+    out_g   = builder.Add(e, d)->id;
+    program = builder.Build();
+
+    // the three groups of OpFusionPass are merged into one by FusionMergePass
+    graph = std::make_shared<Graph>(program, target);
+    hlir::framework::ApplyPass(graph.get(), "OpFusionPass");
+    ASSERT_EQ(graph->fusion_groups.size(), 3);
+    hlir::framework::ApplyPass(graph.get(), "FusionMergePass");
+    ASSERT_EQ(graph->fusion_groups.size(), 1);
+    ASSERT_EQ(graph->fusion_groups.front()->fused_sub_groups.size(), 3);
+
+    const auto& dtype_dict = graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+    const auto& shape_dict = graph->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
+    op_lowerer             = std::make_unique<hlir::framework::OpLowerer>(dtype_dict, shape_dict, target);
+  }
+
+  std::vector<SubGraphPtr> Tune(std::function<double(int)> cost_fn, Database* database, int* num_runs) {
+    DummyBuilder builder;
+    NodeCountRunner runner(cost_fn);
+    ScheduleMeasurer measurer(&builder, &runner);
+    FusionTuner fusion_tuner(graph.get(), op_lowerer.get(), &measurer, database, FusionTuner::Config());
+    auto groups = fusion_tuner.Tune(graph->fusion_groups);
+    *num_runs   = runner.num_runs;
+    return groups;
+  }
+
+  Target target = common::DefaultHostTarget();
+  frontend::Program program;
+  std::string out_f, out_g;
+  std::shared_ptr<Graph> graph;
+  std::unique_ptr<hlir::framework::OpLowerer> op_lowerer;
+};
+
+TEST_F(TestFusionTuner, KeepFused) {
+  Database database(2);
+  int num_runs = 0;
+  auto groups  = Tune([](int num_nodes) { return 10.0 + num_nodes; }, &database, &num_runs);
+  ASSERT_EQ(groups.size(), 1);
+  ASSERT_EQ(groups.front(), graph->fusion_groups.front());
+  // the fused group and its three sub-groups
+  ASSERT_EQ(num_runs, 4);
+  ASSERT_EQ(database.Size(), 4);
+}
+
+TEST_F(TestFusionTuner, SplitAndReuseRecords) {
+  Database database(2);
+  int num_runs = 0;
+  auto groups  = Tune([](int num_nodes) { return 10.0 * num_nodes * num_nodes; }, &database, &num_runs);
+  ASSERT_EQ(groups.size(), 3);
+  ASSERT_EQ(num_runs, 4);
+  ASSERT_TRUE(IsTopologicalOrder(groups));
+  for (const auto& group : groups) {
+    ASSERT_EQ(group->CollectNodes().size(), 1);
+  }
+
+  // the measured costs are reused by the next tuning
+  auto retuned_groups = Tune([](int num_nodes) { return 10.0 * num_nodes * num_nodes; }, &database, &num_runs);
+  ASSERT_EQ(num_runs, 0);
+  ASSERT_EQ(retuned_groups, groups);
+}
+
+TEST_F(TestFusionTuner, CompileSplitGroups) {
+  Database database(2);
+  int num_runs = 0;
+  auto groups  = Tune([](int num_nodes) { return 10.0 * num_nodes * num_nodes; }, &database, &num_runs);
+  ASSERT_EQ(groups.size(), 3);
+
+  // the variables between the split groups are materialized correctly
+  auto scope = BuildScope(target, graph);
+  GraphCompiler graph_compiler(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  options.groups                     = groups;
+  for (auto& group : options.groups) {
+    options.lowered_funcs.push_back(op_lowerer->Lower(group));
+  }
+  auto runtime_program = graph_compiler.Build(options, {out_f, out_g}).runtime_program;
+
+  std::vector<std::string> input_names = {"A", "B", "C", "D"};
+  for (int i = 0; i < input_names.size(); ++i) {
+    SetRandData<float>(scope->GetTensor(input_names[i]), target, i);
+  }
+  runtime_program->Execute();
+
+  auto a = GetTensorData<float>(scope->GetTensor("A"), target);
+  auto b = GetTensorData<float>(scope->GetTensor("B"), target);
+  auto c = GetTensorData<float>(scope->GetTensor("C"), target);
+  auto d = GetTensorData<float>(scope->GetTensor("D"), target);
+  auto f = GetTensorData<float>(scope->GetTensor(out_f), target);
+  auto g = GetTensorData<float>(scope->GetTensor(out_g), target);
+  for (int i = 0; i < 32 * 32; ++i) {
+    ASSERT_NEAR(f[i], a[i] + b[i] + c[i], 1e-5);
+    ASSERT_NEAR(g[i], a[i] + b[i] + d[i], 1e-5);
+  }
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
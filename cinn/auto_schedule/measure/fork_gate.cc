@@ -0,0 +1,59 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/measure/fork_gate.h"
+
+#include <unistd.h>
+
+namespace cinn {
+namespace auto_schedule {
+
+ForkGate* ForkGate::Global() {
+  static ForkGate gate;
+  return &gate;
+}
+
+void ForkGate::Enter() {
+  std::unique_lock<std::mutex> lock(mtx_);
+  cv_.wait(lock, [this]() { return !fork_pending_; });
+  ++num_sections_;
+}
+
+void ForkGate::Leave() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (--num_sections_ == 0) {
+    cv_.notify_all();
+  }
+}
+
+pid_t ForkGate::Fork() {
+  std::unique_lock<std::mutex> lock(mtx_);
+  // only one fork is pending at a time
+  cv_.wait(lock, [this]() { return !fork_pending_; });
+  fork_pending_ = true;
+  cv_.wait(lock, [this]() { return num_sections_ == 0; });
+  pid_t pid = fork();
+  if (pid == 0) {
+    // the waiters of cv_ don't exist in the child, and notifying it may block forever,
+    // mtx_ is held by the forking thread, so it is released normally
+    return pid;
+  }
+  fork_pending_ = false;
+  lock.unlock();
+  cv_.notify_all();
+  return pid;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
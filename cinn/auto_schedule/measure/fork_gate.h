@@ -0,0 +1,67 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <mutex>
+
+#include "cinn/common/macros.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// The child of a multithreaded fork only has the forking thread, and a lock held by any other
+// thread at the time of fork stays locked forever in the child. ForkGate lets a thread fork the
+// process only when no other thread is inside a guarded section, such as building a candidate,
+// which takes the locks of malloc, glog and LLVM. A section entered while a fork is pending
+// waits until the fork returns, so the forking thread is never starved by continuous sections.
+class ForkGate {
+ public:
+  static ForkGate* Global();
+
+  // Enter a section during which the process is not forked
+  void Enter();
+  // Leave the section entered by Enter
+  void Leave();
+
+  // Wait for all the sections in progress to leave and fork the process, returns as fork()
+  pid_t Fork();
+
+  // Guard a section in a scope
+  class Section {
+   public:
+    explicit Section(ForkGate* gate) : gate_(gate) { gate_->Enter(); }
+    ~Section() { gate_->Leave(); }
+
+   private:
+    ForkGate* gate_;
+    CINN_DISALLOW_COPY_AND_ASSIGN(Section);
+  };
+
+ private:
+  ForkGate() = default;
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  int num_sections_  = 0;
+  bool fork_pending_ = false;
+
+  CINN_DISALLOW_COPY_AND_ASSIGN(ForkGate);
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
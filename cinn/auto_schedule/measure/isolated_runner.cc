@@ -0,0 +1,192 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/measure/isolated_runner.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include "cinn/auto_schedule/measure/fork_gate.h"
+#include "cinn/common/target.h"
+#include "cinn/utils/string.h"
+
+DECLARE_string(cinn_host_parallel_backend);
+
+namespace cinn {
+namespace auto_schedule {
+
+namespace {
+
+// The fixed-size part of the message sent by a worker, followed by error_msg_size bytes of the error message
+struct WorkerMessage {
+  // whether the runner threw an exception, whose message is sent as the error message
+  bool thrown;
+  double execution_cost;
+  double execution_cost_variance;
+  int repeat_times;
+  bool early_stopped;
+  double elapsed_time;
+  size_t error_msg_size;
+};
+
+bool WriteAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+}  // namespace
+
+IsolatedRunner::IsolatedRunner(std::unique_ptr<ScheduleRunner> runner, int timeout_ms)
+    : runner_(std::move(runner)), timeout_ms_(timeout_ms) {
+  CHECK(runner_ != nullptr) << "runner can't be nullptr";
+  CHECK_GT(timeout_ms_, 0) << "timeout_ms should be greater than 0";
+}
+
+void IsolatedRunner::RunInWorker(const MeasureInput& input, const BuildResult& build_result, int write_fd) {
+  // the thread team of OpenMP in the parent doesn't exist in the worker and a parallel region
+  // would wait for it forever, while the thread pool starts a new one in the forked process
+  FLAGS_cinn_host_parallel_backend = "thread_pool";
+  WorkerMessage message;
+  std::memset(&message, 0, sizeof(message));
+  std::string error_msg;
+  try {
+    // the thread pool and the pages of the program are created at the first launch in the worker,
+    // which would be counted as the cost of the candidate
+    runner_->Warmup(input, build_result);
+    MeasureResult result            = runner_->Run(input, build_result);
+    message.execution_cost          = result.execution_cost;
+    message.execution_cost_variance = result.execution_cost_variance;
+    message.repeat_times            = result.repeat_times;
+    message.early_stopped           = result.early_stopped;
+    message.elapsed_time            = result.elapsed_time;
+    error_msg                       = result.error_msg;
+  } catch (std::exception& e) {
+    message.thrown = true;
+    error_msg      = e.what();
+  }
+  message.error_msg_size = error_msg.size();
+  bool sent = WriteAll(write_fd, reinterpret_cast<const char*>(&message), sizeof(message)) &&
+              WriteAll(write_fd, error_msg.data(), error_msg.size());
+  close(write_fd);
+  // exit without the destructors and atexit handlers, which belong to the parent
+  _exit(sent ? 0 : 1);
+}
+
+MeasureResult IsolatedRunner::Run(const MeasureInput& input, const BuildResult& build_result) {
+  if (input.task->target.arch == common::Target::Arch::NVGPU) {
+    LOG_FIRST_N(WARNING, 1) << "IsolatedRunner runs the candidates of NVGPU target in the current process";
+    return runner_->Run(input, build_result);
+  }
+
+  int fds[2];
+  CHECK_EQ(pipe(fds), 0) << "Failed to create pipe, error: " << std::strerror(errno);
+  // fork only when no candidate is being built, the locks taken by the builders would stay held in the worker
+  pid_t pid = ForkGate::Global()->Fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    throw std::runtime_error(utils::StringFormat("Failed to fork the worker, error: %s", std::strerror(errno)));
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    RunInWorker(input, build_result, fds[1]);
+  }
+  close(fds[1]);
+
+  // read the message until the worker closes the pipe or the time is out
+  std::string data;
+  bool timeout  = false;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms_);
+  char buffer[4096];
+  while (true) {
+    auto remaining =
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    pollfd poll_fd = {fds[0], POLLIN, 0};
+    int ready      = poll(&poll_fd, 1, std::max<int64_t>(remaining, 0));
+    if (ready == 0) {
+      timeout = true;
+      break;
+    }
+    ssize_t size = ready < 0 ? -1 : read(fds[0], buffer, sizeof(buffer));
+    if (size < 0 && errno == EINTR) {
+      continue;
+    }
+    if (size <= 0) {
+      break;
+    }
+    data.append(buffer, size);
+  }
+  close(fds[0]);
+
+  if (timeout) {
+    kill(pid, SIGKILL);
+  }
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+  }
+
+  if (timeout) {
+    ++num_timeouts_;
+    throw std::runtime_error(utils::StringFormat("The worker was killed after timeout of %d ms", timeout_ms_));
+  }
+  WorkerMessage message;
+  if (data.size() < sizeof(message)) {
+    ++num_crashes_;
+    if (WIFSIGNALED(status)) {
+      throw std::runtime_error(utils::StringFormat(
+          "The worker crashed by signal %d(%s)", WTERMSIG(status), strsignal(WTERMSIG(status))));
+    }
+    throw std::runtime_error(
+        utils::StringFormat("The worker exited with status %d without result", WEXITSTATUS(status)));
+  }
+  std::memcpy(&message, data.data(), sizeof(message));
+  CHECK_EQ(data.size(), sizeof(message) + message.error_msg_size) << "Broken message from the worker";
+  std::string error_msg = data.substr(sizeof(message));
+  if (message.thrown) {
+    throw std::runtime_error(error_msg);
+  }
+
+  MeasureResult result;
+  result.execution_cost          = message.execution_cost;
+  result.execution_cost_variance = message.execution_cost_variance;
+  result.repeat_times            = message.repeat_times;
+  result.early_stopped           = message.early_stopped;
+  result.elapsed_time            = message.elapsed_time;
+  result.error_msg               = std::move(error_msg);
+  return result;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
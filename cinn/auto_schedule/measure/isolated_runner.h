@@ -0,0 +1,63 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "cinn/auto_schedule/measure/measure.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// This class runs each candidate with another runner in a forked worker process,
+// so a candidate crashing or hanging only kills its worker instead of the tuning job.
+//
+// The worker inherits the built program from the copy-on-write memory of the parent,
+// sends the result back over a pipe and exits, so a new worker is forked for every
+// candidate and none of them is reused after a failure. A worker exceeding the timeout
+// is killed. The failures are thrown as exceptions, which ScheduleMeasurer reports as
+// the error messages of the candidates.
+//
+// A worker is forked only when no candidate is being built, see ForkGate, and the parallel
+// loops of host kernels run on a new thread pool in it instead of the OpenMP team of the parent.
+// The candidates of NVGPU target are run in the current process, since the CUDA
+// context of the parent can't be used in a forked process.
+class IsolatedRunner : public ScheduleRunner {
+ public:
+  /**
+   * Constructor.
+   * @param runner The runner to run a candidate in the worker process.
+   * @param timeout_ms The time limit of running a candidate, unit: ms.
+   */
+  IsolatedRunner(std::unique_ptr<ScheduleRunner> runner, int timeout_ms);
+
+  MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) override;
+
+  // The number of workers crashed or killed by timeout so far
+  int num_crashes() const { return num_crashes_; }
+  int num_timeouts() const { return num_timeouts_; }
+
+ private:
+  // Run the candidate and write the result to the pipe, called in the worker process
+  void RunInWorker(const MeasureInput& input, const BuildResult& build_result, int write_fd);
+
+  std::unique_ptr<ScheduleRunner> runner_;
+  const int timeout_ms_;
+  int num_crashes_  = 0;
+  int num_timeouts_ = 0;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
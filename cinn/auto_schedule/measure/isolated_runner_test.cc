@@ -0,0 +1,201 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/measure/isolated_runner.h"
+
+#include <gtest/gtest.h>
+#include <signal.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cinn/auto_schedule/measure/schedule_measurer.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/thread_pool.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+class DummyBuilder : public ScheduleBuilder {
+ public:
+  BuildResult Build(const MeasureInput& input) override { return BuildResult(); }
+};
+
+std::mutex& BuilderMutex() {
+  static std::mutex mtx;
+  return mtx;
+}
+
+// A builder holding a lock for most of its time, as a real one takes the locks of malloc, glog and LLVM.
+// A worker forked while it is building would inherit the lock held and never acquire it.
+class LockingBuilder : public ScheduleBuilder {
+ public:
+  BuildResult Build(const MeasureInput& input) override {
+    std::lock_guard<std::mutex> lock(BuilderMutex());
+    std::vector<std::unique_ptr<char[]>> blocks;
+    for (int i = 0; i < 256; ++i) {
+      blocks.emplace_back(new char[1024 + i]);
+    }
+    VLOG(6) << "Building with " << blocks.size() << " blocks";
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return BuildResult();
+  }
+};
+
+int SumTasks(int task_id, int num_task, void* datas) {
+  static_cast<std::atomic<int>*>(datas)->fetch_add(task_id);
+  return 0;
+}
+
+// Take the locks a builder may hold and run the host thread pool, as a candidate does in the worker
+void TakeBuilderLocks() {
+  std::lock_guard<std::mutex> lock(BuilderMutex());
+  std::vector<std::unique_ptr<char[]>> blocks;
+  for (int i = 0; i < 256; ++i) {
+    blocks.emplace_back(new char[1024 + i]);
+  }
+  LOG(INFO) << "Running in the worker with " << blocks.size() << " blocks";
+  std::atomic<int> sum{0};
+  runtime::cpu::ThreadPool::Global()->Launch(SumTasks, &sum, 64);
+  CHECK_EQ(sum.load(), 64 * 63 / 2);
+}
+
+// A runner behaving as the best execution cost of the input tells
+class ScriptedRunner : public ScheduleRunner {
+ public:
+  enum Behavior : int { kSucceed = 0, kThrow = 1, kCrash = 2, kHang = 3, kExit = 4, kTakeBuilderLocks = 5 };
+
+  MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) override {
+    ++num_runs;
+    switch (static_cast<int>(input.best_execution_cost)) {
+      case kThrow:
+        throw std::runtime_error("RunError");
+      case kCrash:
+        raise(SIGSEGV);
+        break;
+      case kHang:
+        std::this_thread::sleep_for(std::chrono::seconds(60));
+        break;
+      case kExit:
+        _exit(3);
+      case kTakeBuilderLocks:
+        TakeBuilderLocks();
+        break;
+    }
+    MeasureResult result;
+    result.execution_cost = 42.0;
+    result.repeat_times   = 7;
+    result.early_stopped  = true;
+    // tell whether the worker warmed the candidate up before running it
+    result.error_msg = warmed_up ? "warm" : "cold";
+    return result;
+  }
+
+  void Warmup(const MeasureInput& input, const BuildResult& build_result) override { warmed_up = true; }
+
+  // the runs in the workers are not counted in the parent
+  int num_runs   = 0;
+  bool warmed_up = false;
+};
+
+class TestIsolatedRunner : public ::testing::Test {
+ public:
+  void SetUp() override {
+    task.target = common::DefaultHostTarget();
+    auto runner = std::make_unique<ScriptedRunner>();
+    scripted    = runner.get();
+    isolated    = std::make_unique<IsolatedRunner>(std::move(runner), 500);
+  }
+
+  MeasureInput MakeInput(ScriptedRunner::Behavior behavior) {
+    MeasureInput input;
+    input.task                = &task;
+    input.best_execution_cost = behavior;
+    return input;
+  }
+
+  TuneTask task;
+  ScriptedRunner* scripted;
+  std::unique_ptr<IsolatedRunner> isolated;
+};
+
+TEST_F(TestIsolatedRunner, Succeed) {
+  MeasureResult result = isolated->Run(MakeInput(ScriptedRunner::kSucceed), BuildResult());
+  EXPECT_EQ(result.execution_cost, 42.0);
+  EXPECT_EQ(result.repeat_times, 7);
+  EXPECT_TRUE(result.early_stopped);
+  EXPECT_EQ(result.error_msg, "warm");
+  EXPECT_EQ(scripted->num_runs, 0);
+  EXPECT_FALSE(scripted->warmed_up);
+}
+
+TEST_F(TestIsolatedRunner, Failures) {
+  try {
+    isolated->Run(MakeInput(ScriptedRunner::kThrow), BuildResult());
+    FAIL() << "an exception is expected";
+  } catch (std::exception& e) {
+    EXPECT_EQ(std::string(e.what()), "RunError");
+  }
+  EXPECT_THROW(isolated->Run(MakeInput(ScriptedRunner::kCrash), BuildResult()), std::runtime_error);
+  EXPECT_THROW(isolated->Run(MakeInput(ScriptedRunner::kExit), BuildResult()), std::runtime_error);
+  EXPECT_EQ(isolated->num_crashes(), 2);
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_THROW(isolated->Run(MakeInput(ScriptedRunner::kHang), BuildResult()), std::runtime_error);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10));
+  EXPECT_EQ(isolated->num_timeouts(), 1);
+
+  // a new worker runs the next candidate
+  EXPECT_EQ(isolated->Run(MakeInput(ScriptedRunner::kSucceed), BuildResult()).execution_cost, 42.0);
+}
+
+TEST_F(TestIsolatedRunner, MeasureWithConcurrentBuilders) {
+  // warm up the thread pool of the parent, whose workers don't exist in the workers
+  std::atomic<int> sum{0};
+  runtime::cpu::ThreadPool::Global()->Launch(SumTasks, &sum, 64);
+
+  LockingBuilder builder;
+  IsolatedRunner runner(std::make_unique<ScriptedRunner>(), 5000);
+  ScheduleMeasurer measurer(&builder, &runner, 4);
+  std::vector<MeasureInput> inputs(32, MakeInput(ScriptedRunner::kTakeBuilderLocks));
+  std::vector<MeasureResult> results = measurer.Measure(inputs);
+  ASSERT_EQ(results.size(), inputs.size());
+  for (const auto& result : results) {
+    EXPECT_EQ(result.execution_cost, 42.0) << result.error_msg;
+  }
+  EXPECT_EQ(runner.num_timeouts(), 0);
+  EXPECT_EQ(runner.num_crashes(), 0);
+  EXPECT_EQ(measurer.pipeline_stats().num_built, inputs.size());
+}
+
+TEST_F(TestIsolatedRunner, Measure) {
+  DummyBuilder builder;
+  ScheduleMeasurer measurer(&builder, isolated.get());
+  std::vector<MeasureInput> inputs = {
+      MakeInput(ScriptedRunner::kCrash), MakeInput(ScriptedRunner::kSucceed), MakeInput(ScriptedRunner::kHang)};
+  std::vector<MeasureResult> results = measurer.Measure(inputs);
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_NE(results[0].error_msg.find("crashed by signal"), std::string::npos);
+  EXPECT_EQ(results[1].execution_cost, 42.0);
+  EXPECT_NE(results[2].error_msg.find("timeout"), std::string::npos);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -36,6 +37,9 @@ struct MeasureInput {
   // It is used to pass for some arguments that maybe
   // specified value in advance. default is null
   const std::map<std::string, cinn_pod_value_t>* execution_args = nullptr;
+  // The execution cost of the best candidate measured before, a runner
+  // can stop measuring once this candidate is surely slower than it.
+  double best_execution_cost = std::numeric_limits<double>::max();  // unit: us
 };
 
 // The result of a measurement
@@ -43,6 +47,14 @@ struct MeasureResult {
   // The time cost of execution in average of running
   // with a specific repeated times.
   double execution_cost = 0.0;  // unit: us
+  // The variance of the execution cost among the repeated runs,
+  // 0 if the runner doesn't time each run separately
+  double execution_cost_variance = 0.0;  // unit: us^2
+  // The number of timed runs, exclusive of the warmup runs
+  int repeat_times = 0;
+  // Whether the measurement stopped early because this candidate
+  // is surely slower than MeasureInput::best_execution_cost
+  bool early_stopped = false;
   // The time cost of the whole measurement process including
   // building and running
   double elapsed_time = 0.0;  // unit: us
@@ -66,6 +78,10 @@ struct BuildResult {
 class ScheduleBuilder {
  public:
   virtual BuildResult Build(const MeasureInput& input) = 0;
+
+  // Whether Build can be called by multiple threads at the same time and a build
+  // result stays valid while the later inputs are being built
+  virtual bool IsThreadSafe() const { return true; }
 };
 
 // This interface defines how to run the built result. Like above ScheduleBuilder,
@@ -73,6 +89,10 @@ class ScheduleBuilder {
 class ScheduleRunner {
  public:
   virtual MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) = 0;
+
+  // Run the built result once without timing, so the resources created lazily
+  // at the first launch in a process aren't counted by the following Run
+  virtual void Warmup(const MeasureInput& input, const BuildResult& build_result) {}
 };
 
 }  // namespace auto_schedule
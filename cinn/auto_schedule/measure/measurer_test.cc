@@ -14,7 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
 #include "cinn/auto_schedule/measure/simple_builder.h"
@@ -116,12 +119,78 @@ TEST_F(TestMeasurer, CatchException) {
   ASSERT_EQ(inputs.size(), results.size());
   EXPECT_EQ(results[0].error_msg, "Build failed, error: BuildError\n");
 
-  // TODO(CtfGo): test parallel build after we support thread-safe compilation
   auto measurer_with_run_error = std::make_unique<ScheduleMeasurer>(builder.get(), throw_runner.get(), 1);
   results                      = measurer_with_run_error->Measure(inputs);
   ASSERT_EQ(inputs.size(), results.size());
   EXPECT_EQ(results[0].error_msg, "Run failed, error: RunError\n");
 }
 
+TEST_F(TestMeasurer, SequentialWithThreadUnsafeBuilder) {
+  // the kernels of a candidate built by SimpleBuilder are released by building the next one
+  auto builder  = std::make_unique<SimpleBuilder>(graph_compiler.get());
+  auto runner   = std::make_unique<SimpleRunner>(1);
+  auto measurer = std::make_unique<ScheduleMeasurer>(builder.get(), runner.get(), 4);
+  ASSERT_EQ(measurer->num_threads(), 1);
+  std::vector<MeasureResult> results = measurer->Measure(inputs);
+  ASSERT_EQ(inputs.size(), results.size());
+  for (const auto& result : results) {
+    EXPECT_TRUE(result.error_msg.empty()) << result.error_msg;
+  }
+  ASSERT_EQ(measurer->pipeline_stats().num_built, 0);
+}
+
+class SleepBuilder : public ScheduleBuilder {
+ public:
+  BuildResult Build(const MeasureInput& input) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(4));
+    return BuildResult();
+  }
+};
+
+// record the maximum number of concurrent runs
+class SleepRunner : public ScheduleRunner {
+ public:
+  MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) override {
+    int running = ++num_running;
+    max_running = std::max(max_running.load(), running);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    --num_running;
+    MeasureResult result;
+    result.execution_cost = 1.0;
+    return result;
+  }
+
+  std::atomic<int> num_running{0};
+  std::atomic<int> max_running{0};
+};
+
+TEST(ScheduleMeasurer, Pipeline) {
+  SleepBuilder builder;
+  SleepRunner runner;
+  std::vector<MeasureInput> inputs(64);
+  ScheduleMeasurer measurer(&builder, &runner, 4, 3);
+  ASSERT_EQ(measurer.num_threads(), 4);
+  auto results = measurer.Measure(inputs);
+  ASSERT_EQ(results.size(), inputs.size());
+  for (const auto& result : results) {
+    ASSERT_TRUE(result.error_msg.empty());
+    ASSERT_EQ(result.execution_cost, 1.0);
+    ASSERT_GT(result.elapsed_time, 0.0);
+  }
+  // runs are serialized on the single runner
+  ASSERT_EQ(runner.max_running, 1);
+
+  const auto& stats = measurer.pipeline_stats();
+  ASSERT_EQ(stats.num_built, inputs.size());
+  ASSERT_EQ(stats.num_run, inputs.size());
+  ASSERT_LE(stats.max_queue_depth, 3);
+  ASSERT_EQ(measurer.queue_depth(), 0);
+  ASSERT_GT(stats.BuilderUtilization(), 0.0);
+  ASSERT_GT(stats.RunnerUtilization(), 0.0);
+  LOG(INFO) << "average queue depth: " << stats.AverageQueueDepth()
+            << ", builder utilization: " << stats.BuilderUtilization()
+            << ", runner utilization: " << stats.RunnerUtilization();
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
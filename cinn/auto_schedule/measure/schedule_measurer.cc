@@ -14,15 +14,86 @@
 
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
 
+#include <gflags/gflags.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
+#include <mutex>
+#include <thread>
+
+#include "cinn/auto_schedule/measure/fork_gate.h"
+#include "cinn/utils/string.h"
 
-#include "cinn/utils/multi_threading.h"
+DECLARE_int32(auto_schedule_measure_runner_cpus);
 
 namespace cinn {
 namespace auto_schedule {
 
-ScheduleMeasurer::ScheduleMeasurer(ScheduleBuilder* builder, ScheduleRunner* runner, int num_threads)
-    : builder_(builder), runner_(runner), num_threads_(num_threads) {}
+namespace {
+// Split the cpus available to the process into the last `num_runner_cpus` ones for the runner and
+// the others for the builders, nothing is split if there are not enough cpus
+void SplitCpus(int num_runner_cpus, std::vector<int>* runner_cpus, std::vector<int>* builder_cpus) {
+#if defined(__linux__)
+  if (num_runner_cpus <= 0) return;
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      cpus.push_back(cpu);
+    }
+  }
+  if (cpus.size() <= num_runner_cpus) {
+    LOG(WARNING) << "Only " << cpus.size() << " cpus available, can't dedicate " << num_runner_cpus
+                 << " cpus to the runner";
+    return;
+  }
+  builder_cpus->assign(cpus.begin(), cpus.end() - num_runner_cpus);
+  runner_cpus->assign(cpus.end() - num_runner_cpus, cpus.end());
+#endif
+}
+
+void PinCurrentThread(const std::vector<int>& cpus) {
+#if defined(__linux__)
+  if (cpus.empty()) return;
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &cpuset);
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+    LOG(WARNING) << "Failed to set the cpu affinity of the measurement thread";
+  }
+#endif
+}
+
+double ElapsedMicroseconds(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+ScheduleMeasurer::ScheduleMeasurer(ScheduleBuilder* builder,
+                                   ScheduleRunner* runner,
+                                   int num_threads,
+                                   int queue_capacity)
+    : builder_(builder),
+      runner_(runner),
+      num_threads_(builder->IsThreadSafe() ? num_threads : 1),
+      queue_capacity_(queue_capacity > 0 ? queue_capacity : 2 * std::max(num_threads_, 1)) {
+  if (num_threads_ < num_threads) {
+    LOG(WARNING) << "The builder is not thread-safe, the candidates are built and run sequentially instead of on "
+                 << num_threads << " threads";
+  }
+}
 
 std::vector<MeasureResult> ScheduleMeasurer::Measure(const std::vector<MeasureInput>& inputs) {
   if (inputs.empty()) {
@@ -37,6 +108,8 @@ std::vector<MeasureResult> ScheduleMeasurer::Measure(const std::vector<MeasureIn
     VLOG(6) << "Build candidate index: " << index;
     auto m_start = std::chrono::steady_clock::now();
     try {
+      // a worker of IsolatedRunner is not forked while building, which takes the locks of malloc, glog and LLVM
+      ForkGate::Section section(ForkGate::Global());
       build_results[index] = builder->Build(inputs[index]);
     } catch (std::exception& e) {
       results[index].error_msg = utils::StringFormat("Build failed, error: %s\n", e.what());
@@ -48,7 +121,8 @@ std::vector<MeasureResult> ScheduleMeasurer::Measure(const std::vector<MeasureIn
   // define how to run a candidate with the specified index
   auto run_fn = [runner = runner_, &inputs, &build_results, &results](int index) {
     VLOG(6) << "Run candidate index: " << index;
-    auto m_start = std::chrono::steady_clock::now();
+    auto m_start      = std::chrono::steady_clock::now();
+    double build_time = results[index].elapsed_time;
     try {
       // if error occurred in building, then skip running
       if (results[index].error_msg.empty()) {
@@ -58,20 +132,99 @@ std::vector<MeasureResult> ScheduleMeasurer::Measure(const std::vector<MeasureIn
       results[index].error_msg = utils::StringFormat("Run failed, error: %s\n", e.what());
     }
     auto time_span = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start);
-    results[index].elapsed_time += static_cast<double>(time_span.count());
+    results[index].elapsed_time = build_time + static_cast<double>(time_span.count());
   };
 
-  // measure a candidate by calling build and run successively
-  auto measure_fn = [&build_fn, &run_fn](int index) {
-    build_fn(index);
-    run_fn(index);
-  };
-  // default num_threads_ is 1 and in that case it will perform all measurements sequentially inplace.
-  utils::parallel_run(measure_fn, utils::SequenceDispatcher(0, inputs.size()), num_threads_);
+  if (num_threads_ > 1) {
+    MeasureInPipeline(inputs.size(), build_fn, run_fn);
+  } else {
+    // measure candidates by calling build and run successively
+    for (int index = 0; index < inputs.size(); ++index) {
+      build_fn(index);
+      run_fn(index);
+    }
+  }
 
   VLOG(4) << "Measure " << inputs.size() << " candidates";
   return results;
 }
 
+void ScheduleMeasurer::MeasureInPipeline(int num_inputs,
+                                         const std::function<void(int)>& build_fn,
+                                         const std::function<void(int)>& run_fn) {
+  std::vector<int> runner_cpus, builder_cpus;
+  SplitCpus(FLAGS_auto_schedule_measure_runner_cpus, &runner_cpus, &builder_cpus);
+  int num_builders = std::min(num_threads_, num_inputs);
+
+  std::mutex mtx;
+  std::condition_variable not_full, not_empty;
+  std::deque<int> queue;
+  int num_finished_builders = 0;
+  std::atomic<int> next_index{0};
+  auto pipeline_start = std::chrono::steady_clock::now();
+
+  auto builder_loop = [&]() {
+    PinCurrentThread(builder_cpus);
+    for (int index = next_index++; index < num_inputs; index = next_index++) {
+      auto start = std::chrono::steady_clock::now();
+      build_fn(index);
+      double busy_time = ElapsedMicroseconds(start);
+
+      std::unique_lock<std::mutex> lock(mtx);
+      not_full.wait(lock, [&]() { return queue.size() < queue_capacity_; });
+      queue.push_back(index);
+      queue_depth_ = queue.size();
+      pipeline_stats_.num_built += 1;
+      pipeline_stats_.build_busy_time += busy_time;
+      pipeline_stats_.max_queue_depth = std::max<int>(pipeline_stats_.max_queue_depth, queue.size());
+      not_empty.notify_one();
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    ++num_finished_builders;
+    not_empty.notify_one();
+  };
+
+  auto runner_loop = [&]() {
+    PinCurrentThread(runner_cpus);
+    while (true) {
+      int index = -1;
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        not_empty.wait(lock, [&]() { return !queue.empty() || num_finished_builders == num_builders; });
+        if (queue.empty()) break;
+        pipeline_stats_.sum_queue_depth += queue.size();
+        index = queue.front();
+        queue.pop_front();
+        queue_depth_ = queue.size();
+        not_full.notify_one();
+      }
+      auto start = std::chrono::steady_clock::now();
+      run_fn(index);
+      double busy_time = ElapsedMicroseconds(start);
+
+      std::lock_guard<std::mutex> lock(mtx);
+      pipeline_stats_.num_run += 1;
+      pipeline_stats_.run_busy_time += busy_time;
+    }
+  };
+
+  std::vector<std::thread> builders;
+  for (int i = 0; i < num_builders; ++i) {
+    builders.emplace_back(builder_loop);
+  }
+  std::thread runner(runner_loop);
+  for (auto& builder : builders) {
+    builder.join();
+  }
+  runner.join();
+
+  pipeline_stats_.num_builders = num_builders;
+  pipeline_stats_.wall_time += ElapsedMicroseconds(pipeline_start);
+  VLOG(4) << "Measure pipeline with " << num_builders << " builders: average queue depth "
+          << pipeline_stats_.AverageQueueDepth() << ", max queue depth " << pipeline_stats_.max_queue_depth
+          << ", builder utilization " << pipeline_stats_.BuilderUtilization() << ", runner utilization "
+          << pipeline_stats_.RunnerUtilization();
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 #include "cinn/auto_schedule/measure/measure.h"
@@ -23,14 +26,67 @@ namespace auto_schedule {
 
 // Entrance of schedule measurement, it mainly includes two processes:
 // which are building the input schedules and running the generated codes.
+//
+// If more than one thread is specified, the measurement works as a two-stage pipeline:
+// `num_threads` builder threads build the candidates in parallel and feed a bounded queue,
+// and a single runner thread drains the queue, so the timing runs never overlap each other.
+// The runner can be pinned to dedicated cpus by FLAGS_auto_schedule_measure_runner_cpus
+// to isolate it from the compilation. The pipeline is only used with a builder telling
+// it is thread-safe by ScheduleBuilder::IsThreadSafe, otherwise the candidates are built
+// and run sequentially whatever `num_threads` is, which is the case of SimpleBuilder.
 class ScheduleMeasurer {
  public:
-  ScheduleMeasurer(ScheduleBuilder* builder, ScheduleRunner* runner, int num_threads = 1);
+  // Counters of the pipeline accumulated over all the measurements
+  struct PipelineStats {
+    int64_t num_built = 0;
+    int64_t num_run   = 0;
+    // the maximum number of built candidates waiting in the queue
+    int max_queue_depth = 0;
+    // the sum of queue depth sampled on each pop by the runner
+    int64_t sum_queue_depth = 0;
+    // the time cost of each stage summed over its threads, unit: us
+    double build_busy_time = 0.0;
+    double run_busy_time   = 0.0;
+    // the time cost of the whole pipeline, unit: us
+    double wall_time = 0.0;
+    int num_builders = 0;
+
+    double AverageQueueDepth() const { return num_run > 0 ? static_cast<double>(sum_queue_depth) / num_run : 0.0; }
+    // the ratio of the time the builder threads are busy
+    double BuilderUtilization() const {
+      return wall_time > 0 && num_builders > 0 ? build_busy_time / (wall_time * num_builders) : 0.0;
+    }
+    // the ratio of the time the runner thread is busy
+    double RunnerUtilization() const { return wall_time > 0 ? run_busy_time / wall_time : 0.0; }
+  };
+
+  /**
+   * Constructor.
+   * @param builder The builder to build the candidates.
+   * @param runner The runner to run the built candidates.
+   * @param num_threads The number of builder threads, candidates are built and run sequentially if it is 1
+   *                    or the builder is not thread-safe.
+   * @param queue_capacity The maximum number of built candidates waiting for running, 0 means twice of num_threads.
+   */
+  ScheduleMeasurer(ScheduleBuilder* builder, ScheduleRunner* runner, int num_threads = 1, int queue_capacity = 0);
 
   // Measure a batch of inputs and return all results once.
   std::vector<MeasureResult> Measure(const std::vector<MeasureInput>& inputs);
 
+  // The number of built candidates waiting in the queue currently
+  int queue_depth() const { return queue_depth_.load(); }
+
+  const PipelineStats& pipeline_stats() const { return pipeline_stats_; }
+
+  // The number of builder threads actually used
+  int num_threads() const { return num_threads_; }
+
  private:
+  // Build candidates on `num_threads_` builder threads and run them on a single runner thread
+  void MeasureInPipeline(int num_inputs,
+                         const std::function<void(int)>& build_fn,
+                         const std::function<void(int)>& run_fn);
+
   // The handle to implemented ScheduleBuilder
   ScheduleBuilder* builder_;
   // The handle to implemented ScheduleRunner
@@ -38,6 +94,11 @@ class ScheduleMeasurer {
   // The number of threads used to perform measurement,
   // if it is greater than 1 that means parallel measurement.
   const int num_threads_;
+  // The capacity of the queue between builders and the runner
+  const int queue_capacity_;
+
+  std::atomic<int> queue_depth_{0};
+  PipelineStats pipeline_stats_;
 };
 
 }  // namespace auto_schedule
@@ -29,6 +29,10 @@ class SimpleBuilder : public ScheduleBuilder {
   // Build and pack the result
   BuildResult Build(const MeasureInput& input) override;
 
+  // The GraphCompiler is stateful, and a build replaces the compiled module holding
+  // the kernels of the previous build, so the inputs must be built and run one by one
+  bool IsThreadSafe() const override { return false; }
+
  private:
   hlir::framework::GraphCompiler* graph_compiler_;
 };
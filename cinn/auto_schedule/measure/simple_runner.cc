@@ -16,9 +16,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <random>
 
 #include "cinn/common/target.h"
@@ -46,7 +48,7 @@ static const std::unordered_map<std::string, std::vector<int>> kInitWithZeroPara
 };
 
 // Generate random value and populate them to the output address of memory
-static void PopulateRandomValue(const common::Type& type, const int numel, void* raw_ptr) {
+static void PopulateRandomValue(const common::Type& type, const size_t numel, void* raw_ptr) {
   std::random_device seed;
   std::default_random_engine engine(seed());
 
@@ -78,7 +80,7 @@ static void PopulateRandomValue(const common::Type& type, const int numel, void*
 
 // Initialize a tensor with 0 if init_with_zero == true, otherwise initialize the tensor with random value.
 static void InitTensorData(Tensor tensor, const common::Target& target, bool init_with_zero) {
-  int mem_size      = tensor->shape().numel() * tensor->type().bytes();
+  size_t mem_size   = tensor->shape().numel() * tensor->type().bytes();
   auto* tensor_data = tensor->mutable_data(target, tensor->type());
 #ifdef CINN_WITH_CUDA
   if (target == common::DefaultNVGPUTarget()) {
@@ -123,10 +125,32 @@ static std::unordered_set<std::string> ParamsNeedInitWithZero(const MeasureInput
   return res;
 }
 
-SimpleRunner::SimpleRunner(int repeat_times) : repeat_times_(repeat_times) {
+SimpleRunner::SimpleRunner(int repeat_times) : repeat_times_(repeat_times), adaptive_(false) {
   CHECK_GT(repeat_times_, 0) << "repeat_times can't less than 0";
 }
 
+SimpleRunner::SimpleRunner(const AdaptiveConfig& config) : repeat_times_(0), adaptive_(true), adaptive_config_(config) {
+  CHECK_GE(config.warmup_times, 0) << "warmup_times can't less than 0";
+  CHECK_GT(config.min_repeat_times, 0) << "min_repeat_times should be greater than 0";
+  CHECK_GE(config.max_repeat_times, config.min_repeat_times) << "max_repeat_times can't less than min_repeat_times";
+}
+
+MedianInterval EstimateMedianInterval(std::vector<double> samples) {
+  CHECK(!samples.empty()) << "No sample to estimate the median";
+  std::sort(samples.begin(), samples.end());
+  int n = samples.size();
+  MedianInterval interval;
+  interval.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+  // the ranks (1-based) of the bounds are n/2 -+ 1.96*sqrt(n)/2 rounded to the nearest, by the normal
+  // approximation of the binomial distribution of the number of samples less than the median
+  double half_width = 1.96 * std::sqrt(n) / 2;
+  int lower_rank    = std::max<int>(1, std::lround(n / 2.0 - half_width));
+  int upper_rank    = std::min<int>(n, std::lround(1 + n / 2.0 + half_width));
+  interval.lower    = samples[lower_rank - 1];
+  interval.upper    = samples[upper_rank - 1];
+  return interval;
+}
+
 // Prepare execution arguments of all instructions to run, a argument
 // may be obtained from the input of measurement or allocating new buffer
 // with random value.
@@ -196,15 +220,47 @@ MeasureResult SimpleRunner::Run(const MeasureInput& input, const BuildResult& bu
   hlir::framework::Scope temp_scope;  // used for store temporary allocated data
   auto execution_args = PrepareArgs(input, build_result, &temp_scope);
 
+  if (adaptive_) {
+    RunAdaptively(input, build_result, &execution_args, &result);
+  } else {
+    RunFixedTimes(build_result, &execution_args, &result);
+  }
+
+  auto time_span = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start);
+  result.elapsed_time = static_cast<double>(time_span.count());
+
+  VLOG(4) << "A measurement done:repeat_times[" << result.repeat_times << "]total_elapsed_time["
+          << result.elapsed_time << "]us,execution_cost[" << result.execution_cost << "]us,variance["
+          << result.execution_cost_variance << "],early_stopped[" << result.early_stopped << "]";
+  return result;
+}
+
+void SimpleRunner::Warmup(const MeasureInput& input, const BuildResult& build_result) {
+  hlir::framework::Scope temp_scope;
+  auto execution_args = PrepareArgs(input, build_result, &temp_scope);
+  for (auto&& instr : build_result.runtime_program->GetRunInstructions()) {
+    instr->Run(&execution_args);
+  }
+#ifdef CINN_WITH_CUDA
+  if (input.task->target == common::DefaultNVGPUTarget()) {
+    CUDA_CALL(cudaDeviceSynchronize());
+  }
+#endif
+}
+
+void SimpleRunner::RunFixedTimes(const BuildResult& build_result,
+                                 std::map<std::string, cinn_pod_value_t>* execution_args,
+                                 MeasureResult* result) {
   // Execute each instruction repeatedly and take the average as cost.
-  result.execution_cost    = 0;
+  result->execution_cost   = 0;
+  result->repeat_times     = repeat_times_;
   const auto& instructions = build_result.runtime_program->GetRunInstructions();
   for (auto ct = 0; ct < instructions.size(); ++ct) {
     auto&& instr = instructions.at(ct);
     VLOG(5) << "Start running instruction-" << ct;
     auto run_start = std::chrono::steady_clock::now();
     for (int i = 0; i < repeat_times_; ++i) {
-      instr->Run(&execution_args);
+      instr->Run(execution_args);
     }
 #ifdef CINN_WITH_CUDA
     if (instr->target_ == common::DefaultNVGPUTarget()) {
@@ -214,15 +270,78 @@ MeasureResult SimpleRunner::Run(const MeasureInput& input, const BuildResult& bu
     auto time_span =
         std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - run_start);
     auto cost_avg = static_cast<double>(time_span.count()) / repeat_times_;
-    result.execution_cost += cost_avg;
+    result->execution_cost += cost_avg;
   }
+}
 
-  auto time_span = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start);
-  result.elapsed_time = static_cast<double>(time_span.count());
+void SimpleRunner::RunAdaptively(const MeasureInput& input,
+                                 const BuildResult& build_result,
+                                 std::map<std::string, cinn_pod_value_t>* execution_args,
+                                 MeasureResult* result) {
+  const auto& instructions = build_result.runtime_program->GetRunInstructions();
 
-  VLOG(4) << "A measurement done:repeat_times[" << repeat_times_ << "]total_elapsed_time[" << result.elapsed_time
-          << "]us,execution_cost[" << result.execution_cost << "]us";
-  return result;
+  auto elapsed_us = [](const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  };
+  // run the whole program for the given times and wait for the kernels done
+  auto run_program = [&](int times) {
+    for (int i = 0; i < times; ++i) {
+      for (auto&& instr : instructions) {
+        instr->Run(execution_args);
+      }
+    }
+#ifdef CINN_WITH_CUDA
+    if (input.task->target == common::DefaultNVGPUTarget()) {
+      CUDA_CALL(cudaDeviceSynchronize());
+    }
+#endif
+  };
+
+  // warm up, and decide how many runs a sample takes by the warmup cost
+  int runs_per_sample = 1;
+  if (adaptive_config_.warmup_times > 0) {
+    auto warmup_start = std::chrono::steady_clock::now();
+    run_program(adaptive_config_.warmup_times);
+    double warmup_cost = elapsed_us(warmup_start) / adaptive_config_.warmup_times;
+    if (warmup_cost > 0) {
+      runs_per_sample = std::max<int>(1, std::ceil(adaptive_config_.min_sample_time / warmup_cost));
+    }
+  }
+
+  std::vector<double> samples;
+  MedianInterval interval;
+  auto measure_start = std::chrono::steady_clock::now();
+  while (samples.size() < adaptive_config_.max_repeat_times) {
+    auto sample_start = std::chrono::steady_clock::now();
+    run_program(runs_per_sample);
+    samples.push_back(elapsed_us(sample_start) / runs_per_sample);
+    interval = EstimateMedianInterval(samples);
+
+    if (elapsed_us(measure_start) >= adaptive_config_.time_budget) {
+      VLOG(5) << "Stop measuring as the time budget runs out with " << samples.size() << " samples";
+      break;
+    }
+    if (samples.size() < adaptive_config_.min_repeat_times) {
+      continue;
+    }
+    if (interval.lower > input.best_execution_cost) {
+      VLOG(5) << "Stop measuring as the candidate is slower than the best " << input.best_execution_cost << "us";
+      result->early_stopped = true;
+      break;
+    }
+    if (interval.upper - interval.lower <= 2 * adaptive_config_.max_relative_error * interval.median) {
+      break;
+    }
+  }
+
+  double mean        = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+  double sum_squares = 0.0;
+  for (double sample : samples) {
+    sum_squares += (sample - mean) * (sample - mean);
+  }
+  result->execution_cost          = interval.median;
+  result->execution_cost_variance = samples.size() > 1 ? sum_squares / (samples.size() - 1) : 0.0;
+  result->repeat_times            = samples.size() * runs_per_sample;
 }
 
 }  // namespace auto_schedule
@@ -22,22 +22,70 @@ namespace auto_schedule {
 
 // This class utilize the built instructions to execute the generated
 // kernels and count the elapsed time as the measurement of performance
+//
+// It runs either a fixed number of times and returns the average time, or
+// adaptively: after the warmup runs it keeps timing the whole program until
+// the confidence interval of the median is narrow enough or the time budget
+// runs out, and returns the median time.
 class SimpleRunner : public ScheduleRunner {
  public:
-  SimpleRunner(int repeat_times);
+  // Configure how to repeat the runs adaptively
+  struct AdaptiveConfig {
+    // the number of runs before timing
+    int warmup_times = 1;
+    // the number of timed samples is limited in [min_repeat_times, max_repeat_times]
+    int min_repeat_times = 5;
+    int max_repeat_times = 100;
+    // stop once the half width of the 95% confidence interval of
+    // the median is less than this ratio of the median
+    double max_relative_error = 0.02;
+    // stop once the timed samples take more than this, unit: us
+    double time_budget = 1e6;
+    // repeat the program in a sample so that a sample lasts at least
+    // this long, to reduce the noise of timing cheap kernels, unit: us
+    double min_sample_time = 100;
+  };
+
+  explicit SimpleRunner(int repeat_times);
+
+  explicit SimpleRunner(const AdaptiveConfig& config);
 
   MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) override;
 
+  void Warmup(const MeasureInput& input, const BuildResult& build_result) override;
+
  private:
   std::map<std::string, cinn_pod_value_t> PrepareArgs(const MeasureInput& input,
                                                       const BuildResult& build_result,
                                                       hlir::framework::Scope* temp_scope);
 
+  // Run the instructions repeatedly and set the execution cost of result
+  void RunFixedTimes(const BuildResult& build_result,
+                     std::map<std::string, cinn_pod_value_t>* execution_args,
+                     MeasureResult* result);
+
+  void RunAdaptively(const MeasureInput& input,
+                     const BuildResult& build_result,
+                     std::map<std::string, cinn_pod_value_t>* execution_args,
+                     MeasureResult* result);
+
  private:
   // The repeat times of running instructions,
   // this runner will return the average time
   const int repeat_times_;
+  // Whether to repeat the runs adaptively by adaptive_config_
+  const bool adaptive_;
+  const AdaptiveConfig adaptive_config_;
+};
+
+// The median of samples and the bounds of its 95% confidence interval, which
+// are estimated by the order statistics without assuming the distribution
+struct MedianInterval {
+  double median = 0.0;
+  double lower  = 0.0;
+  double upper  = 0.0;
 };
+MedianInterval EstimateMedianInterval(std::vector<double> samples);
 
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <limits>
 #include <thread>
 
 #include "cinn/common/target.h"
@@ -107,8 +108,8 @@ TEST_F(TestSimpleRunner, MeasureWithSpecifiedArgs) {
   ASSERT_NO_THROW(runner->Run(input, build_result));
 }
 
-TEST_F(TestSimpleRunner, TimeMeasured) {
-  // set up a BuildResult object with one instruction of the `sleep` function
+// set up a BuildResult object with one instruction of the `sleep` function
+BuildResult CreateSleepBuildResult() {
   void (*sleep_fn)(void*, int32_t) = [](void*, int32_t) -> void {
     std::this_thread::sleep_for(std::chrono::microseconds(100));
   };
@@ -120,7 +121,11 @@ TEST_F(TestSimpleRunner, TimeMeasured) {
   instructions.back()->SetLoweredFunc(reinterpret_cast<void*>(sleep_fn));
   instructions.back()->Finalize();
   build_result.runtime_program.reset(new hlir::framework::Program(nullptr, std::move(instructions)));
+  return build_result;
+}
 
+TEST_F(TestSimpleRunner, TimeMeasured) {
+  BuildResult build_result = CreateSleepBuildResult();
   // to skip the condition check of params in Instruction::PreparePodArgs
   std::map<std::string, cinn_pod_value_t> preset_args;
   preset_args.emplace("empty_placeholder", cinn_pod_value_t());
@@ -135,5 +140,56 @@ TEST_F(TestSimpleRunner, TimeMeasured) {
   ASSERT_GE(measure_result.elapsed_time, 200);
 }
 
+TEST_F(TestSimpleRunner, AdaptiveRepeat) {
+  BuildResult build_result = CreateSleepBuildResult();
+  std::map<std::string, cinn_pod_value_t> preset_args;
+  preset_args.emplace("empty_placeholder", cinn_pod_value_t());
+  input.execution_args = &preset_args;
+
+  SimpleRunner::AdaptiveConfig config;
+  config.min_repeat_times   = 5;
+  config.max_repeat_times   = 50;
+  config.max_relative_error = 0.5;
+  MeasureResult measure_result = SimpleRunner(config).Run(input, build_result);
+  ASSERT_GE(measure_result.execution_cost, 100);
+  ASSERT_GE(measure_result.repeat_times, 5);
+  ASSERT_LE(measure_result.repeat_times, 50);
+  ASSERT_GE(measure_result.execution_cost_variance, 0);
+  ASSERT_FALSE(measure_result.early_stopped);
+
+  // the candidate is surely slower than the best
+  input.best_execution_cost = 10;
+  config.max_relative_error = 0;
+  measure_result            = SimpleRunner(config).Run(input, build_result);
+  ASSERT_TRUE(measure_result.early_stopped);
+  ASSERT_EQ(measure_result.repeat_times, 5);
+
+  // stop as the time budget runs out
+  input.best_execution_cost = std::numeric_limits<double>::max();
+  config.min_repeat_times   = 1000;
+  config.max_repeat_times   = 1000;
+  config.time_budget        = 2000;
+  measure_result            = SimpleRunner(config).Run(input, build_result);
+  ASSERT_FALSE(measure_result.early_stopped);
+  ASSERT_LT(measure_result.repeat_times, 1000);
+}
+
+TEST(SimpleRunner, EstimateMedianInterval) {
+  auto interval = EstimateMedianInterval({3.0});
+  ASSERT_EQ(interval.median, 3.0);
+  ASSERT_EQ(interval.lower, 3.0);
+  ASSERT_EQ(interval.upper, 3.0);
+
+  std::vector<double> samples;
+  for (int i = 100; i > 0; --i) {
+    samples.push_back(i);
+  }
+  interval = EstimateMedianInterval(samples);
+  ASSERT_EQ(interval.median, 50.5);
+  // the ranks of the bounds are 40 and 61
+  ASSERT_EQ(interval.lower, 40);
+  ASSERT_EQ(interval.upper, 61);
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
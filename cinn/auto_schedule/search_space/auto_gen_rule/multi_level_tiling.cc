@@ -141,8 +141,9 @@ void MultiLevelTiling::ApplyTiling(ir::IRSchedule* ir_schedule, ir::Expr& block_
 
     int num_split = idx->size();
     if (num_split > 1) {
-      std::vector<Expr> tile_split_factor = ir_schedule->SamplePerfectTile(Expr(ir_for), num_split, 64);
-      std::vector<Expr> splited           = ir_schedule->Split(Expr(ir_for), tile_split_factor);
+      std::vector<Expr> tile_split_factor =
+          ir_schedule->SamplePerfectTile(Expr(ir_for), num_split, config_.max_innermost_factor);
+      std::vector<Expr> splited = ir_schedule->Split(Expr(ir_for), tile_split_factor);
       VLOG(6) << "Finish Split for MultiLevelTiling on above loop";
       for (int j = 0; j < num_split; ++j) {
         tile_loops_[idx->at(j)].push_back(splited[j]);
@@ -386,6 +387,7 @@ const std::unordered_map<common::Target::Arch, MultiLevelTiling::Config> MultiLe
          /*read_cache_levels*/ std::vector<int>{4},
          /*write_cache_memory_type*/ std::string("local"),
          /*write_cache_levels*/ std::vector<int>{3},
+         /*max_innermost_factor*/ 64,
      }},
     {common::Target::Arch::X86,
      MultiLevelTiling::Config{
@@ -395,7 +397,17 @@ const std::unordered_map<common::Target::Arch, MultiLevelTiling::Config> MultiLe
          /*read_cache_levels*/ std::vector<int>{3},
          /*write_cache_memory_type*/ std::string("local"),
          /*write_cache_levels*/ std::vector<int>{2},
+         /*max_innermost_factor*/ 64,
      }}};
 
+MultiLevelTiling::Config MultiLevelTiling::DefaultConfig(const common::Target& target) {
+  Config config = kConfigs.at(target.arch);
+  if (target.arch == common::Target::Arch::X86 && target.cpu.vector_bits() > 0) {
+    // 4 vectors of float, 64 with AVX-512, 32 with AVX and 16 with SSE
+    config.max_innermost_factor = 4 * target.cpu.vector_bits() / 32;
+  }
+  return config;
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
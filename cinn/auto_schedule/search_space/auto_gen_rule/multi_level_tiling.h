@@ -51,10 +51,15 @@ class MultiLevelTiling : public AutoGenRule {
     std::string write_cache_memory_type;
     // Which tiled levels are write cache block inserted at
     std::vector<int> write_cache_levels;
+    // The max factor of the innermost tile of a split loop
+    int max_innermost_factor;
   };
 
   static const std::unordered_map<common::Target::Arch, Config> kConfigs;
 
+  // Return the config of the arch of target, on x86 the innermost tile is bounded by the vector width of its CPU
+  static Config DefaultConfig(const common::Target& target);
+
   MultiLevelTiling(const common::Target& target, const Config& config);
   ~MultiLevelTiling() = default;
 
@@ -45,7 +45,7 @@ SearchSpace::SearchSpace(const TuneTask& tune_task, utils::LinearRandomEngine::S
   // initialize a set of rules and they are commonly used by all states
   // TODO(zhhsplendid): pass correct output names to AutoInline
   // sketch_rules_.emplace_back(new AutoInline(target, tune_task_.output_names));
-  sketch_rules_.emplace_back(new MultiLevelTiling(target, MultiLevelTiling::kConfigs.at(target.arch)));
+  sketch_rules_.emplace_back(new MultiLevelTiling(target, MultiLevelTiling::DefaultConfig(target)));
   sketch_rules_.emplace_back(new AutoUnroll(target));
   sketch_rules_.emplace_back(new SkipRule(target));
 }
@@ -14,6 +14,7 @@
 
 #include "cinn/auto_schedule/search_space/search_state.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -111,6 +112,11 @@ class IrNodesStructuralHash : public DfsWithExprsFields {
 };
 
 size_t SearchStateHash::operator()(const SearchState& s) const {
+  const auto& trace = s->ir_schedule.GetTraceDesc();
+  if (!trace.Empty()) {
+    return trace.Fingerprint();
+  }
+
   size_t hash_key   = 0;
   const auto& exprs = s->ir_schedule.GetModule().GetExprs();
   for (auto&& expr : exprs) {
@@ -120,6 +126,17 @@ size_t SearchStateHash::operator()(const SearchState& s) const {
 }
 
 bool SearchStateEqual::operator()(const SearchState& lhs, const SearchState& rhs) const {
+  const auto& lhs_trace = lhs->ir_schedule.GetTraceDesc();
+  const auto& rhs_trace = rhs->ir_schedule.GetTraceDesc();
+  // compare the fingerprints of traces firstly, and the full steps if they match,
+  // since two different traces may collide in the fingerprint
+  if (!lhs_trace.Empty() && !rhs_trace.Empty()) {
+    if (lhs_trace.Fingerprint() != rhs_trace.Fingerprint()) return false;
+    if (lhs_trace.SameSteps(rhs_trace)) return true;
+    VLOG(6) << "Fingerprints of different traces collide";
+    return false;
+  }
+
   const auto& lhs_exprs = lhs->ir_schedule.GetModule().GetExprs();
   const auto& rhs_exprs = rhs->ir_schedule.GetModule().GetExprs();
   // compare exprs size firstly
@@ -62,12 +62,16 @@ struct _SearchState_ : public common::Object {
   static constexpr char* __type_info__ = "auto_schedule_state";
 };
 
-// SearchStateHash hash functor that visits every AST node and combine their hash of node_type in dfs order
+// SearchStateHash hash functor that uses the fingerprint of the ScheduleDesc trace of a state,
+// so the cost doesn't grow with the size of the IR. For a state without any schedule step, it
+// visits every AST node and combine their hash of node_type in dfs order
 struct SearchStateHash {
   size_t operator()(const SearchState& s) const;
 };
 
-// SearchStateHash equal functor, use ir::IrEqualVisitor to compare their AST struct and fields
+// SearchStateHash equal functor, two states scheduled from the same original ModuleExpr are regarded equal
+// if their traces have the same fingerprint and step types. Otherwise, for states without any schedule step
+// or with colliding fingerprints, use ir::IrEqualVisitor to compare their AST struct and fields
 struct SearchStateEqual {
   bool operator()(const SearchState& lhs, const SearchState& rhs) const;
 };
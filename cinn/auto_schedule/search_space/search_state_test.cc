@@ -19,6 +19,7 @@
 
 #include "cinn/cinn.h"
 #include "cinn/common/context.h"
+#include "cinn/optim/ir_copy.h"
 
 namespace cinn {
 namespace auto_schedule {
@@ -132,5 +133,71 @@ TEST(TestSearchState, SearchStateHash_Equal) {
   ASSERT_FALSE(equal_functor(a_plus_const_state1, a_plus_b_state));
 }
 
+TEST(TestSearchState, SearchStateHash_Equal_WithTrace) {
+  Target target = common::DefaultHostTarget();
+
+  ir::Expr M(32);
+  ir::Expr N(32);
+  lang::Placeholder<float> A("A", {M, N});
+  ir::Tensor B = lang::Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + ir::Expr(2.f); }, "B");
+
+  cinn::common::Context::Global().ResetNameId();
+  auto funcs = lang::LowerVec("A_plus_const", poly::CreateStages({A, B}), {A, B}, {}, {}, nullptr, target, true);
+  ASSERT_EQ(funcs.size(), 1);
+
+  auto split_fn = [&funcs](int loop_index, const std::vector<int>& factors) {
+    SearchState state(ir::IRSchedule(ir::ModuleExpr({optim::IRCopy(funcs.front()->body)})));
+    state->ir_schedule.Split("B", loop_index, factors);
+    return state;
+  };
+  SearchState state1 = split_fn(0, {4, 8});
+  SearchState state2 = split_fn(0, {4, 8});
+  SearchState state3 = split_fn(0, {8, 4});
+  SearchState state4 = split_fn(1, {4, 8});
+
+  SearchStateHash hash_functor;
+  SearchStateEqual equal_functor;
+  ASSERT_EQ(hash_functor(state1), hash_functor(state2));
+  ASSERT_TRUE(equal_functor(state1, state2));
+  ASSERT_NE(hash_functor(state1), hash_functor(state3));
+  ASSERT_FALSE(equal_functor(state1, state3));
+  ASSERT_NE(hash_functor(state1), hash_functor(state4));
+  ASSERT_FALSE(equal_functor(state1, state4));
+  // a copied state keeps the trace
+  ASSERT_EQ(hash_functor(state1), hash_functor(state1.Copy()));
+  ASSERT_TRUE(equal_functor(state1, state1.Copy()));
+}
+
+TEST(TestSearchState, SearchStateEqual_DifferentDecisions) {
+  Target target = common::DefaultHostTarget();
+
+  ir::Expr M(256);
+  ir::Expr N(256);
+  lang::Placeholder<float> A("A", {M, N});
+  ir::Tensor B = lang::Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + ir::Expr(2.f); }, "B");
+
+  cinn::common::Context::Global().ResetNameId();
+  auto funcs = lang::LowerVec("A_plus_const", poly::CreateStages({A, B}), {A, B}, {}, {}, nullptr, target, true);
+  ASSERT_EQ(funcs.size(), 1);
+
+  // tile both loops into 4 levels, the j loop is the 5th after tiling the i loop
+  auto tile_fn = [&funcs](const std::vector<int>& i_factors, const std::vector<int>& j_factors) {
+    SearchState state(ir::IRSchedule(ir::ModuleExpr({optim::IRCopy(funcs.front()->body)})));
+    state->ir_schedule.Split("B", 0, i_factors);
+    state->ir_schedule.Split("B", 4, j_factors);
+    return state;
+  };
+  // the states differ only in the decisions, which must not be regarded as equal even if the fingerprints collide
+  SearchState state1 = tile_fn({32, 1, 2, 4}, {1, 2, 128, 1});
+  SearchState state2 = tile_fn({32, 1, 2, 4}, {1, 4, 1, 64});
+  SearchStateHash hash_functor;
+  SearchStateEqual equal_functor;
+  ASSERT_NE(hash_functor(state1), hash_functor(state2));
+  ASSERT_FALSE(equal_functor(state1, state2));
+  ASSERT_TRUE(equal_functor(state1, tile_fn({32, 1, 2, 4}, {1, 2, 128, 1})));
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -24,6 +24,7 @@
 #include <utility>
 
 #include "cinn/auto_schedule/database/database.h"
+#include "cinn/auto_schedule/database/record_transfer.h"
 #include "cinn/auto_schedule/post_schedule_rule/cooperative_process.h"
 #include "cinn/auto_schedule/search_space/search_space.h"
 #include "cinn/auto_schedule/search_space/search_state.h"
@@ -116,6 +117,18 @@ std::vector<SearchState> EvolutionarySearch::GetTopKCandidatesFromDatabase(int t
     ir::ScheduleDesc::ReplayWithProto(record.trace, &ir_sch);
     results.emplace_back(SearchState(std::move(ir_sch), record.predicted_cost));
   }
+
+  // seed with the records of a task which differs only in shape when this task has not enough records,
+  // and their costs are predicted later since they are measured on another task
+  if (static_cast<int>(results.size()) < topk) {
+    for (auto&& record : database_->GetTopKSimilar(task_key, topk - results.size())) {
+      ir::IRSchedule ir_sch(optim::IRCopy(task_registry->Get(task_key)->module_expr),
+                            utils::ForkRandomState(&rand_seed_));
+      if (ApplySimilarRecord(record, task_key, &ir_sch)) {
+        results.emplace_back(SearchState(std::move(ir_sch)));
+      }
+    }
+  }
   return results;
 }
 
@@ -138,7 +151,9 @@ std::vector<SearchState> EvolutionarySearch::InitSketch(int num, const std::stri
   return states;
 }
 
-SearchState EvolutionarySearch::CrossOver(const SearchState& state1, const SearchState& state2) {
+SearchState EvolutionarySearch::CrossOver(const SearchState& state1,
+                                          const SearchState& state2,
+                                          utils::LinearRandomEngine::StateType* rand_seed) {
   // TODO(CtfGo): tracing CrossOver with IRSchedule
   std::vector<ir::Expr> cross_over_exprs;
   std::vector<ir::Expr> father_exprs = state1->ir_schedule.GetModule().GetExprs();
@@ -148,20 +163,35 @@ SearchState EvolutionarySearch::CrossOver(const SearchState& state1, const Searc
       << "CrossOver ModuleExpr in EvolutionarySearch must have same number of AST";
 
   for (size_t i = 0; i < father_exprs.size(); ++i) {
-    if (utils::SampleUniformInt(0, 2, &rand_seed_) == 0) {
+    if (utils::SampleUniformInt(0, 2, rand_seed) == 0) {
       cross_over_exprs.push_back(optim::IRCopy(father_exprs[i]));
     } else {
       cross_over_exprs.push_back(optim::IRCopy(mother_exprs[i]));
     }
   }
-  auto res = SearchState(ir::IRSchedule(ir::ModuleExpr(cross_over_exprs), utils::ForkRandomState(&rand_seed_)));
-  if (FLAGS_auto_schedule_use_cost_model) {
-    res->predicted_cost = cost_model_.Predict(res->ir_schedule.GetModule(), tune_task_.target);
-  }
+  auto res = SearchState(ir::IRSchedule(ir::ModuleExpr(cross_over_exprs), utils::ForkRandomState(rand_seed)));
   VLOG(5) << JoinStatesDebugString("EvolutionarySearch::CrossOver", {state1, state2, res}, /*verbose=*/VLOG_IS_ON(6));
   return res;
 }
 
+void EvolutionarySearch::PredictCosts(const std::vector<SearchState>& states) const {
+  if (!FLAGS_auto_schedule_use_cost_model) {
+    return;
+  }
+  std::vector<SearchState> uninitialized_states;
+  std::vector<const ir::ModuleExpr*> samples;
+  for (const SearchState& state : states) {
+    if (state->predicted_cost == SearchState::NOT_INIT_COST) {
+      uninitialized_states.push_back(state);
+      samples.push_back(&state->ir_schedule.GetModule());
+    }
+  }
+  std::vector<float> costs = cost_model_.Predict(samples, tune_task_.target);
+  for (size_t i = 0; i < uninitialized_states.size(); ++i) {
+    uninitialized_states[i]->predicted_cost = costs[i];
+  }
+}
+
 SearchState EvolutionarySearch::Mutate(const SearchState& state, utils::LinearRandomEngine::StateType* rand_seed) {
   CHECK_GT(weighted_mutators_.size(), 0) << "There is no mutate rule can be applied.";
   double accu_weight = (weighted_mutators_.rbegin())->first;
@@ -198,21 +228,29 @@ std::vector<SearchState> EvolutionarySearch::Evolve(const std::vector<SearchStat
   }
   // init evolution
   std::vector<SearchState> evolution(population);
-  for (SearchState& search_state : evolution) {
-    if (search_state->predicted_cost == SearchState::NOT_INIT_COST && FLAGS_auto_schedule_use_cost_model) {
-      search_state->predicted_cost = cost_model_.Predict(search_state->ir_schedule.GetModule(), tune_task_.target);
-    }
-  }
-  VLOG(4) << JoinStatesDebugString("EvolutionarySearch::Evolve: Init evolution:", evolution, /*verbose=*/VLOG_IS_ON(5));
-  // cross over
+  // cross over, the parents and random seeds are sampled in order so that the result is deterministic
+  std::vector<std::pair<int, int>> parents(cross_over_num);
+  std::vector<utils::LinearRandomEngine::StateType> cross_over_seeds(cross_over_num);
   for (int i = 0; i < cross_over_num; ++i) {
     int first_rand_idx  = utils::SampleUniformInt(0, generation_num, &rand_seed_);
     int second_rand_idx = utils::SampleUniformInt(0, generation_num, &rand_seed_);
     while (first_rand_idx == second_rand_idx) {
       second_rand_idx = utils::SampleUniformInt(0, generation_num, &rand_seed_);
     }
-    evolution.push_back(CrossOver(population[first_rand_idx], population[second_rand_idx]));
+    parents[i]          = std::make_pair(first_rand_idx, second_rand_idx);
+    cross_over_seeds[i] = utils::ForkRandomState(&rand_seed_);
   }
+  std::vector<SearchState> cross_over_individuals(cross_over_num);
+  auto cross_over_fn = [this, &population, &parents, &cross_over_seeds, &cross_over_individuals](int index) {
+    cross_over_individuals[index] =
+        CrossOver(population[parents[index].first], population[parents[index].second], &cross_over_seeds[index]);
+  };
+  if (cross_over_num > 0) {
+    utils::parallel_run(cross_over_fn, utils::SequenceDispatcher(0, cross_over_num), cross_over_num);
+  }
+  evolution.insert(evolution.end(), cross_over_individuals.begin(), cross_over_individuals.end());
+  // predict the costs of the initial and crossed over individuals together
+  PredictCosts(evolution);
   VLOG(4) << JoinStatesDebugString(
       "EvolutionarySearch::Evolve: after CrossOver evolution:", evolution, /*verbose=*/VLOG_IS_ON(5));
   // mutate
@@ -225,12 +263,7 @@ std::vector<SearchState> EvolutionarySearch::Evolve(const std::vector<SearchStat
     mutated_individuals[index] = Mutate(evolution[index], &rand_seeds[index]);
   };
   utils::parallel_run(mutate_fn, utils::SequenceDispatcher(0, evolution.size()), evolution.size());
-  if (FLAGS_auto_schedule_use_cost_model) {
-    for (size_t i = 0; i < mutated_individuals.size(); ++i) {
-      mutated_individuals[i]->predicted_cost =
-          cost_model_.Predict(mutated_individuals[i]->ir_schedule.GetModule(), tune_task_.target);
-    }
-  }
+  PredictCosts(mutated_individuals);
   VLOG(4) << JoinStatesDebugString(
       "EvolutionarySearch::Evolve: mutated individuals:", mutated_individuals, /*verbose=*/VLOG_IS_ON(5));
   // select top ret_num with predicted cost
@@ -59,6 +59,11 @@ class EvolutionarySearch {
    */
   SearchState SearchModuleExpr(const TuningOptions& options);
 
+  /**
+   * The current random state, a search constructed with it continues the random sequence of this one.
+   */
+  utils::LinearRandomEngine::StateType rand_seed() const { return rand_seed_; }
+
   /**
    * Run the evolutionary search for one iteration.
    *
@@ -117,7 +122,12 @@ class EvolutionarySearch {
 
   SearchState Mutate(const SearchState& state, utils::LinearRandomEngine::StateType* rand_seed);
 
-  SearchState CrossOver(const SearchState& state1, const SearchState& state2);
+  SearchState CrossOver(const SearchState& state1,
+                        const SearchState& state2,
+                        utils::LinearRandomEngine::StateType* rand_seed);
+
+  // Predict the costs of the states whose costs are not initialized yet, in a batch
+  void PredictCosts(const std::vector<SearchState>& states) const;
 
   std::vector<SearchState> Evolve(const std::vector<SearchState>& population, int cross_over_num, int ret_num);
 
@@ -93,6 +93,15 @@ class MockCostModel : public ExprCostModel {
     }
     return cost;
   }
+
+  std::vector<float> Predict(const std::vector<const ir::ModuleExpr*>& samples,
+                             const common::Target& target) const override {
+    std::vector<float> costs;
+    for (const ir::ModuleExpr* sample : samples) {
+      costs.push_back(Predict(*sample, target));
+    }
+    return costs;
+  }
 };
 
 TEST(EvolutionarySearch, GetOneBest) {
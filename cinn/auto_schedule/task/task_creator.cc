@@ -34,8 +34,6 @@ using ::cinn::hlir::framework::Node;
 using ::cinn::hlir::framework::NodeData;
 
 std::vector<TuneTask> TaskCreator::CreateTuneTaskOpLevel(Graph* graph) {
-  std::vector<TuneTask> ret_tasks;
-
   const std::vector<std::shared_ptr<Graph::Group>>* groups = &graph->fusion_groups;
   std::vector<std::shared_ptr<Graph::Group>> non_fused_groups;
   // The input graph doesn't run Op Fusion
@@ -45,10 +43,16 @@ std::vector<TuneTask> TaskCreator::CreateTuneTaskOpLevel(Graph* graph) {
   }
   VLOG(3) << "Graph groups size:" << groups->size();
 
-  for (const auto& sub_graph : *groups) {
+  return CreateTuneTaskOpLevel(*groups, graph->target_);
+}
+
+std::vector<TuneTask> TaskCreator::CreateTuneTaskOpLevel(const std::vector<std::shared_ptr<Graph::Group>>& groups,
+                                                         const common::Target& target) {
+  std::vector<TuneTask> ret_tasks;
+  for (const auto& sub_graph : groups) {
     ret_tasks.emplace_back(TuneTask());
     ret_tasks.back().subgraph = sub_graph;
-    ret_tasks.back().target   = graph->target_;
+    ret_tasks.back().target   = target;
   }
   return ret_tasks;
 }
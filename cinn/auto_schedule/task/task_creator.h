@@ -30,6 +30,10 @@ namespace auto_schedule {
 class TaskCreator {
  public:
   std::vector<TuneTask> CreateTuneTaskOpLevel(hlir::framework::Graph* graph);
+
+  // Create a task for each of the specified groups, such as the ones partitioned by graph tuning
+  std::vector<TuneTask> CreateTuneTaskOpLevel(const std::vector<std::shared_ptr<hlir::framework::Graph::Group>>& groups,
+                                              const common::Target& target);
 };
 
 }  // namespace auto_schedule
@@ -16,13 +16,16 @@
 
 #include <glog/logging.h>
 
+#include <fstream>
 #include <functional>
 #include <limits>
 
 #include "cinn/auto_schedule/analysis/analyze_ir.h"
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
+#include "cinn/auto_schedule/database/record_transfer.h"
 #include "cinn/auto_schedule/measure/measure.h"
 #include "cinn/auto_schedule/search_strategy/evolutionary_search.h"
+#include "cinn/auto_schedule/task/task_registry.h"
 #include "cinn/common/target.h"
 #include "cinn/hlir/framework/op_lowering.h"
 #include "cinn/hlir/op/external_api_registry.h"
@@ -97,8 +100,35 @@ FunctionGroup TaskOptimizer::Optimize(const TuningOptions& options) {
   return best.functions;
 }
 
-TaskOptimizer::Result TaskOptimizer::OptimizeByManual(bool need_measured) {
+std::string TaskOptimizer::ManualMeasuredKey(const TuneTask& task) {
   static constexpr char* kManualMeasuredKeyPrefix = "@ManualMeasured:\n";
+  return kManualMeasuredKeyPrefix + task.serialized_key;
+}
+
+void TaskOptimizer::SaveCheckpoint(const std::string& path_prefix) {
+  cost_model_.Save(path_prefix + ".cost_model");
+  cost_model_.SaveSamples(path_prefix + ".samples");
+  std::ofstream os(path_prefix + ".state");
+  CHECK(os.is_open()) << "Failed to open " << path_prefix << ".state to save the checkpoint";
+  // the random state of the search goes on with each round, 0 if the search is not created yet
+  auto search_rand_seed = evolutionary_search_ ? evolutionary_search_->rand_seed() : search_rand_seed_;
+  os << rand_seed_ << " " << num_measured_trials_ << " " << search_rand_seed << "\n";
+  os.close();
+  CHECK(!os.fail()) << "Failed to save the checkpoint to " << path_prefix << ".state";
+}
+
+void TaskOptimizer::LoadCheckpoint(const std::string& path_prefix) {
+  cost_model_.Load(path_prefix + ".cost_model");
+  cost_model_.LoadSamples(path_prefix + ".samples");
+  std::ifstream is(path_prefix + ".state");
+  CHECK(is.is_open()) << "Failed to open " << path_prefix << ".state to load the checkpoint";
+  is >> rand_seed_ >> num_measured_trials_ >> search_rand_seed_;
+  CHECK(!is.fail()) << "Failed to load the checkpoint from " << path_prefix << ".state";
+  // the search is recreated with its restored random state instead of a new one forked from rand_seed_
+  evolutionary_search_.reset();
+}
+
+TaskOptimizer::Result TaskOptimizer::OptimizeByManual(bool need_measured) {
   TaskOptimizer::Result result("Manual");
   result.functions = task_->op_lowerer->Lower(task_->subgraph);
 
@@ -112,8 +142,8 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByManual(bool need_measured) {
   // the manual is regarded as the second best in default, so we set its cost 0.0
   result.cost = 0.0;
 
-  // add the specific prefix in front of serialized_key to be store/load measured record for manual schedule
-  std::string measured_key = kManualMeasuredKeyPrefix + task_->serialized_key;
+  // the specific prefix in front of serialized_key is used to store/load measured record for manual schedule
+  std::string measured_key = ManualMeasuredKey(*task_);
   if (need_measured && database_->Count(measured_key) == 0) {
     std::vector<MeasureInput> inputs(1);
     inputs.back().task          = task_;
@@ -124,6 +154,10 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByManual(bool need_measured) {
   }
 
   auto measured_records = database_->LookUp(measured_key);
+  if (measured_records.empty() && !need_measured && database_->Count(task_->serialized_key) == 0) {
+    // compare with the record of the similar task by the manual schedule measured on the same task
+    measured_records = database_->GetTopKSimilar(measured_key, 1);
+  }
   if (!measured_records.empty()) {  // update result.cost by measured if exists
     result.cost = measured_records[0].execution_cost;
   }
@@ -180,7 +214,8 @@ bool IsForbiddenToTune(const TuneTask* task) {
 bool HasExternalApi(const TuneTask* task) {
   auto nodes       = task->subgraph->CollectNodes();
   auto* first_node = nodes.front();
-  if (nodes.size() == 1 && ExternalApiRegistry::Global()->Has(first_node->op()->name, task->target)) {
+  if (nodes.size() == 1 &&
+      ExternalApiRegistry::Global()->CanTransform(first_node, task->op_lowerer->type_dict(), task->target)) {
     return true;
   }
   return false;
@@ -213,8 +248,8 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
   if (evolutionary_search_ == nullptr) {
     // TODO(zhhsplendid): check whether the options is same as previous,
     // if not, we should create new EvolutionarySearch
-    evolutionary_search_ =
-        std::make_unique<EvolutionarySearch>(*task_, cost_model_, database_, utils::ForkRandomState(&rand_seed_));
+    auto search_rand_seed = search_rand_seed_ != 0 ? search_rand_seed_ : utils::ForkRandomState(&rand_seed_);
+    evolutionary_search_  = std::make_unique<EvolutionarySearch>(*task_, cost_model_, database_, search_rand_seed);
   }
 
   TaskOptimizer::Result result("Evolution");
@@ -223,6 +258,10 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
   // use initial lowered function as default result
   optimized_funcs = optim::IRCopy(task_->lowered_funcs);
   if (options.num_measure_trials == 0) {  // no need to measure and simply return the best searched
+    // a record measured on a task differing only in shape is more reliable than the unmeasured searched
+    if (database_->Count(task_->serialized_key) == 0 && OptimizeBySimilarRecord(&result)) {
+      return result;
+    }
     std::vector<MeasureInput> measure_candidates;
     std::vector<SearchState> states = SearchOneRound(options, &measure_candidates);
     if (!states.empty()) {
@@ -256,6 +295,13 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
     }
     continuous_empty_cnt = 0;  // reset if get valid candidates
 
+    // the runner can stop measuring the candidates surely slower than the best measured
+    auto best_records = database_->GetTopK(task_->serialized_key, 1);
+    if (!best_records.empty()) {
+      for (auto& input : measure_inputs) {
+        input.best_execution_cost = best_records[0].execution_cost;
+      }
+    }
     VLOG(4) << "ScheduleMeasurer start with input size=" << measure_inputs.size();
     std::vector<MeasureResult> measure_outputs = schedule_measurer_->Measure(measure_inputs);
     CHECK_EQ(measure_outputs.size(), states.size())
@@ -291,6 +337,7 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
 
     // count result size
     measured_count += states.size();
+    num_measured_trials_ += states.size();
   }
   return result;
 }
@@ -302,22 +349,10 @@ std::vector<SearchState> TaskOptimizer::SearchOneRound(const TuningOptions& opti
 
   size_t valid_cnt = 0;
   for (size_t i = 0; i < states.size(); ++i) {
-    std::vector<ir::Expr> best_exprs = states[i]->ir_schedule.GetModule().GetExprs();
-    CHECK_EQ(best_exprs.size(), task_->lowered_funcs.size())
-        << "RuntimeError: Expr size is not equal to LoweredFunc size in TaskOptimizer";
-    auto init_funcs = optim::IRCopy(task_->lowered_funcs);
-    std::vector<ir::LoweredFunc> valid_funcs;
-    for (size_t j = 0; j < best_exprs.size(); ++j) {
-      auto updated_f = UpdateFuncWithNewBody(task_->target, init_funcs[j], best_exprs[j]);
-      if (PruneInvalid(updated_f, task_->target)) {
-        VLOG(4) << "PruneInvalid states-" << i;
-        break;
-      }
-      valid_funcs.emplace_back(updated_f);
-    }
-
-    // all functions are validated, collect this state to be measured
-    if (valid_funcs.size() == init_funcs.size()) {
+    std::vector<ir::LoweredFunc> valid_funcs = LowerValidFuncs(states[i]);
+    if (valid_funcs.empty()) {
+      VLOG(4) << "PruneInvalid states-" << i;
+    } else {  // all functions are validated, collect this state to be measured
       states[valid_cnt++] = states[i];
       measure_candidates->emplace_back(MeasureInput());
       measure_candidates->back().task          = task_;
@@ -332,6 +367,43 @@ std::vector<SearchState> TaskOptimizer::SearchOneRound(const TuningOptions& opti
   return states;
 }
 
+std::vector<ir::LoweredFunc> TaskOptimizer::LowerValidFuncs(const SearchState& state) {
+  std::vector<ir::Expr> best_exprs = state->ir_schedule.GetModule().GetExprs();
+  CHECK_EQ(best_exprs.size(), task_->lowered_funcs.size())
+      << "RuntimeError: Expr size is not equal to LoweredFunc size in TaskOptimizer";
+  auto init_funcs = optim::IRCopy(task_->lowered_funcs);
+  std::vector<ir::LoweredFunc> valid_funcs;
+  for (size_t j = 0; j < best_exprs.size(); ++j) {
+    auto updated_f = UpdateFuncWithNewBody(task_->target, init_funcs[j], best_exprs[j]);
+    if (PruneInvalid(updated_f, task_->target)) {
+      return {};
+    }
+    valid_funcs.emplace_back(updated_f);
+  }
+  return valid_funcs;
+}
+
+bool TaskOptimizer::OptimizeBySimilarRecord(TaskOptimizer::Result* result) {
+  auto records = database_->GetTopKSimilar(task_->serialized_key, 1);
+  if (records.empty()) {
+    return false;
+  }
+  ir::IRSchedule ir_sch(optim::IRCopy(InitialTaskRegistry::Global()->Get(task_->serialized_key)->module_expr),
+                        utils::ForkRandomState(&rand_seed_));
+  if (!ApplySimilarRecord(records[0], task_->serialized_key, &ir_sch)) {
+    return false;
+  }
+  std::vector<ir::LoweredFunc> valid_funcs = LowerValidFuncs(SearchState(std::move(ir_sch)));
+  if (valid_funcs.empty()) {
+    VLOG(4) << "The record transferred from a similar task is invalid";
+    return false;
+  }
+  VLOG(4) << "Apply the best record of the similar task:\n" << records[0].task_key;
+  result->functions = std::move(valid_funcs);
+  result->cost      = records[0].execution_cost;
+  return true;
+}
+
 // detect the limit of available shared memory on the current NVGPU with CUDA runtime
 size_t GetGPUSharedMemoryLimit() {
 #ifdef CINN_WITH_CUDA
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
 #include "cinn/auto_schedule/database/database.h"
@@ -40,6 +41,19 @@ class TaskOptimizer {
 
   FunctionGroup Optimize(const TuningOptions& options);
 
+  // the key to store/load the measured record of the manual schedule of a task
+  static std::string ManualMeasuredKey(const TuneTask& task);
+
+  // Save the cost model with its samples and the random state into files with the path prefix,
+  // the search population is resumed from the records in the database
+  void SaveCheckpoint(const std::string& path_prefix);
+
+  // Restore the state saved by SaveCheckpoint
+  void LoadCheckpoint(const std::string& path_prefix);
+
+  // the number of candidates measured by evolutionary search
+  int NumMeasuredTrials() const { return num_measured_trials_; }
+
  private:
   struct Result {
     std::string from;
@@ -55,6 +69,12 @@ class TaskOptimizer {
   // call search candidates once by EvolutionarySearch and prune invalid ones
   std::vector<SearchState> SearchOneRound(const TuningOptions& options, std::vector<MeasureInput>* measure_candidates);
 
+  // update the lowered functions with the scheduled module of a state, return empty if any of them is invalid
+  std::vector<ir::LoweredFunc> LowerValidFuncs(const SearchState& state);
+
+  // apply the best record of the most similar task when the task has no record, return false if there is none
+  bool OptimizeBySimilarRecord(Result* result);
+
  private:
   // the max retry times if continuously get empty result
   static constexpr uint32_t kMaxRetryContinuousEmpty_ = 3;
@@ -64,6 +84,9 @@ class TaskOptimizer {
   ExprCostModel cost_model_;
   Database* database_;
   utils::LinearRandomEngine::StateType rand_seed_;
+  // the random state restored for the evolutionary search, 0 if it should be forked from rand_seed_
+  utils::LinearRandomEngine::StateType search_rand_seed_ = 0;
+  int num_measured_trials_                               = 0;
 };
 
 }  // namespace auto_schedule
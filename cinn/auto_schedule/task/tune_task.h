@@ -58,6 +58,9 @@ class TuneTask {
   // serialized string of this task, it contains struct,shape,dtype,input/output variable name
   // of the subgraph and can be further used to hash
   std::string serialized_key;
+  // the number of times the subgraph of this task runs in the model, a task standing for several identical
+  // subgraphs should set it to their count so that the scheduler weights its latency accordingly
+  int weight = 1;
 
  private:
   // Serialize this task as a string contains specific fields of it
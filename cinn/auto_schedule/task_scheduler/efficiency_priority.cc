@@ -14,20 +14,130 @@
 
 #include "cinn/auto_schedule/task_scheduler/efficiency_priority.h"
 
+#include <glog/logging.h>
+
+#include <iomanip>
+#include <limits>
+
 namespace cinn {
 namespace auto_schedule {
 
+EfficiencyPriority::EfficiencyPriority(const std::vector<TuneTask>& tasks, const Config& config, Database* database)
+    : TaskScheduler(tasks, config, database), num_tunings_(tasks.size(), 0), cost_histories_(tasks.size()) {
+  CHECK(database_ != nullptr) << "EfficiencyPriority requires a database to fetch tuning results";
+  CHECK_GT(config_.backward_window_size, 0) << "Invalid backward_window_size";
+}
+
 int EfficiencyPriority::NextTaskId() {
-  while (cur_task_id_ < tasks_->size()) {
-    if (IsTaskToTune(&tasks_->at(cur_task_id_))) {
-      return cur_task_id_++;
+  if (last_task_id_ != -1) {
+    UpdateHistory(last_task_id_);
+    last_task_id_ = -1;
+  }
+  // cur_task_id_ counts the tunings dispatched in this round
+  if (cur_task_id_ >= tasks_->size()) {
+    return -1;
+  }
+
+  int next_task_id = -1;
+  for (int i = 0; i < tasks_->size(); ++i) {
+    if (num_tunings_[i] == 0) {
+      next_task_id = i;
+      break;
+    }
+  }
+  if (next_task_id == -1) {
+    double max_gain = -1.0;
+    for (int i = 0; i < tasks_->size(); ++i) {
+      if (!IsTaskToTune(&tasks_->at(i))) {
+        continue;
+      }
+      double gain = ExpectedGain(i);
+      // prefer the task tuned fewer times if the gains are equal
+      if (gain > max_gain || (gain == max_gain && num_tunings_[i] < num_tunings_[next_task_id])) {
+        max_gain     = gain;
+        next_task_id = i;
+      }
+    }
+    if (next_task_id == -1) {
+      VLOG(3) << "No task is worth tuning with minimum_gain_threshold=" << config_.minimum_gain_threshold;
+      return -1;
+    }
+    VLOG(4) << "Task-" << next_task_id << " has the maximum expected gain=" << max_gain;
+  }
+
+  ++cur_task_id_;
+  ++num_tunings_[next_task_id];
+  last_task_id_ = next_task_id;
+  return next_task_id;
+}
+
+void EfficiencyPriority::SaveState(std::ostream& os) const {
+  CHECK_EQ(last_task_id_, -1) << "Save the state in the middle of a round";
+  os << std::setprecision(std::numeric_limits<double>::max_digits10);
+  os << tasks_->size() << "\n";
+  for (int i = 0; i < tasks_->size(); ++i) {
+    os << num_tunings_[i] << " " << cost_histories_[i].size();
+    for (double cost : cost_histories_[i]) {
+      os << " " << cost;
     }
-    ++cur_task_id_;
+    os << "\n";
   }
-  return -1;
 }
 
-bool EfficiencyPriority::IsTaskToTune(const TuneTask* task) { return config_.minimum_gain_threshold > 0.0; }
+void EfficiencyPriority::LoadState(std::istream& is) {
+  size_t num_tasks = 0;
+  is >> num_tasks;
+  CHECK_EQ(num_tasks, tasks_->size()) << "The state is saved with different tasks";
+  for (int i = 0; i < num_tasks; ++i) {
+    size_t history_size = 0;
+    is >> num_tunings_[i] >> history_size;
+    cost_histories_[i].resize(history_size);
+    for (auto& cost : cost_histories_[i]) {
+      is >> cost;
+    }
+  }
+  CHECK(!is.fail()) << "Failed to load the state of EfficiencyPriority";
+  last_task_id_ = -1;
+}
+
+bool EfficiencyPriority::IsTaskToTune(const TuneTask* task) {
+  int task_id = task - tasks_->data();
+  if (cost_histories_[task_id].empty()) {
+    // the gain of a task without any valid result is unknown
+    return config_.minimum_gain_threshold <= 0.0;
+  }
+  return ExpectedGain(task_id) >= config_.minimum_gain_threshold * TotalLatency();
+}
+
+void EfficiencyPriority::UpdateHistory(int task_id) {
+  auto records = database_->GetTopK(tasks_->at(task_id).serialized_key, 1);
+  if (!records.empty()) {
+    cost_histories_[task_id].push_back(records.front().execution_cost);
+  }
+}
+
+double EfficiencyPriority::ExpectedGain(int task_id) const {
+  const auto& history = cost_histories_[task_id];
+  if (history.empty()) {
+    return 0.0;
+  }
+  double cost       = history.back();
+  int window        = config_.backward_window_size;
+  double backward   = history.size() > window ? (history[history.size() - 1 - window] - cost) / window : 0.0;
+  double optimistic = cost / num_tunings_[task_id];
+  double alpha      = config_.backward_gradient_weight;
+  return tasks_->at(task_id).weight * (alpha * backward + (1 - alpha) * optimistic);
+}
+
+double EfficiencyPriority::TotalLatency() const {
+  double total = 0.0;
+  for (int i = 0; i < tasks_->size(); ++i) {
+    if (!cost_histories_[i].empty()) {
+      total += tasks_->at(i).weight * cost_histories_[i].back();
+    }
+  }
+  return total;
+}
 
 }  // namespace auto_schedule
 }  // namespace cinn
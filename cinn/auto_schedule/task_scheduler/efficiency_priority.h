@@ -15,6 +15,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "cinn/auto_schedule/task_scheduler/task_scheduler.h"
 
@@ -23,16 +24,46 @@ namespace auto_schedule {
 
 // Schedule tasks with efficiency_priority strategy, that
 // is picking a task with the maximum earnings ratio.
+//
+// The latency of the model is estimated as the sum of the best costs
+// recorded in the database weighted by TuneTask::weight. Each task is
+// tuned once at first, and then every tuning goes to the task whose
+// expected reduction of the total latency is the largest, which mixes
+// the slope of its recent improvement and an optimistic estimation
+// assuming its cost is inversely proportional to the tuning times.
+// A round dispatches at most as many tunings as the number of tasks,
+// the same budget as RoundRobin.
 class EfficiencyPriority : public TaskScheduler {
  public:
-  EfficiencyPriority(const std::vector<TuneTask>& tasks, const Config& config) : TaskScheduler(tasks, config) {}
+  EfficiencyPriority(const std::vector<TuneTask>& tasks, const Config& config, Database* database);
 
   const char* Name() const override { return "efficiency_priority"; };
 
   int NextTaskId() override;
 
+  void SaveState(std::ostream& os) const override;
+
+  void LoadState(std::istream& is) override;
+
  private:
   bool IsTaskToTune(const TuneTask* task);
+
+  // Append the best cost recorded in the database to the history of a task
+  void UpdateHistory(int task_id);
+
+  // Return the expected reduction of the total latency by tuning a task once more
+  double ExpectedGain(int task_id) const;
+
+  // Return the total latency of the tasks with recorded costs
+  double TotalLatency() const;
+
+  // The number of times each task has been tuned
+  std::vector<int> num_tunings_;
+  // The best costs of each task after its tunings, a tuning without
+  // any record in the database is not counted
+  std::vector<std::vector<double>> cost_histories_;
+  // The task dispatched last time, whose result will be updated at the next dispatch
+  int last_task_id_ = -1;
 };
 
 }  // namespace auto_schedule
@@ -25,20 +25,21 @@ namespace auto_schedule {
 
 std::unique_ptr<TaskScheduler> TaskScheduler::Make(const std::vector<TuneTask>& tasks,
                                                    const Config& config,
-                                                   const std::string& strategy) {
+                                                   const std::string& strategy,
+                                                   Database* database) {
   CHECK_GT(tasks.size(), 0) << "Empty task list";
   if (strategy == "round_robin") {
     return std::make_unique<RoundRobin>(tasks, config);
   } else if (strategy == "efficiency_priority") {
-    return std::make_unique<EfficiencyPriority>(tasks, config);
+    return std::make_unique<EfficiencyPriority>(tasks, config, database);
   }
 
   LOG(FATAL) << "Unimplemented strategy:" << strategy;
   return nullptr;
 }
 
-TaskScheduler::TaskScheduler(const std::vector<TuneTask>& tasks, const Config& config)
-    : tasks_(&tasks), config_(config), cur_task_id_(0) {}
+TaskScheduler::TaskScheduler(const std::vector<TuneTask>& tasks, const Config& config, Database* database)
+    : tasks_(&tasks), config_(config), cur_task_id_(0), database_(database) {}
 
 void TaskScheduler::Reset() { cur_task_id_ = 0; }
 
@@ -15,10 +15,13 @@
 #pragma once
 
 #include <functional>
+#include <istream>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
+#include "cinn/auto_schedule/database/database.h"
 #include "cinn/auto_schedule/task/task_optimizer.h"
 #include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/auto_schedule/tuning.h"
@@ -32,15 +35,27 @@ class TaskScheduler {
   // All configs for different schedule strategies
   // will be defined here together.
   struct Config {
-    // The minimum threshold of earnings ratio, used by EfficiencyPriority
+    // The minimum threshold of earnings ratio, used by EfficiencyPriority.
+    // A task is skipped if its expected reduction of the total latency
+    // by one more tuning, divided by the total latency, is less than it.
     float minimum_gain_threshold = 0.0;
+    // The weight of the observed improvement slope against the optimistic
+    // estimation when predicting the gain of a task, used by EfficiencyPriority
+    float backward_gradient_weight = 0.2;
+    // The number of recent tunings of a task to compute its improvement slope,
+    // used by EfficiencyPriority
+    int backward_window_size = 3;
   };
 
   // Create a TaskScheduler with the specific strategy name
-  // and necessary construct parameters.
+  // and necessary construct parameters. The database is where
+  // the tuning results are recorded, required by EfficiencyPriority.
   static std::unique_ptr<TaskScheduler> Make(const std::vector<TuneTask>& tasks,
                                              const Config& config,
-                                             const std::string& strategy = "round_robin");
+                                             const std::string& strategy = "round_robin",
+                                             Database* database          = nullptr);
+
+  virtual ~TaskScheduler() = default;
 
   // Reset associated states to schedule at the beginning
   void Reset();
@@ -51,9 +66,15 @@ class TaskScheduler {
   // Select a task to tune
   virtual int NextTaskId() = 0;
 
+  // Save the progress accumulated across rounds, used by the checkpoint of tuning
+  virtual void SaveState(std::ostream& os) const {}
+
+  // Restore the progress saved by SaveState
+  virtual void LoadState(std::istream& is) {}
+
  protected:
   // A taskScheduler object should be created with the static function Make
-  TaskScheduler(const std::vector<TuneTask>& tasks, const Config& config);
+  TaskScheduler(const std::vector<TuneTask>& tasks, const Config& config, Database* database = nullptr);
 
   // The config for scheduling strategy
   Config config_;
@@ -61,6 +82,8 @@ class TaskScheduler {
   int cur_task_id_;
   // The pointer refers to all tasks
   const std::vector<TuneTask>* tasks_;
+  // The database recording tuning results, not owned
+  Database* database_;
 };
 
 }  // namespace auto_schedule
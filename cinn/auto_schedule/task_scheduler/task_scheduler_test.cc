@@ -14,8 +14,11 @@
 
 #include "cinn/auto_schedule/task_scheduler/task_scheduler.h"
 
+#include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <sstream>
 #include <type_traits>
 
 #include "cinn/auto_schedule/task_scheduler/efficiency_priority.h"
@@ -27,10 +30,11 @@ namespace auto_schedule {
 TEST(TaskScheduler, Make) {
   std::vector<TuneTask> tasks(3);
   TaskScheduler::Config config;
+  Database database(2);
 
   auto round_robin = TaskScheduler::Make(tasks, config);
   ASSERT_STREQ(round_robin->Name(), "round_robin");
-  auto efficiency_priority = TaskScheduler::Make(tasks, config, "efficiency_priority");
+  auto efficiency_priority = TaskScheduler::Make(tasks, config, "efficiency_priority", &database);
   ASSERT_STREQ(efficiency_priority->Name(), "efficiency_priority");
 }
 
@@ -44,12 +48,154 @@ TEST(RoundRobinScheduler, NextTaskId) {
   ASSERT_EQ(0, round_robin->NextTaskId());
 }
 
+std::vector<TuneTask> CreateTasks(int num) {
+  std::vector<TuneTask> tasks(num);
+  for (int i = 0; i < num; ++i) {
+    tasks[i].serialized_key = "task_" + std::to_string(i);
+  }
+  return tasks;
+}
+
+void AddRecord(const TuneTask& task, double cost, Database* database) {
+  TuningRecord record;
+  record.task_key       = task.serialized_key;
+  record.predicted_cost = cost;
+  record.execution_cost = cost;
+  database->AddRecord(record);
+}
+
 TEST(EfficiencyPriorityScheduler, NextTaskId) {
-  std::vector<TuneTask> tasks(3);
+  std::vector<TuneTask> tasks = CreateTasks(3);
+  Database database(2);
   TaskScheduler::Config config;
-  config.minimum_gain_threshold = -1.0;
-  auto efficiency_priority      = TaskScheduler::Make(tasks, config, "efficiency_priority");
+  auto efficiency_priority = TaskScheduler::Make(tasks, config, "efficiency_priority", &database);
+  // each task is tuned once at first
+  const std::vector<double> costs = {100.0, 1.0, 1.0};
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(i, efficiency_priority->NextTaskId());
+    AddRecord(tasks[i], costs[i], &database);
+  }
+  ASSERT_EQ(-1, efficiency_priority->NextTaskId());
+
+  // the most costly task has the maximum gain
+  efficiency_priority->Reset();
+  ASSERT_EQ(0, efficiency_priority->NextTaskId());
+  AddRecord(tasks[0], 50.0, &database);
+  ASSERT_EQ(0, efficiency_priority->NextTaskId());
+  AddRecord(tasks[0], 1.0, &database);
+  ASSERT_EQ(1, efficiency_priority->NextTaskId());
+  // a round dispatches at most as many tunings as the tasks
   ASSERT_EQ(-1, efficiency_priority->NextTaskId());
+
+  // the task tuned less has the larger gain as the costs are equal
+  efficiency_priority->Reset();
+  ASSERT_EQ(2, efficiency_priority->NextTaskId());
+}
+
+TEST(EfficiencyPriorityScheduler, SaveAndLoadState) {
+  std::vector<TuneTask> tasks = CreateTasks(3);
+  Database database(2);
+  TaskScheduler::Config config;
+  auto efficiency_priority        = TaskScheduler::Make(tasks, config, "efficiency_priority", &database);
+  const std::vector<double> costs = {1.0, 100.0, 1.0};
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(i, efficiency_priority->NextTaskId());
+    AddRecord(tasks[i], costs[i], &database);
+  }
+  ASSERT_EQ(-1, efficiency_priority->NextTaskId());
+  std::stringstream state;
+  efficiency_priority->SaveState(state);
+
+  // a resumed scheduler continues with the most costly task instead of tuning each task once again
+  auto resumed = TaskScheduler::Make(tasks, config, "efficiency_priority", &database);
+  resumed->LoadState(state);
+  ASSERT_EQ(1, resumed->NextTaskId());
+  auto restarted = TaskScheduler::Make(tasks, config, "efficiency_priority", &database);
+  ASSERT_EQ(0, restarted->NextTaskId());
+}
+
+TEST(EfficiencyPriorityScheduler, MinimumGainThreshold) {
+  std::vector<TuneTask> tasks = CreateTasks(3);
+  Database database(2);
+  TaskScheduler::Config config;
+  config.minimum_gain_threshold = 0.5;
+  auto efficiency_priority      = TaskScheduler::Make(tasks, config, "efficiency_priority", &database);
+
+  const std::vector<double> costs = {100.0, 1.0, 1.0};
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(i, efficiency_priority->NextTaskId());
+    AddRecord(tasks[i], costs[i], &database);
+  }
+
+  efficiency_priority->Reset();
+  // the gain of task 0 is 0.8 * 100 / 1 >= 0.5 * 102
+  ASSERT_EQ(0, efficiency_priority->NextTaskId());
+  // the gain of task 0 drops to 0.8 * 100 / 2 without improvement
+  ASSERT_EQ(-1, efficiency_priority->NextTaskId());
+}
+
+// A simulated task whose cost decays exponentially from initial_cost to
+// final_cost along with its tuning times
+struct SimulatedTask {
+  double initial_cost;
+  double final_cost;
+  double decay;
+  int weight;
+
+  double Cost(int num_tunings) const {
+    return final_cost + (initial_cost - final_cost) * std::pow(decay, num_tunings);
+  }
+};
+
+// Return the number of tunings to reduce the total latency of the simulated tasks to the target
+int TuningsToTargetLatency(const std::string& strategy, const std::vector<SimulatedTask>& simulated_tasks) {
+  std::vector<TuneTask> tasks = CreateTasks(simulated_tasks.size());
+  double target_latency       = 0.0;
+  for (int i = 0; i < tasks.size(); ++i) {
+    tasks[i].weight = simulated_tasks[i].weight;
+    target_latency += 1.1 * simulated_tasks[i].weight * simulated_tasks[i].final_cost;
+  }
+
+  Database database(2);
+  TaskScheduler::Config config;
+  auto scheduler = TaskScheduler::Make(tasks, config, strategy, &database);
+  std::vector<int> num_tunings(tasks.size(), 0);
+  int total_tunings = 0;
+  for (int round = 0; round < 100; ++round) {
+    int task_id = -1;
+    scheduler->Reset();
+    while ((task_id = scheduler->NextTaskId()) != -1) {
+      ++total_tunings;
+      double cost = simulated_tasks[task_id].Cost(++num_tunings[task_id]);
+      AddRecord(tasks[task_id], cost, &database);
+
+      double latency = 0.0;
+      for (int i = 0; i < tasks.size(); ++i) {
+        latency += simulated_tasks[i].weight * simulated_tasks[i].Cost(num_tunings[i]);
+      }
+      if (latency <= target_latency) {
+        return total_tunings;
+      }
+    }
+  }
+  return -1;
+}
+
+// Compare the tuning budget to reach the target latency of the two strategies, on a model
+// with a dominant task, a recurring task and a long tail of small tasks
+TEST(EfficiencyPriorityScheduler, TuningsToTargetLatency) {
+  std::vector<SimulatedTask> simulated_tasks = {{2000.0, 200.0, 0.7, 1}, {300.0, 60.0, 0.7, 4}};
+  for (int i = 0; i < 30; ++i) {
+    simulated_tasks.push_back({50.0, 40.0, 0.7, 1});
+  }
+
+  int round_robin_tunings         = TuningsToTargetLatency("round_robin", simulated_tasks);
+  int efficiency_priority_tunings = TuningsToTargetLatency("efficiency_priority", simulated_tasks);
+  LOG(INFO) << "Tunings to reach the target latency, round_robin: " << round_robin_tunings
+            << ", efficiency_priority: " << efficiency_priority_tunings;
+  ASSERT_GT(round_robin_tunings, 0);
+  ASSERT_GT(efficiency_priority_tunings, 0);
+  ASSERT_LT(efficiency_priority_tunings, round_robin_tunings);
 }
 
 }  // namespace auto_schedule
@@ -17,6 +17,24 @@
 namespace cinn {
 namespace backends {
 
+CodeGenCX86::Feature CodeGenCX86::GetFeature(const Target &target) {
+  const auto &cpu = target.cpu;
+  if (!cpu.defined()) {
+    return Feature::AVX512;
+  }
+  int feature = static_cast<int>(Feature::None);
+  if (cpu.Has(common::CpuInfo::Feature::SSE4_2)) {
+    feature |= static_cast<int>(Feature::SSE);
+  }
+  if (cpu.Has(common::CpuInfo::Feature::AVX)) {
+    feature |= static_cast<int>(Feature::AVX256);
+  }
+  if (cpu.Has(common::CpuInfo::Feature::AVX512F)) {
+    feature |= static_cast<int>(Feature::AVX512);
+  }
+  return static_cast<Feature>(feature);
+}
+
 void CodeGenCX86::Visit(const ir::Add *op) { VisitBinaryOp(op, op->a(), op->b(), "add"); }
 void CodeGenCX86::Visit(const ir::Sub *op) { VisitBinaryOp(op, op->a(), op->b(), "sub"); }
 void CodeGenCX86::Visit(const ir::Mul *op) { VisitBinaryOp(op, op->a(), op->b(), "mul"); }
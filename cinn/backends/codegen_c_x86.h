@@ -46,6 +46,12 @@ class CodeGenCX86 : public CodeGenC {
    */
   CodeGenCX86(Target target, Feature feature) : CodeGenC(target), feature(feature) {}
 
+  /**
+   * Get the features supported by the CPU of the target, AVX512 is assumed if the CPU is unknown.
+   * @param target The device.
+   */
+  static Feature GetFeature(const Target &target);
+
  protected:
   void Visit(const ir::Add *op) override;
   void Visit(const ir::Sub *op) override;
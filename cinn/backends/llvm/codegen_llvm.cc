@@ -1023,7 +1023,13 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Let *op) {
     int align_bits = std::max<int>(op->type().bits(), 8);
     int align      = get_align(align_bits);
     inst->setAlignment(llvm::Align(align));
-    SetVar(name, inst);
+    if (op->type().lanes() > 1 && !op->type().is_customized_type()) {
+      // a local array of numbers is addressed by its first element as a buffer is
+      auto *element_ptr_type = CinnTypeToLLVMType(op->type().ElementOf(), m_)->getPointerTo();
+      SetVar(name, b_->CreatePointerCast(inst, element_ptr_type, name + "_ptr"));
+    } else {
+      SetVar(name, inst);
+    }
   }
 
   return GetVar(name);
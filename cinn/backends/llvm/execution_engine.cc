@@ -60,6 +60,7 @@
 #include "cinn/backends/llvm/codegen_x86.h"
 #include "cinn/backends/llvm/llvm_optimizer.h"
 #include "cinn/backends/llvm/llvm_util.h"
+#include "cinn/backends/llvm/object_cache.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/runtime/intrinsic.h"
@@ -117,10 +118,13 @@ std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Modu
   static std::once_flag flag;
   std::call_once(flag, InitializeLLVMPasses);
 
-  auto engine = std::make_unique<ExecutionEngine>(/*enable_object_cache=*/true, std::move(module_symbols));
+  auto engine        = std::make_unique<ExecutionEngine>(/*enable_object_cache=*/true, std::move(module_symbols));
+  engine->opt_level_ = config.opt_level;
+  engine->cpu_       = config.cpu;
 
   auto compile_layer_creator = [&engine](llvm::orc::JITTargetMachineBuilder jtmb)
       -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+    SetTargetCpu(engine->cpu_, &jtmb);
     auto machine = llvm::cantFail(jtmb.createTargetMachine());
     VLOG(1) << "create llvm compile layer";
     VLOG(1) << "Target Name: " << machine->getTarget().getName();
@@ -167,9 +171,19 @@ void ExecutionEngine::Link(const ir::Module &module) {
   VLOG(3) << "ir_emitter->Compile(module) Succeed!";
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid module found";
 
-  auto machine =
-      std::move(llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine()));
-  LLVMModuleOptimizer optimize(machine.get(), 3, {}, true);
+  auto machine = CreateTargetMachine(cpu_);
+
+  // reuse the object compiled by previous processes to skip optimizing and emitting
+  auto *object_cache = PersistentObjectCache::Global();
+  std::string object_key;
+  if (object_cache) {
+    object_key = PersistentObjectCache::ComputeKey(*m, *machine, opt_level_);
+    if (AddCachedObject(object_key)) {
+      return;
+    }
+  }
+
+  LLVMModuleOptimizer optimize(machine.get(), opt_level_, {}, true);
   optimize(m.get());
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid optimized module detected";
   for (auto &f : *m) {
@@ -180,6 +194,9 @@ void ExecutionEngine::Link(const ir::Module &module) {
   llvm::legacy::PassManager pass_manager;
   machine->addPassesToEmitFile(pass_manager, rawstream, nullptr, llvm::CGFT_ObjectFile);
   pass_manager.run(*m);
+  if (object_cache) {
+    object_cache->Store(object_key, buffer_.str());
+  }
 
   CHECK(AddModule(std::move(m), std::move(ctx)));
 
@@ -212,6 +229,24 @@ bool ExecutionEngine::AddModule(std::unique_ptr<llvm::Module> module, std::uniqu
   return true;
 }
 
+bool ExecutionEngine::AddCachedObject(const std::string &key) {
+  utils::RecordEvent("ExecutionEngine AddCachedObject", utils::EventType::kOrdinary);
+  auto object = PersistentObjectCache::Global()->Load(key);
+  if (!object) {
+    return false;
+  }
+  // keep a copy for ExportObject
+  buffer_.assign(object->getBufferStart(), object->getBufferEnd());
+  llvm::cantFail(jit_->addObjectFile(std::move(object)));
+  return true;
+}
+
+void ExecutionEngine::AddObject(llvm::StringRef object) {
+  utils::RecordEvent("ExecutionEngine AddObject", utils::EventType::kOrdinary);
+  buffer_.assign(object.begin(), object.end());
+  llvm::cantFail(jit_->addObjectFile(llvm::MemoryBuffer::getMemBufferCopy(object)));
+}
+
 void ExecutionEngine::ExportObject(const std::string &path) {
   FILE *of = fopen(path.c_str(), "w");
   fwrite(buffer_.data(), 1, buffer_.size(), of);
@@ -46,6 +46,7 @@
 #include "cinn/backends/llvm/codegen_x86.h"
 #include "cinn/backends/llvm/llvm_util.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
+#include "cinn/common/target.h"
 #include "cinn/ir/module.h"
 
 namespace cinn::backends {
@@ -62,6 +63,8 @@ class NaiveObjectCache : public llvm::ObjectCache {
 struct ExecutionOptions {
   int opt_level{3};
   bool enable_debug_info{false};
+  // the CPU to generate code for
+  common::CpuInfo cpu{common::DefaultHostTarget().cpu};
   // TODO(fc500110)
   // int num_compile_threads{1};
   // bool enable_fast_math;
@@ -80,6 +83,12 @@ class ExecutionEngine {
 
   void ExportObject(const std::string &path);
 
+  // The object code of the linked module.
+  llvm::StringRef GetObject() const { return buffer_.str(); }
+
+  // Add the object code compiled before, such as the one from GetObject() of another engine.
+  void AddObject(llvm::StringRef object);
+
   bool AddModule(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context);
 
  protected:
@@ -90,6 +99,9 @@ class ExecutionEngine {
 
   bool SetupTargetTriple(llvm::Module *module);
 
+  // Add the object of \p key from the persistent object cache, returns false if missed.
+  bool AddCachedObject(const std::string &key);
+
   // This may not be a compatible implementation.
   friend std::unique_ptr<ExecutionEngine> std::make_unique<ExecutionEngine>(bool &&, cinn::backends::RuntimeSymbols &&);
 
@@ -99,6 +111,8 @@ class ExecutionEngine {
   std::unique_ptr<llvm::orc::LLJIT> jit_;
   std::unique_ptr<NaiveObjectCache> cache_;
   RuntimeSymbols module_symbols_;
+  int opt_level_{3};
+  common::CpuInfo cpu_;
 };
 
 }  // namespace cinn::backends
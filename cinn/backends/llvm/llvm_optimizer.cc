@@ -59,6 +59,8 @@
 #include <type_traits>
 #include <utility>
 
+#include "cinn/backends/llvm/llvm_util.h"
+#include "cinn/common/target.h"
 #include "llvm/Support/CodeGen.h"
 
 namespace cinn::backends {
@@ -122,8 +124,13 @@ LLVMModuleOptimizer::LLVMModuleOptimizer(llvm::TargetMachine *machine,
     : opt_level_(opt_level), print_passes_(print_passes), machine_(machine) {}
 
 void LLVMModuleOptimizer::operator()(llvm::Module *m) {
-  auto machine =
-      std::move(llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine()));
+  // optimize for the CPU of the given machine, or the host if not given
+  std::unique_ptr<llvm::TargetMachine> host_machine;
+  llvm::TargetMachine *machine = machine_;
+  if (!machine) {
+    host_machine = CreateTargetMachine(common::DefaultHostTarget().cpu);
+    machine      = host_machine.get();
+  }
   auto fpm = std::make_unique<CustomFunctionPassManager>(print_passes_, m);
   // fpm->add(llvm::createTargetTransformInfoWrapperPass(llvm::TargetIRAnalysis()));
   // fpm->add(llvm::createInstructionCombiningPass());
@@ -20,6 +20,8 @@
 #include <atomic>
 #include <mutex>  //NOLINT
 
+#include "cinn/utils/string.h"
+
 namespace cinn {
 namespace backends {
 
@@ -142,5 +144,22 @@ __(void **)
 
 #undef __
 
+void SetTargetCpu(const common::CpuInfo &cpu, llvm::orc::JITTargetMachineBuilder *jtmb) {
+  if (!cpu.defined()) {
+    return;
+  }
+  if (!cpu.name.empty()) {
+    jtmb->setCPU(cpu.name);
+  }
+  // the features appended later win, and disabling a feature disables the ones implying it as well
+  jtmb->addFeatures(utils::Split(cpu.LLVMFeatures(), ","));
+}
+
+std::unique_ptr<llvm::TargetMachine> CreateTargetMachine(const common::CpuInfo &cpu) {
+  auto jtmb = llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost());
+  SetTargetCpu(cpu, &jtmb);
+  return llvm::cantFail(jtmb.createTargetMachine());
+}
+
 }  // namespace backends
 }  // namespace cinn
@@ -17,6 +17,7 @@
 #include <absl/strings/string_view.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/IR/Argument.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/IRBuilder.h>
@@ -24,11 +25,14 @@
 #include <llvm/IR/Intrinsics.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Value.h>
+#include <llvm/Target/TargetMachine.h>
 
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
 
+#include "cinn/common/cpu_info.h"
 #include "cinn/common/type.h"
 
 namespace cinn {
@@ -51,5 +55,14 @@ llvm::Type *CinnTypeToLLVMType(common::Type t, llvm::Module *m, bool is_vec = fa
 template <typename T>
 llvm::Type *llvm_type_of(llvm::Module *m);
 
+/**
+ * Generate code for the CPU by the builder, the features of the CPU override the ones of the host detected by LLVM.
+ * The builder is kept unchanged if the CPU is unknown.
+ */
+void SetTargetCpu(const common::CpuInfo &cpu, llvm::orc::JITTargetMachineBuilder *jtmb);
+
+//! Create the target machine generating code for the CPU.
+std::unique_ptr<llvm::TargetMachine> CreateTargetMachine(const common::CpuInfo &cpu);
+
 }  // namespace backends
 }  // namespace cinn
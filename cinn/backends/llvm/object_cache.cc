@@ -0,0 +1,165 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/backends/llvm/object_cache.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+#include <utime.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+DECLARE_string(cinn_jit_object_cache_dir);
+DECLARE_int64(cinn_jit_object_cache_max_size);
+
+namespace cinn::backends {
+
+namespace {
+constexpr char kObjectSuffix[] = ".o";
+}  // namespace
+
+PersistentObjectCache::PersistentObjectCache(const std::string& cache_dir, uint64_t max_size_bytes)
+    : cache_dir_(cache_dir), max_size_bytes_(max_size_bytes) {
+  auto ec = llvm::sys::fs::create_directories(cache_dir_);
+  CHECK(!ec) << "Failed to create the object cache directory [" << cache_dir_ << "]: " << ec.message();
+}
+
+PersistentObjectCache* PersistentObjectCache::Global() {
+  static std::unique_ptr<PersistentObjectCache> cache = []() -> std::unique_ptr<PersistentObjectCache> {
+    if (FLAGS_cinn_jit_object_cache_dir.empty()) {
+      return nullptr;
+    }
+    uint64_t max_size = std::max<int64_t>(FLAGS_cinn_jit_object_cache_max_size, 0) << 20;
+    LOG(INFO) << "Enable JIT object cache at [" << FLAGS_cinn_jit_object_cache_dir << "], max size "
+              << FLAGS_cinn_jit_object_cache_max_size << " MB";
+    return std::make_unique<PersistentObjectCache>(FLAGS_cinn_jit_object_cache_dir, max_size);
+  }();
+  return cache.get();
+}
+
+std::string PersistentObjectCache::ComputeKey(const llvm::Module& m,
+                                              const llvm::TargetMachine& machine,
+                                              int opt_level) {
+  std::string ir;
+  llvm::raw_string_ostream os(ir);
+  m.print(os, nullptr);
+  os.flush();
+
+  llvm::SHA1 hasher;
+  hasher.update(ir);
+  hasher.update(machine.getTargetTriple().str());
+  hasher.update(machine.getTargetCPU());
+  hasher.update(machine.getTargetFeatureString());
+  hasher.update(std::to_string(opt_level));
+  hasher.update(LLVM_VERSION_STRING);
+  return llvm::toHex(hasher.result(), /*LowerCase=*/true);
+}
+
+std::string PersistentObjectCache::GetObjectPath(const std::string& key) const {
+  llvm::SmallString<128> path(cache_dir_);
+  llvm::sys::path::append(path, key + kObjectSuffix);
+  return path.str().str();
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentObjectCache::Load(const std::string& key) {
+  auto path   = GetObjectPath(key);
+  auto buffer = llvm::MemoryBuffer::getFile(path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+  if (!buffer) {
+    ++misses_;
+    VLOG(3) << "Object " << key << " missed in the cache";
+    return nullptr;
+  }
+  ++hits_;
+  // refresh the modification time which is used as the recently used time on eviction
+  utime(path.c_str(), nullptr);
+  VLOG(3) << "Object " << key << " loaded from " << path;
+  return std::move(*buffer);
+}
+
+void PersistentObjectCache::Store(const std::string& key, llvm::StringRef object) {
+  auto path = GetObjectPath(key);
+  llvm::SmallString<128> tmp_path;
+  int fd  = -1;
+  auto ec = llvm::sys::fs::createUniqueFile(path + ".tmp-%%%%%%%%", fd, tmp_path);
+  if (ec) {
+    LOG(WARNING) << "Failed to create a temporary file for object " << key << ": " << ec.message();
+    return;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << object;
+    os.close();
+    if (os.has_error()) {
+      LOG(WARNING) << "Failed to write object " << key << " to " << tmp_path.str().str();
+      os.clear_error();
+      llvm::sys::fs::remove(tmp_path);
+      return;
+    }
+  }
+  ec = llvm::sys::fs::rename(tmp_path, path);
+  if (ec) {
+    LOG(WARNING) << "Failed to rename " << tmp_path.str().str() << " to " << path << ": " << ec.message();
+    llvm::sys::fs::remove(tmp_path);
+    return;
+  }
+  ++stores_;
+  VLOG(3) << "Object " << key << " stored to " << path;
+
+  if (max_size_bytes_ > 0) {
+    Evict();
+  }
+}
+
+void PersistentObjectCache::Evict() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  struct ObjectFile {
+    std::string path;
+    uint64_t size;
+    llvm::sys::TimePoint<> last_used;
+  };
+  std::vector<ObjectFile> objects;
+  uint64_t total_size = 0;
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(cache_dir_, ec), end; it != end && !ec; it.increment(ec)) {
+    if (!llvm::StringRef(it->path()).endswith(kObjectSuffix)) continue;
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(it->path(), status)) continue;
+    objects.push_back({it->path(), status.getSize(), status.getLastModificationTime()});
+    total_size += status.getSize();
+  }
+  if (total_size <= max_size_bytes_) return;
+
+  std::sort(objects.begin(), objects.end(), [](const ObjectFile& lhs, const ObjectFile& rhs) {
+    return lhs.last_used < rhs.last_used;
+  });
+  for (const auto& object : objects) {
+    if (total_size <= max_size_bytes_) break;
+    // the file may be removed by another process already
+    if (!llvm::sys::fs::remove(object.path)) {
+      ++evictions_;
+    }
+    total_size -= object.size;
+    VLOG(3) << "Evict object " << object.path;
+  }
+}
+
+}  // namespace cinn::backends
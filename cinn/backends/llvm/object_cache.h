@@ -0,0 +1,83 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+
+namespace cinn::backends {
+
+/**
+ * A content-addressed object cache persisted on disk, so the compiled objects can be reused across processes.
+ *
+ * Each object is stored in a file named by the hash of the LLVM module IR(before optimized), the target
+ * triple, the cpu name and features, the optimization level and the LLVM version. Files are written to a
+ * temporary file and then renamed, so processes sharing one directory never read a partially written object.
+ * When the total size exceeds the limit, the least recently used objects are evicted.
+ */
+class PersistentObjectCache {
+ public:
+  /**
+   * Constructor.
+   * @param cache_dir The directory to store objects, it will be created if not exists.
+   * @param max_size_bytes The total size limit of the stored objects, 0 means no limit.
+   */
+  PersistentObjectCache(const std::string& cache_dir, uint64_t max_size_bytes);
+
+  /**
+   * The global cache configured by FLAGS_cinn_jit_object_cache_dir and FLAGS_cinn_jit_object_cache_max_size,
+   * returns nullptr if the cache directory is not set.
+   */
+  static PersistentObjectCache* Global();
+
+  // Compute the key of the object compiled from module \p m by \p machine with \p opt_level
+  static std::string ComputeKey(const llvm::Module& m, const llvm::TargetMachine& machine, int opt_level);
+
+  // Load the object of \p key, returns nullptr if missed.
+  std::unique_ptr<llvm::MemoryBuffer> Load(const std::string& key);
+
+  // Store the object of \p key, and evict the least recently used objects if the size limit exceeded.
+  void Store(const std::string& key, llvm::StringRef object);
+
+  const std::string& cache_dir() const { return cache_dir_; }
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+  uint64_t stores() const { return stores_; }
+  uint64_t evictions() const { return evictions_; }
+
+ private:
+  std::string GetObjectPath(const std::string& key) const;
+  void Evict();
+
+  std::string cache_dir_;
+  uint64_t max_size_bytes_;
+  // serialize the eviction in this process, other processes may evict at the same time
+  // which is tolerated because removing a missing file is ignored
+  std::mutex mtx_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> stores_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
+
+}  // namespace cinn::backends
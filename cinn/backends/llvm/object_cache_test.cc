@@ -0,0 +1,95 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/backends/llvm/object_cache.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <string>
+
+namespace cinn::backends {
+
+std::string CreateCacheDir() {
+  llvm::SmallString<128> path;
+  CHECK(!llvm::sys::fs::createUniqueDirectory("cinn_object_cache", path));
+  return path.str().str();
+}
+
+TEST(PersistentObjectCache, StoreAndLoad) {
+  auto cache_dir = CreateCacheDir();
+  {
+    PersistentObjectCache cache(cache_dir, 0);
+    ASSERT_EQ(cache.Load("key0"), nullptr);
+    cache.Store("key0", "object0");
+    auto object = cache.Load("key0");
+    ASSERT_NE(object, nullptr);
+    ASSERT_EQ(object->getBuffer().str(), "object0");
+    ASSERT_EQ(cache.hits(), 1);
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.stores(), 1);
+  }
+  // objects are reused by another cache instance
+  PersistentObjectCache cache(cache_dir, 0);
+  auto object = cache.Load("key0");
+  ASSERT_NE(object, nullptr);
+  ASSERT_EQ(object->getBuffer().str(), "object0");
+  llvm::sys::fs::remove_directories(cache_dir);
+}
+
+TEST(PersistentObjectCache, Evict) {
+  auto cache_dir = CreateCacheDir();
+  PersistentObjectCache cache(cache_dir, 16);
+  cache.Store("key0", "01234567");
+  cache.Store("key1", "01234567");
+  ASSERT_EQ(cache.evictions(), 0);
+  cache.Store("key2", "01234567");
+  ASSERT_EQ(cache.evictions(), 1);
+  int num_remained = 0;
+  for (auto key : {"key0", "key1", "key2"}) {
+    num_remained += cache.Load(key) != nullptr;
+  }
+  ASSERT_EQ(num_remained, 2);
+  llvm::sys::fs::remove_directories(cache_dir);
+}
+
+TEST(PersistentObjectCache, ComputeKey) {
+  llvm::InitializeNativeTarget();
+  auto machine =
+      llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine());
+
+  llvm::LLVMContext ctx;
+  auto create_module = [&](const std::string& fn_name) {
+    auto m       = std::make_unique<llvm::Module>("module", ctx);
+    auto fn_type = llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), false);
+    auto fn      = llvm::Function::Create(fn_type, llvm::Function::ExternalLinkage, fn_name, m.get());
+    llvm::IRBuilder<> builder(llvm::BasicBlock::Create(ctx, "entry", fn));
+    builder.CreateRetVoid();
+    return m;
+  };
+
+  auto m0 = create_module("fn0");
+  auto m1 = create_module("fn1");
+  auto k0 = PersistentObjectCache::ComputeKey(*m0, *machine, 3);
+  ASSERT_EQ(k0, PersistentObjectCache::ComputeKey(*create_module("fn0"), *machine, 3));
+  ASSERT_NE(k0, PersistentObjectCache::ComputeKey(*m1, *machine, 3));
+  ASSERT_NE(k0, PersistentObjectCache::ComputeKey(*m0, *machine, 2));
+}
+
+}  // namespace cinn::backends
@@ -0,0 +1,150 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/common/cpu_info.h"
+
+#include <glog/logging.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Host.h>
+#include <unistd.h>
+
+#include <sstream>
+
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace common {
+
+namespace {
+constexpr int kNumFeatures = static_cast<int>(CpuInfo::Feature::AMXBF16) + 1;
+
+int CacheSize(int name) {
+  long size = sysconf(name);  // NOLINT
+  return size > 0 ? static_cast<int>(size) : 0;
+}
+}  // namespace
+
+CpuInfo::CpuInfo(const std::string& name,
+                 const std::vector<Feature>& features,
+                 int l1_cache_size,
+                 int l2_cache_size,
+                 int l3_cache_size)
+    : name(name), l1_cache_size(l1_cache_size), l2_cache_size(l2_cache_size), l3_cache_size(l3_cache_size) {
+  for (auto feature : features) {
+    feature_bits_ |= 1u << static_cast<int>(feature);
+  }
+}
+
+std::vector<CpuInfo::Feature> CpuInfo::features() const {
+  std::vector<Feature> res;
+  for (int i = 0; i < kNumFeatures; ++i) {
+    if (Has(static_cast<Feature>(i))) {
+      res.push_back(static_cast<Feature>(i));
+    }
+  }
+  return res;
+}
+
+int CpuInfo::vector_bits() const {
+  if (Has(Feature::AVX512F)) {
+    return 512;
+  } else if (Has(Feature::AVX)) {
+    return 256;
+  } else if (Has(Feature::SSE4_2)) {
+    return 128;
+  }
+  return 0;
+}
+
+std::string CpuInfo::LLVMFeatures() const {
+  std::vector<std::string> res;
+  for (int i = 0; i < kNumFeatures; ++i) {
+    auto feature = static_cast<Feature>(i);
+    res.push_back((Has(feature) ? "+" : "-") + FeatureName(feature));
+  }
+  return utils::Join(res, ",");
+}
+
+std::string CpuInfo::FeatureName(Feature feature) {
+  switch (feature) {
+    case Feature::SSE4_2:
+      return "sse4.2";
+    case Feature::AVX:
+      return "avx";
+    case Feature::AVX2:
+      return "avx2";
+    case Feature::FMA:
+      return "fma";
+    case Feature::AVX512F:
+      return "avx512f";
+    case Feature::AVX512CD:
+      return "avx512cd";
+    case Feature::AVX512BW:
+      return "avx512bw";
+    case Feature::AVX512DQ:
+      return "avx512dq";
+    case Feature::AVX512VL:
+      return "avx512vl";
+    case Feature::AVX512VNNI:
+      return "avx512vnni";
+    case Feature::AVX512BF16:
+      return "avx512bf16";
+    case Feature::AMXTile:
+      return "amx-tile";
+    case Feature::AMXInt8:
+      return "amx-int8";
+    case Feature::AMXBF16:
+      return "amx-bf16";
+  }
+  LOG(FATAL) << "Unknown CPU feature " << static_cast<int>(feature);
+  return "";
+}
+
+CpuInfo CpuInfo::DetectHost() {
+  // LLVM checks both the CPUID and whether the OS saves the states of the AVX-512 and AMX registers
+  llvm::StringMap<bool> host_features;
+  std::vector<Feature> features;
+  if (llvm::sys::getHostCPUFeatures(host_features)) {
+    for (int i = 0; i < kNumFeatures; ++i) {
+      auto it = host_features.find(FeatureName(static_cast<Feature>(i)));
+      if (it != host_features.end() && it->getValue()) {
+        features.push_back(static_cast<Feature>(i));
+      }
+    }
+  }
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+  CpuInfo cpu(llvm::sys::getHostCPUName().str(),
+              features,
+              CacheSize(_SC_LEVEL1_DCACHE_SIZE),
+              CacheSize(_SC_LEVEL2_CACHE_SIZE),
+              CacheSize(_SC_LEVEL3_CACHE_SIZE));
+#else
+  CpuInfo cpu(llvm::sys::getHostCPUName().str(), features);
+#endif
+  VLOG(1) << "The CPU of the host: " << cpu;
+  return cpu;
+}
+
+std::ostream& operator<<(std::ostream& os, const CpuInfo& cpu) {
+  std::vector<std::string> features;
+  for (auto feature : cpu.features()) {
+    features.push_back(CpuInfo::FeatureName(feature));
+  }
+  os << "CpuInfo<" << (cpu.name.empty() ? "unk" : cpu.name) << ",[" << utils::Join(features, ",")
+     << "],L1=" << cpu.l1_cache_size << ",L2=" << cpu.l2_cache_size << ",L3=" << cpu.l3_cache_size << ">";
+  return os;
+}
+
+}  // namespace common
+}  // namespace cinn
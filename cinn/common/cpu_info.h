@@ -0,0 +1,95 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cinn {
+namespace common {
+
+/**
+ * The instruction set extensions and the cache sizes of a x86 CPU.
+ *
+ * DefaultHostTarget() holds the ones of the host detected at startup. The features decide the CPU and the features
+ * given to LLVM and the vector width of the generated code, the features and the cache sizes decide the micro-kernel
+ * and the blocking of the host gemm. A default constructed CpuInfo is unknown, and the consumers fall back to their
+ * previous defaults on it.
+ */
+struct CpuInfo {
+  enum class Feature : int {
+    SSE4_2 = 0,
+    AVX,
+    AVX2,
+    FMA,
+    AVX512F,
+    AVX512CD,
+    AVX512BW,
+    AVX512DQ,
+    AVX512VL,
+    AVX512VNNI,
+    AVX512BF16,
+    AMXTile,
+    AMXInt8,
+    AMXBF16,
+  };
+
+  //! The name of the CPU known by LLVM, such as "skylake-avx512", empty if unknown.
+  std::string name;
+  //! The sizes of the caches in bytes, 0 if unknown, they decide the blocking of the host gemm.
+  int l1_cache_size{0};
+  int l2_cache_size{0};
+  int l3_cache_size{0};
+
+  CpuInfo() = default;
+  CpuInfo(const std::string& name,
+          const std::vector<Feature>& features,
+          int l1_cache_size = 0,
+          int l2_cache_size = 0,
+          int l3_cache_size = 0);
+
+  bool defined() const { return !name.empty() || feature_bits_ != 0; }
+
+  bool Has(Feature feature) const { return feature_bits_ & (1u << static_cast<int>(feature)); }
+
+  std::vector<Feature> features() const;
+
+  //! The bits of the widest vector registers, 512 with AVX-512, 256 with AVX and 128 with SSE, 0 if unknown.
+  int vector_bits() const;
+
+  //! The features in the format of LLVM, such as "+avx2,+fma,-avx512f", every known feature is listed.
+  std::string LLVMFeatures() const;
+
+  //! The name of the feature in LLVM, such as "avx512vnni".
+  static std::string FeatureName(Feature feature);
+
+  //! Detect the CPU of the host.
+  static CpuInfo DetectHost();
+
+  bool operator==(const CpuInfo& other) const {
+    return name == other.name && feature_bits_ == other.feature_bits_ && l1_cache_size == other.l1_cache_size &&
+           l2_cache_size == other.l2_cache_size && l3_cache_size == other.l3_cache_size;
+  }
+  bool operator!=(const CpuInfo& other) const { return !(*this == other); }
+  friend std::ostream& operator<<(std::ostream& os, const CpuInfo& cpu);
+
+ private:
+  uint32_t feature_bits_{0};
+};
+
+}  // namespace common
+}  // namespace cinn
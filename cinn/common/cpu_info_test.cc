@@ -0,0 +1,130 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/common/cpu_info.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/multi_level_tiling.h"
+#include "cinn/backends/codegen_c_x86.h"
+#include "cinn/backends/llvm/llvm_util.h"
+#include "cinn/common/target.h"
+#include "cinn/hlir/pe/schedule.h"
+
+namespace cinn {
+namespace common {
+
+using Feature = CpuInfo::Feature;
+
+CpuInfo Avx2Cpu() { return CpuInfo("haswell", {Feature::SSE4_2, Feature::AVX, Feature::AVX2, Feature::FMA}); }
+
+CpuInfo Avx512Cpu() {
+  return CpuInfo("cascadelake",
+                 {Feature::SSE4_2,
+                  Feature::AVX,
+                  Feature::AVX2,
+                  Feature::FMA,
+                  Feature::AVX512F,
+                  Feature::AVX512CD,
+                  Feature::AVX512BW,
+                  Feature::AVX512DQ,
+                  Feature::AVX512VL,
+                  Feature::AVX512VNNI},
+                 32 * 1024,
+                 1024 * 1024,
+                 32 * 1024 * 1024);
+}
+
+Target HostWithCpu(const CpuInfo& cpu) {
+  Target target = DefaultHostTarget();
+  target.cpu    = cpu;
+  return target;
+}
+
+TEST(CpuInfo, features) {
+  CpuInfo unknown;
+  ASSERT_FALSE(unknown.defined());
+  ASSERT_EQ(unknown.vector_bits(), 0);
+
+  auto avx2 = Avx2Cpu();
+  ASSERT_TRUE(avx2.defined());
+  ASSERT_TRUE(avx2.Has(Feature::FMA));
+  ASSERT_FALSE(avx2.Has(Feature::AVX512F));
+  ASSERT_EQ(avx2.vector_bits(), 256);
+  ASSERT_EQ(avx2.features().size(), 4UL);
+  ASSERT_EQ(avx2.LLVMFeatures(),
+            "+sse4.2,+avx,+avx2,+fma,-avx512f,-avx512cd,-avx512bw,-avx512dq,-avx512vl,-avx512vnni,-avx512bf16,"
+            "-amx-tile,-amx-int8,-amx-bf16");
+
+  auto avx512 = Avx512Cpu();
+  ASSERT_TRUE(avx512.Has(Feature::AVX512VNNI));
+  ASSERT_FALSE(avx512.Has(Feature::AMXTile));
+  ASSERT_EQ(avx512.vector_bits(), 512);
+  ASSERT_EQ(avx512.l2_cache_size, 1024 * 1024);
+
+  ASSERT_EQ(CpuInfo("", {Feature::SSE4_2}).vector_bits(), 128);
+  ASSERT_NE(avx2, avx512);
+  ASSERT_EQ(avx512, Avx512Cpu());
+}
+
+TEST(CpuInfo, host) {
+  auto host = CpuInfo::DetectHost();
+  LOG(INFO) << host;
+  ASSERT_EQ(DefaultHostTarget().cpu, host);
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  ASSERT_EQ(host.Has(Feature::AVX2), static_cast<bool>(__builtin_cpu_supports("avx2")));
+  ASSERT_EQ(host.Has(Feature::AVX512F), static_cast<bool>(__builtin_cpu_supports("avx512f")));
+#endif
+}
+
+TEST(CpuInfo, target) {
+  // the CPU doesn't take part in the comparison of targets
+  ASSERT_EQ(HostWithCpu(Avx2Cpu()), DefaultHostTarget());
+  ASSERT_EQ(HostWithCpu(CpuInfo()).get_native_vector_bits(), 512);
+  ASSERT_EQ(HostWithCpu(Avx2Cpu()).get_native_vector_bits(), 256);
+  ASSERT_EQ(HostWithCpu(Avx512Cpu()).get_native_vector_bits(), 512);
+
+  ASSERT_EQ(hlir::pe::GetBasicFactor(Float(32), HostWithCpu(CpuInfo())), 16);
+  ASSERT_EQ(hlir::pe::GetBasicFactor(Float(32), HostWithCpu(Avx2Cpu())), 8);
+  ASSERT_EQ(hlir::pe::GetBasicFactor(Float(32), HostWithCpu(Avx512Cpu())), 16);
+  ASSERT_EQ(hlir::pe::GetBasicFactor(Float(64), HostWithCpu(Avx2Cpu())), 4);
+}
+
+TEST(CpuInfo, codegen) {
+  using backends::CodeGenCX86;
+  auto feature_of = [](const CpuInfo& cpu) { return static_cast<int>(CodeGenCX86::GetFeature(HostWithCpu(cpu))); };
+  int sse         = static_cast<int>(CodeGenCX86::Feature::SSE);
+  int avx256      = static_cast<int>(CodeGenCX86::Feature::AVX256);
+  int avx512      = static_cast<int>(CodeGenCX86::Feature::AVX512);
+  ASSERT_EQ(feature_of(CpuInfo()), avx512);
+  ASSERT_EQ(feature_of(Avx2Cpu()), sse | avx256);
+  ASSERT_EQ(feature_of(Avx512Cpu()), sse | avx256 | avx512);
+
+  auto machine = backends::CreateTargetMachine(Avx2Cpu());
+  ASSERT_EQ(machine->getTargetCPU().str(), "haswell");
+  auto features = machine->getTargetFeatureString().str();
+  ASSERT_NE(features.find("+avx2"), std::string::npos);
+  ASSERT_NE(features.find("-avx512f"), std::string::npos);
+}
+
+TEST(CpuInfo, multi_level_tiling) {
+  using auto_schedule::MultiLevelTiling;
+  ASSERT_EQ(MultiLevelTiling::DefaultConfig(HostWithCpu(CpuInfo())).max_innermost_factor, 64);
+  ASSERT_EQ(MultiLevelTiling::DefaultConfig(HostWithCpu(Avx2Cpu())).max_innermost_factor, 32);
+  ASSERT_EQ(MultiLevelTiling::DefaultConfig(HostWithCpu(Avx512Cpu())).max_innermost_factor, 64);
+}
+
+}  // namespace common
+}  // namespace cinn
@@ -100,6 +100,11 @@ int Target::get_target_bits() const {
   return -1;
 }
 
+int Target::get_native_vector_bits() const {
+  // keep 8 times of the target bits as before if the CPU is unknown
+  return cpu.vector_bits() > 0 ? cpu.vector_bits() : get_target_bits() * 8;
+}
+
 std::string Target::arch_str() const {
   std::ostringstream oss;
   oss << arch;
@@ -177,7 +182,11 @@ const Target &UnkTarget() {
   return target;
 }
 const Target &DefaultHostTarget() {
-  static Target target(Target::OS::Linux, Target::Arch::X86, Target::Bit::k64, {}, {});
+  static Target target = []() {
+    Target host(Target::OS::Linux, Target::Arch::X86, Target::Bit::k64, {}, {});
+    host.cpu = CpuInfo::DetectHost();
+    return host;
+  }();
   return target;
 }
 
@@ -18,6 +18,8 @@
 #include <string>
 #include <vector>
 
+#include "cinn/common/cpu_info.h"
+
 namespace cinn {
 namespace common {
 
@@ -65,6 +67,8 @@ struct Target {
   };
   std::vector<Feature> features;
   std::vector<Lib> libs;
+  //! The CPU of a X86 target, which tunes the generated code but doesn't take part in the comparison of targets.
+  CpuInfo cpu;
 
   explicit Target(OS o                                 = OS::Linux,
                   Arch a                               = Arch::Unk,
@@ -88,6 +92,9 @@ struct Target {
 
   int get_target_bits() const;
 
+  //! The bits of the native vector registers, of the CPU if it is known.
+  int get_native_vector_bits() const;
+
   std::vector<Lib> get_target_libs() const;
 
   std::string arch_str() const;
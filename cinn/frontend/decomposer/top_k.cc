@@ -12,8 +12,17 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <gflags/gflags.h>
+
+#include <algorithm>
+
 #include "cinn/frontend/decomposer_registry.h"
 #include "cinn/frontend/syntax.h"
+#include "cinn/hlir/op/external_api_registry.h"
+#include "cinn/utils/string.h"
+
+DECLARE_bool(cinn_use_custom_call);
+DECLARE_string(cinn_custom_call_deny_ops);
 
 namespace cinn {
 namespace frontend {
@@ -44,11 +53,26 @@ void top_k(const Instruction& instr, const DecomposerContext& context) {
   context.MapOutToOrigin(argsort_out, indices);
 }
 
+// On x86, top_k is kept as it is to be replaced by the custom_call selecting the k entries in one pass, rather than
+// sorting the whole axis twice, unless custom_call is disabled for top_k or the host kernel does not support the dtype
+// of the input, in which case TransToCustomCallPass would leave top_k to a compute that does not exist.
+void top_k_host(const Instruction& instr, const DecomposerContext& context) {
+  auto deny_ops        = utils::Split(FLAGS_cinn_custom_call_deny_ops, ";");
+  const auto& sortable = hlir::op::HostSortableTypes();
+  if (FLAGS_cinn_use_custom_call && std::find(deny_ops.begin(), deny_ops.end(), "top_k") == deny_ops.end() &&
+      std::find(sortable.begin(), sortable.end(), instr->inputs[0]->type) != sortable.end()) {
+    context.builder()->AppendInstruction(instr);
+    return;
+  }
+  top_k(instr, context);
+}
+
 }  // namespace decomposer
 }  // namespace frontend
 }  // namespace cinn
 
 CINN_REGISTER_HELPER(top_k_decomposer) {
-  CINN_DECOMPOSER_REGISTER(top_k, cinn::frontend::decomposer::top_k);
+  CINN_DECOMPOSER_REGISTER(top_k, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::top_k);
+  CINN_DECOMPOSER_REGISTER(top_k, ::cinn::common::DefaultHostTarget(), cinn::frontend::decomposer::top_k_host);
   return true;
 }
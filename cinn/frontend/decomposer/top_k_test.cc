@@ -14,6 +14,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_set>
+
 #include "cinn/frontend/decomposer/test_helper.h"
 
 namespace cinn::frontend {
@@ -21,9 +26,10 @@ namespace cinn::frontend {
 TEST(Decomposer, top_k_decomposer) {
   NetBuilder net_builder("top_k_decomposer");
   std::unordered_set<std::string> output_names;
+  std::vector<Variable> y;
   {
     auto x = net_builder.CreateInput(Float(32), {10, 5}, "x");
-    auto y = net_builder.TopK(x, 1, -1, true);
+    y      = net_builder.TopK(x, 2, -1, true);
     output_names.insert(y[0]->id);
     output_names.insert(y[1]->id);
   }
@@ -33,6 +39,8 @@ TEST(Decomposer, top_k_decomposer) {
   RunDecomposer(&program, target);
 
   auto graph = std::make_shared<hlir::framework::Graph>(program, output_names, target);
+  // on x86 top_k is not decomposed but replaced by custom_call
+  hlir::framework::ApplyPass(graph.get(), "TransToCustomCallPass");
   hlir::framework::ApplyPass(graph.get(), "OpFusionPass");
   hlir::framework::ApplyPass(graph.get(), "FusionMergePass");
 
@@ -50,6 +58,41 @@ TEST(Decomposer, top_k_decomposer) {
     CopyFromVector(input.second, tensor, target);
   }
   run_program->Execute();
+
+  std::vector<float> values;
+  std::vector<int64_t> indices;
+  CopyToVector(scope->GetTensor(y[0]->id), &values);
+  CopyToVector(scope->GetTensor(y[1]->id), &indices);
+  ASSERT_EQ(values.size(), 10 * 2);
+  ASSERT_EQ(indices.size(), 10 * 2);
+  for (int i = 0; i < 10; ++i) {
+    std::vector<float> row(x.begin() + i * 5, x.begin() + (i + 1) * 5);
+    std::sort(row.begin(), row.end(), std::greater<float>());
+    for (int j = 0; j < 2; ++j) {
+      ASSERT_EQ(values[i * 2 + j], row[j]);
+      ASSERT_EQ(x[i * 5 + indices[i * 2 + j]], values[i * 2 + j]);
+    }
+  }
+}
+
+TEST(Decomposer, top_k_decomposer_unsupported_dtype) {
+  // the host top_k kernel does not dispatch on int8, so top_k is decomposed into sort and argsort rather than left
+  // to a custom_call that TransToCustomCallPass would not create
+  NetBuilder net_builder("top_k_decomposer_unsupported_dtype");
+  auto x = net_builder.CreateInput(Int(8), {10, 5}, "x");
+  net_builder.TopK(x, 2, -1, true);
+  auto program = net_builder.Build();
+
+  auto target = common::DefaultHostTarget();
+  RunDecomposer(&program, target);
+
+  std::unordered_set<std::string> op_types;
+  for (int i = 0; i < program.size(); ++i) {
+    op_types.insert(program[i]->op_type);
+  }
+  ASSERT_EQ(op_types.count("top_k"), 0UL);
+  ASSERT_EQ(op_types.count("sort"), 1UL);
+  ASSERT_EQ(op_types.count("argsort"), 1UL);
 }
 
 }  // namespace cinn::frontend
@@ -100,9 +100,7 @@ OptimizeOptions DefaultTrainingOptimizeOptions() {
     options.graph_passes.emplace_back("BuildNonFusedGroupsPass");
   }
 
-#ifdef CINN_WITH_CUDA
   options.graph_passes.emplace_back("SingleGroupOptimizePass");
-#endif
 
   // WARNING: the pass must be the last pass !!!
   if (!cinn::runtime::CheckStringFlagFalse(FLAGS_cinn_check_fusion_accuracy_pass)) {
@@ -18,7 +18,7 @@ namespace cinn {
 namespace hlir {
 namespace framework {
 
-void Buffer::Resize(uint32_t size) {
+void Buffer::Resize(uint64_t size) {
   if (size_ > 0) {
     Free();
     size_ = 0;
@@ -31,7 +31,7 @@ void Buffer::Resize(uint32_t size) {
   }
 }
 
-void Buffer::Resize(uint32_t alignment, uint32_t size) {
+void Buffer::Resize(uint32_t alignment, uint64_t size) {
   if (size_ > 0) {
     Free();
     size_ = 0;
@@ -49,17 +49,28 @@ void Buffer::SetTarget(const common::Target& target) {
   memory_mng_cache_ = MemoryManager::Global().RetrieveSafely(target_.arch);
 }
 
-void Buffer::ResizeLazy(uint32_t size) {
+void Buffer::ShareMemory(const std::shared_ptr<Buffer>& owner, uint64_t offset, uint64_t size) {
+  CHECK(owner.get() != this) << "A buffer can't share the memory of itself";
+  CHECK_LE(offset + size, owner->size_) << "The shared memory is out of the range of its owner";
+  Free();
+  SetTarget(owner->target_);
+  memory_owner_     = owner;
+  data_.memory      = owner->data_.memory + offset;
+  data_.memory_size = size;
+  size_             = size;
+}
+
+void Buffer::ResizeLazy(uint64_t size) {
   if (size <= size_) return;
   Resize(size);
 }
 
-void Buffer::ResizeLazy(uint32_t alignment, uint32_t size) {
+void Buffer::ResizeLazy(uint32_t alignment, uint64_t size) {
   if (size <= size_) return;
   Resize(alignment, size);
 }
 
-void Buffer::Resize(uint32_t size, const common::Target& target) {
+void Buffer::Resize(uint64_t size, const common::Target& target) {
   if (target.arch != target_.arch) {
     Free();
     SetTarget(target);
@@ -67,7 +78,7 @@ void Buffer::Resize(uint32_t size, const common::Target& target) {
   Resize(size);
 }
 
-void Buffer::Resize(uint32_t alignment, uint32_t size, const common::Target& target) {
+void Buffer::Resize(uint32_t alignment, uint64_t size, const common::Target& target) {
   if (target.arch != target_.arch) {
     Free();
     SetTarget(target);
@@ -75,7 +86,7 @@ void Buffer::Resize(uint32_t alignment, uint32_t size, const common::Target& tar
   Resize(alignment, size);
 }
 
-void Buffer::ResizeLazy(uint32_t size, const common::Target& target) {
+void Buffer::ResizeLazy(uint64_t size, const common::Target& target) {
   if (target.arch != target_.arch) {
     Free();
     SetTarget(target);
@@ -83,7 +94,7 @@ void Buffer::ResizeLazy(uint32_t size, const common::Target& target) {
   ResizeLazy(size);
 }
 
-void Buffer::ResizeLazy(uint32_t alignment, uint32_t size, const common::Target& target) {
+void Buffer::ResizeLazy(uint32_t alignment, uint64_t size, const common::Target& target) {
   if (target.arch != target_.arch) {
     Free();
     SetTarget(target);
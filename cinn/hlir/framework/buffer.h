@@ -36,39 +36,52 @@ struct Buffer final {
   explicit Buffer(const common::Target& target) { SetTarget(target); }
   ~Buffer() { Free(); }
   //! Resize the memory hold by this buffer *exactlly* to \p size.
-  void Resize(uint32_t size);
-  void Resize(uint32_t alignment, uint32_t size);
+  void Resize(uint64_t size);
+  void Resize(uint32_t alignment, uint64_t size);
 
   //! Lazily resize the memory.
-  void ResizeLazy(uint32_t size);
-  void ResizeLazy(uint32_t alignment, uint32_t size);
+  void ResizeLazy(uint64_t size);
+  void ResizeLazy(uint32_t alignment, uint64_t size);
 
   //! Resize the memory to \p size in target \p target.
-  void Resize(uint32_t size, const common::Target& target);
-  void Resize(uint32_t alignment, uint32_t size, const common::Target& target);
+  void Resize(uint64_t size, const common::Target& target);
+  void Resize(uint32_t alignment, uint64_t size, const common::Target& target);
 
   //! Lazily resize the memory to \p size in target \p target.
-  void ResizeLazy(uint32_t size, const common::Target& target);
-  void ResizeLazy(uint32_t alignment, uint32_t size, const common::Target& target);
+  void ResizeLazy(uint64_t size, const common::Target& target);
+  void ResizeLazy(uint32_t alignment, uint64_t size, const common::Target& target);
 
   void SetTarget(const common::Target& target);
 
+  //! Use the \p size bytes memory starting at \p offset of \p owner instead of allocating, the memory won't be
+  //! freed by this buffer and \p owner is kept alive as long as the memory used.
+  void ShareMemory(const std::shared_ptr<Buffer>& owner, uint64_t offset, uint64_t size);
+
+  //! Number of bytes of the memory hold by this buffer.
+  uint64_t size() const { return size_; }
+
   const cinn_buffer_t* data() const { return &data_; }
   cinn_buffer_t* data() { return &data_; }
 
   //! Free all the memory owned by this buffer.
   void Free() {
     if (!data_.memory) return;
+    if (memory_owner_) {
+      memory_owner_.reset();
+      data_.memory = nullptr;
+      size_        = 0;
+      return;
+    }
     memory_mng_cache_->free(data_.memory);
   }
 
  private:
-  inline void* Malloc(uint32_t size) CINN_RESULT_SHOULD_USE {
+  inline void* Malloc(uint64_t size) CINN_RESULT_SHOULD_USE {
     CHECK(memory_mng_cache_) << "Should set target first";
     return memory_mng_cache_->malloc(size);
   }
 
-  inline void* AlignedAlloc(uint32_t alignment, uint32_t size) CINN_RESULT_SHOULD_USE {
+  inline void* AlignedAlloc(uint32_t alignment, uint64_t size) CINN_RESULT_SHOULD_USE {
     CHECK(memory_mng_cache_) << "Should set target first";
     return memory_mng_cache_->aligned_alloc(alignment, size);
   }
@@ -80,10 +93,13 @@ struct Buffer final {
   common::Target target_;
 
   //! Number of bytes of this buffer.
-  uint32_t size_{};
+  uint64_t size_{};
 
   //! Hold the corresponding memory manager for speed.
   MemoryInterface* memory_mng_cache_{};
+
+  //! The buffer owning the memory if shared from others.
+  std::shared_ptr<Buffer> memory_owner_;
 };
 
 }  // namespace framework
@@ -18,8 +18,13 @@
 #endif
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <vector>
 
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/optimize.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+
 namespace cinn {
 namespace hlir {
 namespace framework {
@@ -31,6 +36,57 @@ TEST(Buffer, basic) {
   for (int i = 0; i < 10; i++) data[i] = i;
 }
 
+TEST(Buffer, LargerThan4GB) {
+  const uint64_t size = (5UL << 30) + 3;
+  Buffer buffer(common::DefaultHostTarget());
+  buffer.Resize(1024, size);
+  ASSERT_EQ(buffer.size(), size);
+  ASSERT_EQ(buffer.data()->memory_size, size);
+  auto* data     = buffer.data()->memory;
+  data[0]        = 1;
+  data[size - 1] = 2;
+  ASSERT_EQ(data[size - 1], 2);
+}
+
+// The tensors take more than 4GB of memory, so the test is disabled by default and runs
+// only with --gtest_also_run_disabled_tests
+TEST(Buffer, DISABLED_ElementwiseMoreThan2GElements) {
+  // each tensor holds more than 2^31 int8 elements, which can't be indexed by int32
+  const int rows = 1 << 21, cols = 1025;
+  frontend::NetBuilder builder("large_elementwise");
+  auto x       = builder.CreateInput(Int(8), {rows, cols}, "x");
+  auto out     = builder.Scale(x, 2.0f, 1.0f);
+  auto target  = common::DefaultHostTarget();
+  auto program = builder.Build();
+  auto graph   = frontend::Optimize(&program, {out->id}, target);
+  auto scope   = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto runtime_program               = gc.Build(options, {out->id}).runtime_program;
+
+  auto x_tensor   = scope->GetTensor("x");
+  auto out_tensor = scope->GetTensor(out->id);
+  uint64_t numel  = x_tensor->shape().numel();
+  ASSERT_EQ(numel, uint64_t(rows) * cols);
+  ASSERT_GT(numel, 1UL << 31);
+
+  // only touch a few positions beyond the range of int32, the others are left as allocated
+  const std::vector<uint64_t> positions = {1UL << 31, numel - 2, numel - 1};
+  auto* x_data                          = x_tensor->mutable_data<int8_t>(target);
+  for (int i = 0; i < positions.size(); ++i) {
+    x_data[positions[i]] = i + 1;
+  }
+  runtime_program->Execute();
+
+  const auto* out_data = out_tensor->data<int8_t>();
+  ASSERT_EQ(out_tensor->get_buffer()->size(), numel);
+  for (int i = 0; i < positions.size(); ++i) {
+    ASSERT_EQ(out_data[positions[i]], 2 * (i + 1) + 1) << "at position " << positions[i];
+  }
+}
+
 #ifdef CINN_WITH_CUDA
 TEST(Buffer, nvgpu) {
   const int num_elements = 10;
@@ -0,0 +1,321 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/caching_allocator.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+// the floor of log2(x), x should be greater than 0
+constexpr int FloorLog2(size_t x) { return 63 - __builtin_clzll(static_cast<uint64_t>(x)); }
+
+constexpr size_t AlignUp(size_t x, size_t alignment) { return (x + alignment - 1) & ~(alignment - 1); }
+
+inline bool IsAligned(void* ptr, size_t alignment) { return reinterpret_cast<uintptr_t>(ptr) % alignment == 0; }
+
+// the index of a size class not larger than kMaxSmallBlockSize, classes are:
+// 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, ...
+constexpr int SmallSizeClassIndex(size_t block_size) {
+  return block_size <= CachingAllocator::kMinAlignment
+             ? 0
+             : (FloorLog2(block_size - 1) - 6) * 4 +
+                   static_cast<int>(block_size >> (FloorLog2(block_size - 1) - 2)) - 4;
+}
+
+constexpr int kNumSmallSizeClasses = SmallSizeClassIndex(CachingAllocator::kMaxSmallBlockSize) + 1;
+
+// a cached large block is reused only if the wasted bytes are less than a quarter of the request
+inline size_t MaxReusedLargeBlockSize(size_t block_size) { return block_size + block_size / 4; }
+}  // namespace
+
+size_t CachingAllocator::RoundUpSize(size_t nbytes) {
+  if (nbytes <= kMinAlignment) return kMinAlignment;
+  int shift   = FloorLog2(nbytes - 1);
+  size_t step = size_t(1) << (shift - 2);
+  return AlignUp(nbytes, step);
+}
+
+class CachingAllocator::State : public std::enable_shared_from_this<CachingAllocator::State> {
+ public:
+  explicit State(uint64_t max_cached_bytes) : max_cached_bytes_(max_cached_bytes) {}
+
+  void* Allocate(size_t alignment, size_t nbytes);
+  void Deallocate(void* data);
+  void ReleaseThreadCache();
+  void ReleaseAllThreadCaches();
+  void ReleaseArena();
+  Stats GetStats() const;
+
+ private:
+  struct BlockInfo {
+    size_t block_size;
+    size_t requested;
+  };
+
+  // the freed small blocks cached by one thread, it is registered in the state, so the blocks
+  // are released either by the thread at exit or by the allocator at destruction
+  struct ThreadCache {
+    explicit ThreadCache(std::shared_ptr<State> s) : state(std::move(s)), free_lists(kNumSmallSizeClasses) {
+      std::lock_guard<std::mutex> lock(state->thread_caches_mtx_);
+      state->thread_caches_.insert(this);
+    }
+    ~ThreadCache() {
+      std::lock_guard<std::mutex> lock(state->thread_caches_mtx_);
+      state->thread_caches_.erase(this);
+      Release();
+    }
+
+    void Release() {
+      for (int idx = 0; idx < free_lists.size(); ++idx) {
+        for (void* ptr : free_lists[idx]) {
+          state->ReturnToSystem(ptr, state->small_block_size_[idx]);
+          state->cached_bytes_ -= state->small_block_size_[idx];
+        }
+        free_lists[idx].clear();
+      }
+    }
+
+    std::shared_ptr<State> state;
+    std::vector<std::vector<void*>> free_lists;
+  };
+
+  // shard the block table by address to reduce the lock contention
+  struct Shard {
+    std::mutex mtx;
+    absl::flat_hash_map<void*, BlockInfo> blocks;
+  };
+  static constexpr int kNumShards = 16;
+
+  Shard& GetShard(void* ptr) {
+    auto addr = reinterpret_cast<uintptr_t>(ptr);
+    return shards_[((addr >> 6) ^ (addr >> 12)) % kNumShards];
+  }
+
+  ThreadCache* GetThreadCache();
+  void* AllocateFromSystem(size_t alignment, size_t block_size);
+  void ReturnToSystem(void* ptr, size_t block_size);
+  void UpdatePeak(uint64_t allocated);
+
+  const uint64_t max_cached_bytes_;
+  std::vector<size_t> small_block_size_ = ComputeSmallBlockSizes();
+
+  Shard shards_[kNumShards];
+
+  std::mutex thread_caches_mtx_;
+  absl::flat_hash_set<ThreadCache*> thread_caches_;
+
+  std::mutex arena_mtx_;
+  // the freed large blocks ordered by size for best fit
+  std::multimap<size_t, void*> free_large_blocks_;
+
+  std::atomic<uint64_t> allocated_bytes_{0};
+  std::atomic<uint64_t> peak_allocated_bytes_{0};
+  std::atomic<uint64_t> in_use_block_bytes_{0};
+  std::atomic<uint64_t> cached_bytes_{0};
+  std::atomic<uint64_t> reserved_bytes_{0};
+  std::atomic<uint64_t> cache_hits_{0};
+  std::atomic<uint64_t> cache_misses_{0};
+
+  static std::vector<size_t> ComputeSmallBlockSizes() {
+    std::vector<size_t> sizes;
+    for (size_t size = kMinAlignment; size <= kMaxSmallBlockSize; size = RoundUpSize(size + 1)) {
+      sizes.push_back(size);
+    }
+    CHECK_EQ(sizes.size(), kNumSmallSizeClasses);
+    return sizes;
+  }
+};
+
+CachingAllocator::State::ThreadCache* CachingAllocator::State::GetThreadCache() {
+  // a thread may use several allocators, so the caches are indexed by their states
+  thread_local absl::flat_hash_map<const State*, std::unique_ptr<ThreadCache>> thread_caches;
+  auto& cache = thread_caches[this];
+  if (!cache) {
+    cache.reset(new ThreadCache(shared_from_this()));
+  }
+  return cache.get();
+}
+
+void* CachingAllocator::State::AllocateFromSystem(size_t alignment, size_t block_size) {
+  void* ptr = ::aligned_alloc(alignment, block_size);
+  if (!ptr) {
+    // retry after returning the cached blocks
+    ReleaseThreadCache();
+    ReleaseArena();
+    ptr = ::aligned_alloc(alignment, block_size);
+  }
+  CHECK(ptr) << "Failed to allocate " << block_size << " bytes with alignment " << alignment;
+  reserved_bytes_ += block_size;
+  return ptr;
+}
+
+void CachingAllocator::State::ReturnToSystem(void* ptr, size_t block_size) {
+  ::free(ptr);
+  reserved_bytes_ -= block_size;
+}
+
+void CachingAllocator::State::UpdatePeak(uint64_t allocated) {
+  uint64_t peak = peak_allocated_bytes_.load(std::memory_order_relaxed);
+  while (allocated > peak && !peak_allocated_bytes_.compare_exchange_weak(peak, allocated)) {
+  }
+}
+
+void* CachingAllocator::State::Allocate(size_t alignment, size_t nbytes) {
+  CHECK_EQ(alignment & (alignment - 1), 0) << "alignment should be a power of two, but got " << alignment;
+  alignment         = std::max(alignment, kMinAlignment);
+  size_t block_size = RoundUpSize(std::max(nbytes, alignment));
+  // aligned_alloc requires the size to be a multiple of the alignment, and the
+  // aligned size of a size class is still a size class
+  block_size = AlignUp(block_size, alignment);
+
+  void* ptr = nullptr;
+  if (block_size <= kMaxSmallBlockSize) {
+    auto& free_list = GetThreadCache()->free_lists[SmallSizeClassIndex(block_size)];
+    for (auto it = free_list.rbegin(); it != free_list.rend(); ++it) {
+      if (IsAligned(*it, alignment)) {
+        ptr = *it;
+        free_list.erase(std::next(it).base());
+        break;
+      }
+    }
+  } else {
+    std::lock_guard<std::mutex> lock(arena_mtx_);
+    auto end = free_large_blocks_.upper_bound(MaxReusedLargeBlockSize(block_size));
+    for (auto it = free_large_blocks_.lower_bound(block_size); it != end; ++it) {
+      if (IsAligned(it->second, alignment)) {
+        ptr        = it->second;
+        block_size = it->first;
+        free_large_blocks_.erase(it);
+        break;
+      }
+    }
+  }
+
+  if (ptr) {
+    ++cache_hits_;
+    cached_bytes_ -= block_size;
+  } else {
+    ++cache_misses_;
+    ptr = AllocateFromSystem(alignment, block_size);
+  }
+
+  {
+    auto& shard = GetShard(ptr);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.blocks[ptr] = BlockInfo{block_size, nbytes};
+  }
+  in_use_block_bytes_ += block_size;
+  UpdatePeak(allocated_bytes_ += nbytes);
+  return ptr;
+}
+
+void CachingAllocator::State::Deallocate(void* data) {
+  BlockInfo info;
+  {
+    auto& shard = GetShard(data);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    auto it = shard.blocks.find(data);
+    CHECK(it != shard.blocks.end()) << "The memory " << data << " is not allocated by this allocator";
+    info = it->second;
+    shard.blocks.erase(it);
+  }
+  allocated_bytes_ -= info.requested;
+  in_use_block_bytes_ -= info.block_size;
+
+  if (cached_bytes_ + info.block_size > max_cached_bytes_) {
+    ReturnToSystem(data, info.block_size);
+    return;
+  }
+  cached_bytes_ += info.block_size;
+  if (info.block_size <= kMaxSmallBlockSize) {
+    GetThreadCache()->free_lists[SmallSizeClassIndex(info.block_size)].push_back(data);
+  } else {
+    std::lock_guard<std::mutex> lock(arena_mtx_);
+    free_large_blocks_.emplace(info.block_size, data);
+  }
+}
+
+void CachingAllocator::State::ReleaseThreadCache() { GetThreadCache()->Release(); }
+
+void CachingAllocator::State::ReleaseAllThreadCaches() {
+  // the threads access their caches without locking, so none of them may use the allocator
+  // meanwhile, and the lock excludes the threads releasing their caches at exit
+  std::lock_guard<std::mutex> lock(thread_caches_mtx_);
+  for (auto* cache : thread_caches_) {
+    cache->Release();
+  }
+}
+
+void CachingAllocator::State::ReleaseArena() {
+  std::lock_guard<std::mutex> lock(arena_mtx_);
+  for (auto& size2block : free_large_blocks_) {
+    ReturnToSystem(size2block.second, size2block.first);
+    cached_bytes_ -= size2block.first;
+  }
+  free_large_blocks_.clear();
+}
+
+CachingAllocator::Stats CachingAllocator::State::GetStats() const {
+  Stats stats;
+  stats.allocated_bytes      = allocated_bytes_;
+  stats.peak_allocated_bytes = peak_allocated_bytes_;
+  stats.in_use_block_bytes   = in_use_block_bytes_;
+  stats.cached_bytes         = cached_bytes_;
+  stats.reserved_bytes       = reserved_bytes_;
+  stats.cache_hits           = cache_hits_;
+  stats.cache_misses         = cache_misses_;
+  return stats;
+}
+
+CachingAllocator::CachingAllocator(uint64_t max_cached_bytes) : state_(std::make_shared<State>(max_cached_bytes)) {}
+
+CachingAllocator::~CachingAllocator() { ReleaseAllCachedMemory(); }
+
+void* CachingAllocator::malloc(size_t nbytes) { return state_->Allocate(kMinAlignment, nbytes); }
+
+void CachingAllocator::free(void* data) {
+  if (!data) return;
+  state_->Deallocate(data);
+}
+
+void* CachingAllocator::aligned_alloc(size_t alignment, size_t nbytes) { return state_->Allocate(alignment, nbytes); }
+
+CachingAllocator::Stats CachingAllocator::GetStats() const { return state_->GetStats(); }
+
+void CachingAllocator::ReleaseCachedMemory() {
+  state_->ReleaseThreadCache();
+  state_->ReleaseArena();
+}
+
+void CachingAllocator::ReleaseAllCachedMemory() {
+  state_->ReleaseAllThreadCaches();
+  state_->ReleaseArena();
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
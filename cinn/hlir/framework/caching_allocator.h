@@ -0,0 +1,98 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "cinn/common/macros.h"
+#include "cinn/hlir/framework/memory.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * CachingAllocator is a host MemoryInterface which caches the freed blocks for later allocations instead of
+ * returning them to libc immediately.
+ *
+ * Requests are rounded up to size classes(4 classes per power of two). Blocks not larger than
+ * `kMaxSmallBlockSize` are cached in per-thread free lists, so the malloc/free pairs inserted around each
+ * instruction are served without locking. Larger blocks are cached in a shared arena and reused by best fit,
+ * as long as the wasted bytes are bounded.
+ */
+class CachingAllocator : public MemoryInterface {
+ public:
+  static constexpr size_t kMinAlignment     = 64;
+  static constexpr size_t kMaxSmallBlockSize = 1UL << 20;
+
+  struct Stats {
+    // bytes requested by the alive allocations
+    uint64_t allocated_bytes{0};
+    // the peak value of allocated_bytes
+    uint64_t peak_allocated_bytes{0};
+    // bytes of the blocks held by the alive allocations
+    uint64_t in_use_block_bytes{0};
+    // bytes of the freed blocks kept in the cache
+    uint64_t cached_bytes{0};
+    // bytes allocated from the system and not released yet
+    uint64_t reserved_bytes{0};
+    uint64_t cache_hits{0};
+    uint64_t cache_misses{0};
+
+    // the ratio of the bytes of the blocks held by the alive allocations but not requested, which are wasted by
+    // the rounding to size classes and the reuse of larger blocks, the cached blocks are counted by cached_bytes
+    double fragmentation() const {
+      return in_use_block_bytes ? 1.0 - static_cast<double>(allocated_bytes) / in_use_block_bytes : 0.0;
+    }
+  };
+
+  /**
+   * Constructor.
+   * @param max_cached_bytes The maximum bytes of the freed blocks to keep, blocks freed beyond the limit are
+   * returned to the system.
+   */
+  explicit CachingAllocator(uint64_t max_cached_bytes = 1UL << 32);
+  // Return the cached blocks of all the threads to the system, the allocator shouldn't be in use by any thread.
+  ~CachingAllocator() override;
+
+  void* malloc(size_t nbytes) override;
+  void free(void* data) override;
+  void* aligned_alloc(size_t alignment, size_t nbytes) override;
+
+  Stats GetStats() const;
+
+  // Return the cached blocks of the calling thread and the shared arena to the system.
+  void ReleaseCachedMemory();
+
+  // Return the cached blocks of all the threads and the shared arena to the system, which
+  // requires that no other thread is using the allocator at the same time.
+  void ReleaseAllCachedMemory();
+
+  // Round \p nbytes up to its size class.
+  static size_t RoundUpSize(size_t nbytes);
+
+  class State;
+
+ private:
+  std::shared_ptr<State> state_;
+
+  CINN_DISALLOW_COPY_AND_ASSIGN(CachingAllocator);
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,137 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/caching_allocator.h"
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+TEST(CachingAllocator, RoundUpSize) {
+  ASSERT_EQ(CachingAllocator::RoundUpSize(1), 64);
+  ASSERT_EQ(CachingAllocator::RoundUpSize(65), 80);
+  ASSERT_EQ(CachingAllocator::RoundUpSize(129), 160);
+  ASSERT_EQ(CachingAllocator::RoundUpSize(1000), 1024);
+  ASSERT_EQ(CachingAllocator::RoundUpSize(1025), 1280);
+}
+
+TEST(CachingAllocator, ReuseSmallBlock) {
+  CachingAllocator allocator;
+  void* p0 = allocator.malloc(100);
+  allocator.free(p0);
+  // the same size class is served from the cache
+  void* p1 = allocator.malloc(110);
+  ASSERT_EQ(p0, p1);
+  void* p2 = allocator.aligned_alloc(1024, 100);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(p2) % 1024, 0);
+
+  auto stats = allocator.GetStats();
+  ASSERT_EQ(stats.cache_hits, 1);
+  ASSERT_EQ(stats.cache_misses, 2);
+  ASSERT_EQ(stats.allocated_bytes, 210);
+  ASSERT_EQ(stats.peak_allocated_bytes, 210);
+  allocator.free(p1);
+  allocator.free(p2);
+  ASSERT_EQ(allocator.GetStats().allocated_bytes, 0);
+  ASSERT_EQ(allocator.GetStats().peak_allocated_bytes, 210);
+}
+
+TEST(CachingAllocator, ReuseLargeBlockByBestFit) {
+  CachingAllocator allocator;
+  void* p0 = allocator.malloc(8 << 20);
+  void* p1 = allocator.malloc(4 << 20);
+  allocator.free(p0);
+  allocator.free(p1);
+  // best fit selects the smaller block
+  void* p2 = allocator.malloc((4 << 20) - 100);
+  ASSERT_EQ(p1, p2);
+  // the cached 8MB block wastes too much for a 2MB request
+  void* p3 = allocator.malloc(2 << 20);
+  ASSERT_NE(p0, p3);
+  ASSERT_GT(allocator.GetStats().fragmentation(), 0.0);
+  allocator.free(p2);
+  allocator.free(p3);
+  // the cached blocks are not held by any allocation, so they are not counted as fragmentation
+  ASSERT_GT(allocator.GetStats().cached_bytes, 0);
+  ASSERT_EQ(allocator.GetStats().fragmentation(), 0.0);
+
+  allocator.ReleaseCachedMemory();
+  auto stats = allocator.GetStats();
+  ASSERT_EQ(stats.cached_bytes, 0);
+  ASSERT_EQ(stats.reserved_bytes, 0);
+}
+
+TEST(CachingAllocator, FreeOnOtherThread) {
+  CachingAllocator allocator;
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(allocator.malloc(i * 100));
+  }
+  std::thread worker([&]() {
+    for (void* ptr : ptrs) {
+      allocator.free(ptr);
+    }
+  });
+  worker.join();
+  // the blocks cached by the exited thread are returned to the system
+  auto stats = allocator.GetStats();
+  ASSERT_EQ(stats.allocated_bytes, 0);
+  ASSERT_EQ(stats.reserved_bytes, 0);
+}
+
+TEST(CachingAllocator, ReleaseCachesOfAliveThreads) {
+  CachingAllocator allocator;
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool cached = false, released = false;
+  // the worker caches its freed blocks and stays alive until all the cached blocks are released
+  std::thread worker([&]() {
+    for (int i = 1; i <= 100; ++i) {
+      allocator.free(allocator.malloc(i * 100));
+    }
+    std::unique_lock<std::mutex> lock(mtx);
+    cached = true;
+    cv.notify_all();
+    cv.wait(lock, [&]() { return released; });
+  });
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [&]() { return cached; });
+  }
+  ASSERT_GT(allocator.GetStats().cached_bytes, 0);
+  // the calling thread only releases its own cache
+  allocator.ReleaseCachedMemory();
+  ASSERT_GT(allocator.GetStats().cached_bytes, 0);
+  allocator.ReleaseAllCachedMemory();
+  auto stats = allocator.GetStats();
+  ASSERT_EQ(stats.cached_bytes, 0);
+  ASSERT_EQ(stats.reserved_bytes, 0);
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    released = true;
+  }
+  cv.notify_all();
+  worker.join();
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,353 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/compilation_cache.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef CINN_WITH_CUDA
+#include <cuda_runtime.h>
+#endif
+
+#include "cinn/hlir/framework/node.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/utils/string.h"
+
+DECLARE_string(cinn_compilation_cache_dir);
+DECLARE_int32(cinn_compiled_group_cache_size);
+DECLARE_bool(cinn_ir_schedule);
+DECLARE_bool(cinn_use_cuda_vectorize);
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+// bump it when the lowering or the layout of the cached graph changes incompatibly
+constexpr int kCompilationCacheVersion = 1;
+constexpr char kGraphSuffix[]          = ".graph";
+
+std::string HostCpuDescription() {
+  llvm::StringMap<bool> features;
+  llvm::sys::getHostCPUFeatures(features);
+  std::vector<std::string> enabled;
+  for (const auto& feature : features) {
+    if (feature.getValue()) {
+      enabled.push_back(feature.getKey().str());
+    }
+  }
+  std::sort(enabled.begin(), enabled.end());
+  return llvm::sys::getHostCPUName().str() + "[" + utils::Join(enabled, ",") + "]";
+}
+
+// describe the fields of a group which determine its lowering
+void DescribeGroup(const Graph::Group& group,
+                   const std::unordered_map<const Node*, int>& op_indices,
+                   std::ostringstream* os) {
+  auto describe_nodes = [&](const std::string& field, const auto& nodes, bool sort) {
+    std::vector<int> indices;
+    for (const Node* node : nodes) {
+      auto it = op_indices.find(node);
+      indices.push_back(it == op_indices.end() ? -1 : it->second);
+    }
+    if (sort) {
+      std::sort(indices.begin(), indices.end());
+    }
+    *os << field << "[" << utils::Join(indices, ",") << "]";
+  };
+  *os << "kind:" << static_cast<int>(group.op_pattern_kind);
+  describe_nodes("nodes", group.nodes, false);
+  describe_nodes("outputs", group.output_nodes, true);
+  describe_nodes("internals", group.internal_nodes, true);
+  describe_nodes("masters", group.master_nodes, true);
+}
+
+void DescribeGroupWithSubGroups(const Graph::Group& group,
+                                const std::unordered_map<const Node*, int>& op_indices,
+                                std::ostringstream* os) {
+  *os << "group{";
+  DescribeGroup(group, op_indices, os);
+  for (auto& sub_group : group.fused_sub_groups) {
+    *os << "sub{";
+    DescribeGroup(*sub_group, op_indices, os);
+    *os << "}";
+  }
+  *os << "}\n";
+}
+
+// Build the description of the ops and variables, numbering them in the order they are added.
+class SignatureBuilder {
+ public:
+  SignatureBuilder(Graph* graph, const Target& target) {
+    os_ << "version:" << kCompilationCacheVersion << ";llvm:" << LLVM_VERSION_STRING << ";target:" << target
+        << ";cpu:" << HostCpuDescription();
+#ifdef CINN_WITH_CUDA
+    if (target == common::DefaultNVGPUTarget()) {
+      int major = 0, minor = 0;
+      cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, 0);
+      cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, 0);
+      os_ << ";sm:" << major << minor;
+    }
+#endif
+    os_ << ";flags:" << FLAGS_cinn_ir_schedule << FLAGS_cinn_use_cuda_vectorize << "\n";
+
+    shape_dict_ =
+        graph->HasAttr("infershape") ? &graph->GetAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape")
+                                     : nullptr;
+    dtype_dict_ =
+        graph->HasAttr("inferdtype") ? &graph->GetAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype") : nullptr;
+  }
+
+  int AddVar(const NodeData* var) {
+    auto it = signature_.var_indices.find(var->id());
+    if (it != signature_.var_indices.end()) {
+      return it->second;
+    }
+    int index                         = signature_.var_names.size();
+    signature_.var_indices[var->id()] = index;
+    signature_.var_names.push_back(var->id());
+
+    os_ << "v" << index << ":";
+    if (dtype_dict_ && dtype_dict_->count(var->id())) {
+      os_ << dtype_dict_->at(var->id());
+    }
+    if (shape_dict_ && shape_dict_->count(var->id())) {
+      os_ << "[" << utils::Join(shape_dict_->at(var->id()), ",") << "]";
+    }
+    os_ << (var->is_const() ? "const" : "") << "\n";
+    return index;
+  }
+
+  void AddOp(const Node* node) {
+    std::vector<int> inputs, outputs;
+    for (auto& link : node->inlinks_in_order()) {
+      auto* var = link->source()->safe_as<NodeData>();
+      CHECK(var) << "The input of op " << node->id() << " is not a variable";
+      inputs.push_back(AddVar(var));
+    }
+    for (auto& link : node->outlinks_in_order()) {
+      auto* var = link->sink()->safe_as<NodeData>();
+      CHECK(var) << "The output of op " << node->id() << " is not a variable";
+      outputs.push_back(AddVar(var));
+    }
+    // the attributes are sorted by their names since the order of a hash map is not stable
+    std::map<std::string, std::string> attrs;
+    for (auto& attr : node->attrs.attr_store) {
+      attrs[attr.first] = std::to_string(attr.second.index()) + ":" + utils::Attribute2String(attr.second);
+    }
+
+    int index         = op_indices_.size();
+    op_indices_[node] = index;
+    os_ << "op" << index << ":" << node->op()->name << "(" << utils::Join(inputs, ",") << ")->("
+        << utils::Join(outputs, ",") << "){";
+    for (auto& attr : attrs) {
+      os_ << attr.first << "=" << attr.second << ";";
+    }
+    os_ << "}\n";
+  }
+
+  void AddGroup(const Graph::Group& group) { DescribeGroupWithSubGroups(group, op_indices_, &os_); }
+
+  void AddLoweredFuncs(const std::vector<ir::LoweredFunc>& funcs) {
+    for (auto& func : funcs) {
+      os_ << "func:" << func << "\n";
+    }
+  }
+
+  GraphSignature Finish() {
+    llvm::SHA1 hasher;
+    hasher.update(os_.str());
+    signature_.fingerprint = llvm::toHex(hasher.result(), /*LowerCase=*/true);
+    return std::move(signature_);
+  }
+
+ private:
+  GraphSignature signature_;
+  std::ostringstream os_;
+  std::unordered_map<const Node*, int> op_indices_;
+  const absl::flat_hash_map<std::string, shape_t>* shape_dict_;
+  const absl::flat_hash_map<std::string, Type>* dtype_dict_;
+};
+}  // namespace
+
+GraphSignature ComputeGraphSignature(Graph* graph,
+                                     const Target& target,
+                                     const std::vector<std::vector<ir::LoweredFunc>>& lowered_funcs) {
+  SignatureBuilder builder(graph, target);
+  // number the ops and the variables in the topological order
+  auto nodes = std::get<0>(graph->topological_order());
+  for (auto* graph_node : nodes) {
+    auto* node = graph_node->safe_as<Node>();
+    if (node) {
+      builder.AddOp(node);
+    } else if (graph_node->safe_as<NodeData>()) {
+      builder.AddVar(graph_node->safe_as<NodeData>());
+    }
+  }
+  for (auto& group : graph->fusion_groups) {
+    builder.AddGroup(*group);
+  }
+  for (auto& funcs : lowered_funcs) {
+    builder.AddLoweredFuncs(funcs);
+  }
+  return builder.Finish();
+}
+
+GraphSignature ComputeGroupSignature(Graph* graph,
+                                     const std::shared_ptr<Graph::Group>& group,
+                                     const Target& target,
+                                     const std::vector<ir::LoweredFunc>& lowered_funcs) {
+  SignatureBuilder builder(graph, target);
+  // number the ops and the variables in the order of lowering
+  for (auto* node : group->CollectNodes()) {
+    builder.AddOp(node);
+  }
+  builder.AddGroup(*group);
+  builder.AddLoweredFuncs(lowered_funcs);
+  return builder.Finish();
+}
+
+CompilationCache::CompilationCache(const std::string& cache_dir) : cache_dir_(cache_dir) {
+  auto ec = llvm::sys::fs::create_directories(cache_dir_);
+  CHECK(!ec) << "Failed to create the compilation cache directory [" << cache_dir_ << "]: " << ec.message();
+}
+
+CompilationCache* CompilationCache::Global() {
+  static std::unique_ptr<CompilationCache> cache = []() -> std::unique_ptr<CompilationCache> {
+    if (FLAGS_cinn_compilation_cache_dir.empty()) {
+      return nullptr;
+    }
+    LOG(INFO) << "Enable compilation cache at [" << FLAGS_cinn_compilation_cache_dir << "]";
+    return std::make_unique<CompilationCache>(FLAGS_cinn_compilation_cache_dir);
+  }();
+  return cache.get();
+}
+
+std::string CompilationCache::GetGraphPath(const std::string& fingerprint) const {
+  llvm::SmallString<128> path(cache_dir_);
+  llvm::sys::path::append(path, fingerprint + kGraphSuffix);
+  return path.str().str();
+}
+
+bool CompilationCache::Load(const std::string& fingerprint, proto::CompiledGraph* compiled_graph) {
+  auto path   = GetGraphPath(fingerprint);
+  auto buffer = llvm::MemoryBuffer::getFile(path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+  if (!buffer) {
+    ++misses_;
+    VLOG(3) << "Graph " << fingerprint << " missed in the compilation cache";
+    return false;
+  }
+  if (!compiled_graph->ParseFromArray((*buffer)->getBufferStart(), (*buffer)->getBufferSize()) ||
+      compiled_graph->fingerprint() != fingerprint) {
+    ++misses_;
+    LOG(WARNING) << "Ignore the broken compiled graph in " << path;
+    return false;
+  }
+  ++hits_;
+  VLOG(3) << "Graph " << fingerprint << " loaded from " << path;
+  return true;
+}
+
+void CompilationCache::Store(const std::string& fingerprint, const proto::CompiledGraph& compiled_graph) {
+  std::string data;
+  if (!compiled_graph.SerializeToString(&data)) {
+    LOG(WARNING) << "Failed to serialize the compiled graph " << fingerprint;
+    return;
+  }
+  auto path = GetGraphPath(fingerprint);
+  llvm::SmallString<128> tmp_path;
+  int fd  = -1;
+  auto ec = llvm::sys::fs::createUniqueFile(path + ".tmp-%%%%%%%%", fd, tmp_path);
+  if (ec) {
+    LOG(WARNING) << "Failed to create a temporary file for graph " << fingerprint << ": " << ec.message();
+    return;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << data;
+    os.close();
+    if (os.has_error()) {
+      LOG(WARNING) << "Failed to write graph " << fingerprint << " to " << tmp_path.str().str();
+      os.clear_error();
+      llvm::sys::fs::remove(tmp_path);
+      return;
+    }
+  }
+  ec = llvm::sys::fs::rename(tmp_path, path);
+  if (ec) {
+    LOG(WARNING) << "Failed to rename " << tmp_path.str().str() << " to " << path << ": " << ec.message();
+    llvm::sys::fs::remove(tmp_path);
+    return;
+  }
+  ++stores_;
+  VLOG(3) << "Graph " << fingerprint << " stored to " << path;
+}
+
+CompiledGroupCache* CompiledGroupCache::Global() {
+  // never destroyed, since the engines and the cuda modules can't be released after the runtime is shut down at exit
+  static CompiledGroupCache* cache =
+      FLAGS_cinn_compiled_group_cache_size > 0 ? new CompiledGroupCache(FLAGS_cinn_compiled_group_cache_size) : nullptr;
+  return cache;
+}
+
+std::shared_ptr<CompiledGroup> CompiledGroupCache::Find(const std::string& fingerprint) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = entries_.find(fingerprint);
+  if (it == entries_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+  return it->second->second;
+}
+
+void CompiledGroupCache::Insert(const std::string& fingerprint, std::shared_ptr<CompiledGroup> compiled_group) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = entries_.find(fingerprint);
+  if (it != entries_.end()) {
+    lru_list_.erase(it->second);
+  }
+  lru_list_.emplace_front(fingerprint, std::move(compiled_group));
+  entries_[fingerprint] = lru_list_.begin();
+  while (lru_list_.size() > capacity_) {
+    VLOG(3) << "Drop the compiled group " << lru_list_.back().first;
+    entries_.erase(lru_list_.back().first);
+    lru_list_.pop_back();
+  }
+}
+
+size_t CompiledGroupCache::size() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return lru_list_.size();
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
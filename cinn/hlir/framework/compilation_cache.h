@@ -0,0 +1,175 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/common/target.h"
+#include "cinn/hlir/framework/compilation_cache.pb.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/ir/lowered_func.h"
+#ifdef CINN_WITH_CUDA
+#include "cinn/runtime/cuda/cuda_module.h"
+#endif
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * The signature identifying the compiled code of a graph after fusion.
+ *
+ * The fingerprint covers the fusion groups, the ops with their attributes, the shapes and dtypes of the variables,
+ * the target with the host cpu, and the flags changing the generated code. The variables are numbered in the
+ * topological order rather than by their names, so the same model built by another process, or by another builder
+ * in this process, gets the same fingerprint.
+ */
+struct GraphSignature {
+  std::string fingerprint;
+  // the variables in the canonical order
+  std::vector<std::string> var_names;
+  // map a variable's name to its index in var_names
+  std::unordered_map<std::string, int> var_indices;
+};
+
+/**
+ * Compute the signature of a graph whose fusion_groups are built.
+ * @param graph The graph to compile.
+ * @param target The target to compile for.
+ * @param lowered_funcs The lowered functions given for the fusion groups, such as the tuned ones.
+ */
+GraphSignature ComputeGraphSignature(Graph* graph,
+                                     const Target& target,
+                                     const std::vector<std::vector<ir::LoweredFunc>>& lowered_funcs = {});
+
+/**
+ * Compute the signature of a fusion group, which covers the variables accessed by the group only, so the group gets
+ * the same fingerprint when the other parts of the graph change.
+ * @param graph The graph holding the group.
+ * @param group The group to compile.
+ * @param target The target to compile for.
+ * @param lowered_funcs The lowered functions given for the group, such as the tuned ones.
+ */
+GraphSignature ComputeGroupSignature(Graph* graph,
+                                     const std::shared_ptr<Graph::Group>& group,
+                                     const Target& target,
+                                     const std::vector<ir::LoweredFunc>& lowered_funcs = {});
+
+/**
+ * A cache of the compiled graphs persisted on disk, so compiling a graph identical to one compiled by a previous
+ * process only loads and links the object code.
+ *
+ * Each graph is stored in a file named by its fingerprint, holding the code compiled by every sub-task of the
+ * ParallelCompiler and the metadata to build the instructions. Files are written to a temporary file and then
+ * renamed, so processes sharing one directory never read a partially written graph.
+ */
+class CompilationCache {
+ public:
+  /**
+   * Constructor.
+   * @param cache_dir The directory to store the compiled graphs, it will be created if not exists.
+   */
+  explicit CompilationCache(const std::string& cache_dir);
+
+  /**
+   * The global cache configured by FLAGS_cinn_compilation_cache_dir, returns nullptr if the directory is not set.
+   */
+  static CompilationCache* Global();
+
+  // Load the compiled graph of \p fingerprint, returns false if missed.
+  bool Load(const std::string& fingerprint, proto::CompiledGraph* compiled_graph);
+
+  // Store the compiled graph of \p fingerprint.
+  void Store(const std::string& fingerprint, const proto::CompiledGraph& compiled_graph);
+
+  const std::string& cache_dir() const { return cache_dir_; }
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+  uint64_t stores() const { return stores_; }
+
+ private:
+  std::string GetGraphPath(const std::string& fingerprint) const;
+
+  std::string cache_dir_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> stores_{0};
+};
+
+/**
+ * The jitted function of a fusion group. The execution engine is shared by the groups compiled in the same sub-task
+ * of the ParallelCompiler.
+ */
+struct CompiledGroup {
+  std::string func_name;
+  // the arguments of the function, referred by their indices in the signature of the group
+  std::vector<int> input_vars;
+  std::vector<int> output_vars;
+  std::shared_ptr<backends::ExecutionEngine> engine;
+#ifdef CINN_WITH_CUDA
+  std::shared_ptr<runtime::cuda::CUDAModule> cumodule;
+#endif
+};
+
+/**
+ * An in-memory cache of the compiled fusion groups keyed on the fingerprints of the groups, so recompiling a graph
+ * where only some groups changed, such as the same model with another batch size, only lowers and compiles the new
+ * or modified groups. The least recently used groups are dropped once the capacity is exceeded.
+ */
+class CompiledGroupCache {
+ public:
+  explicit CompiledGroupCache(size_t capacity) : capacity_(capacity) {}
+
+  /**
+   * The global cache sized by FLAGS_cinn_compiled_group_cache_size, returns nullptr if the size is 0.
+   */
+  static CompiledGroupCache* Global();
+
+  // Find the compiled group of \p fingerprint, returns nullptr if missed.
+  std::shared_ptr<CompiledGroup> Find(const std::string& fingerprint);
+
+  // Insert the compiled group of \p fingerprint, replacing the existing one.
+  void Insert(const std::string& fingerprint, std::shared_ptr<CompiledGroup> compiled_group);
+
+  size_t size();
+  size_t capacity() const { return capacity_; }
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+
+ private:
+  using Entry = std::pair<std::string, std::shared_ptr<CompiledGroup>>;
+
+  const size_t capacity_;
+  std::mutex mtx_;
+  // the most recently used one at front
+  std::list<Entry> lru_list_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> entries_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/compilation_cache.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <llvm/Support/FileSystem.h>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/optimize.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/utils/data_util.h"
+
+DECLARE_string(cinn_compilation_cache_dir);
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+std::shared_ptr<Graph> BuildGraph(int dim, float scale, std::string* out_id) {
+  frontend::NetBuilder builder("compilation_cache");
+  auto x   = builder.CreateInput(Float(32), {dim, dim}, "x");
+  auto y   = builder.CreateInput(Float(32), {dim, dim}, "y");
+  auto out = builder.Relu(builder.Scale(builder.Add(builder.Matmul(x, y), x), scale));
+  *out_id  = out->id;
+
+  auto target  = common::DefaultHostTarget();
+  auto program = builder.Build();
+  return frontend::Optimize(&program, {out->id}, target);
+}
+
+TEST(CompilationCache, Signature) {
+  auto target = common::DefaultHostTarget();
+  std::string out_id1, out_id2;
+  auto graph1 = BuildGraph(32, 2.0f, &out_id1);
+  auto graph2 = BuildGraph(32, 2.0f, &out_id2);
+  // the variables are named differently by the two builders
+  ASSERT_NE(out_id1, out_id2);
+  auto signature1 = ComputeGraphSignature(graph1.get(), target);
+  auto signature2 = ComputeGraphSignature(graph2.get(), target);
+  ASSERT_EQ(signature1.fingerprint, signature2.fingerprint);
+  ASSERT_EQ(signature1.var_names.size(), signature2.var_names.size());
+  ASSERT_EQ(signature1.var_indices.at(out_id1), signature2.var_indices.at(out_id2));
+
+  std::string out_id;
+  ASSERT_NE(signature1.fingerprint, ComputeGraphSignature(BuildGraph(64, 2.0f, &out_id).get(), target).fingerprint);
+  ASSERT_NE(signature1.fingerprint, ComputeGraphSignature(BuildGraph(32, 3.0f, &out_id).get(), target).fingerprint);
+}
+
+std::vector<float> CompileAndRun(int dim) {
+  auto target = common::DefaultHostTarget();
+  std::string out_id;
+  auto graph = BuildGraph(dim, 2.0f, &out_id);
+  auto scope = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto runtime_program               = gc.Build(options, {out_id}).runtime_program;
+
+  SetRandData<float>(scope->GetTensor("x"), target, 0);
+  SetRandData<float>(scope->GetTensor("y"), target, 1);
+  runtime_program->Execute();
+  return GetTensorData<float>(scope->GetTensor(out_id), target);
+}
+
+TEST(CompilationCache, GraphCompiler) {
+  const std::string cache_dir = "/tmp/cinn_compilation_cache_test";
+  llvm::sys::fs::remove_directories(cache_dir);
+  FLAGS_cinn_compilation_cache_dir = cache_dir;
+  auto* cache                      = CompilationCache::Global();
+  ASSERT_NE(cache, nullptr);
+
+  auto expected = CompileAndRun(32);
+  ASSERT_EQ(cache->misses(), 1);
+  ASSERT_EQ(cache->stores(), 1);
+
+  // only load and link the code compiled above
+  auto results = CompileAndRun(32);
+  ASSERT_EQ(cache->hits(), 1);
+  ASSERT_EQ(cache->stores(), 1);
+  ASSERT_EQ(expected.size(), results.size());
+  for (int i = 0; i < expected.size(); ++i) {
+    ASSERT_FLOAT_EQ(expected[i], results[i]);
+  }
+
+  CompileAndRun(64);
+  ASSERT_EQ(cache->misses(), 2);
+  ASSERT_EQ(cache->stores(), 2);
+  llvm::sys::fs::remove_directories(cache_dir);
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
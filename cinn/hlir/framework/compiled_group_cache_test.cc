@@ -0,0 +1,131 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/optimize.h"
+#include "cinn/hlir/framework/compilation_cache.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/utils/data_util.h"
+
+DECLARE_int32(cinn_compiled_group_cache_size);
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+struct CompiledModel {
+  int num_groups;
+  std::vector<float> x, w;
+  std::vector<float> out1, out2;
+};
+
+// out1 depends on the batch size, while out2 doesn't
+CompiledModel CompileAndRun(int batch) {
+  frontend::NetBuilder builder("compiled_group_cache");
+  auto x    = builder.CreateInput(Float(32), {batch, 16}, "x");
+  auto w    = builder.CreateInput(Float(32), {16, 16}, "w");
+  auto out1 = builder.Relu(builder.Add(builder.Matmul(x, w), x));
+  auto out2 = builder.Scale(builder.Exp(w), 2.0f);
+
+  auto target  = common::DefaultHostTarget();
+  auto program = builder.Build();
+  auto graph   = frontend::Optimize(&program, {out1->id, out2->id}, target);
+  auto scope   = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto runtime_program               = gc.Build(options, {out1->id, out2->id}).runtime_program;
+
+  SetRandData<float>(scope->GetTensor("x"), target, 0);
+  SetRandData<float>(scope->GetTensor("w"), target, 1);
+  runtime_program->Execute();
+
+  CompiledModel model;
+  model.num_groups = graph->fusion_groups.size();
+  model.x          = GetTensorData<float>(scope->GetTensor("x"), target);
+  model.w          = GetTensorData<float>(scope->GetTensor("w"), target);
+  model.out1       = GetTensorData<float>(scope->GetTensor(out1->id), target);
+  model.out2       = GetTensorData<float>(scope->GetTensor(out2->id), target);
+  return model;
+}
+
+void CheckResults(const CompiledModel& model, int batch) {
+  ASSERT_EQ(model.out1.size(), batch * 16);
+  for (int i = 0; i < batch; ++i) {
+    for (int j = 0; j < 16; ++j) {
+      float expected = model.x[i * 16 + j];
+      for (int k = 0; k < 16; ++k) {
+        expected += model.x[i * 16 + k] * model.w[k * 16 + j];
+      }
+      ASSERT_NEAR(model.out1[i * 16 + j], std::max(expected, 0.0f), 1e-4);
+    }
+  }
+  ASSERT_EQ(model.out2.size(), 16 * 16);
+  for (int i = 0; i < 16 * 16; ++i) {
+    ASSERT_NEAR(model.out2[i], 2.0f * std::exp(model.w[i]), 1e-4 * std::exp(model.w[i]));
+  }
+}
+
+TEST(CompiledGroupCache, LRU) {
+  CompiledGroupCache cache(2);
+  cache.Insert("a", std::make_shared<CompiledGroup>());
+  cache.Insert("b", std::make_shared<CompiledGroup>());
+  ASSERT_NE(cache.Find("a"), nullptr);
+  // b is the least recently used one
+  cache.Insert("c", std::make_shared<CompiledGroup>());
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(cache.Find("b"), nullptr);
+  ASSERT_NE(cache.Find("a"), nullptr);
+  ASSERT_NE(cache.Find("c"), nullptr);
+  ASSERT_EQ(cache.hits(), 3);
+  ASSERT_EQ(cache.misses(), 1);
+}
+
+TEST(CompiledGroupCache, RecompileChangedGroups) {
+  FLAGS_cinn_compiled_group_cache_size = 64;
+  auto* cache                          = CompiledGroupCache::Global();
+  ASSERT_NE(cache, nullptr);
+
+  auto model = CompileAndRun(4);
+  CheckResults(model, 4);
+  ASSERT_EQ(cache->hits(), 0);
+  ASSERT_EQ(cache->misses(), model.num_groups);
+  ASSERT_EQ(cache->size(), model.num_groups);
+
+  // the groups computing out2 are reused
+  uint64_t misses = cache->misses();
+  model           = CompileAndRun(8);
+  CheckResults(model, 8);
+  ASSERT_GT(cache->hits(), 0);
+  ASSERT_LT(cache->misses() - misses, model.num_groups);
+  ASSERT_EQ(cache->hits() + cache->misses() - misses, model.num_groups);
+
+  // all the groups are reused
+  uint64_t hits = cache->hits();
+  misses        = cache->misses();
+  model         = CompileAndRun(4);
+  CheckResults(model, 4);
+  ASSERT_EQ(cache->hits() - hits, model.num_groups);
+  ASSERT_EQ(cache->misses(), misses);
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -16,12 +16,14 @@
 
 #include <absl/container/flat_hash_map.h>
 
+#include <algorithm>
 #include <memory>
 #include <unordered_set>
 
 #include "cinn/backends/codegen_cuda_dev.h"
 #include "cinn/common/context.h"
 #include "cinn/hlir/framework/instruction.h"
+#include "cinn/hlir/framework/memory_planner.h"
 #include "cinn/hlir/framework/op_lowering_util.h"
 #include "cinn/hlir/framework/tensor.h"
 #include "cinn/hlir/pe/schedule.h"
@@ -32,6 +34,9 @@
 
 DECLARE_bool(cinn_ir_schedule);
 DECLARE_int32(cinn_parallel_compile_size);
+DECLARE_int32(cinn_parallel_execute_threads);
+DECLARE_bool(cinn_sync_run);
+DECLARE_string(cinn_self_check_accuracy);
 
 namespace cinn {
 namespace hlir {
@@ -84,6 +89,8 @@ void Program::PreRun(const std::map<std::string, cinn_pod_value_t>* name2podargs
       ins->PreRun(name2podargs);
     }
   }
+  // the arguments of instructions may be changed, so the dependencies should be rebuilt
+  parallel_executor_.reset();
 }
 
 void Program::Export(const std::vector<std::string>& persistent_vars, const std::string& filename) {
@@ -209,7 +216,31 @@ void Program::Export(const std::vector<std::string>& persistent_vars, const std:
   fclose(f);
 }
 
+bool Program::UseParallelExecutor() const {
+  if (FLAGS_cinn_parallel_execute_threads <= 1 || instrs_.size() <= 1) {
+    return false;
+  }
+  // instructions on NVGPU are issued to a stream in order, and the debug modes
+  // expect a deterministic order, so fallback to the serial execution. The buffer
+  // malloc/free instructions are built for the host even in a NVGPU program, so
+  // every instruction is checked rather than the first one.
+  if (FLAGS_cinn_sync_run || !FLAGS_cinn_self_check_accuracy.empty() || utils::ProfilerHelper::IsEnable()) {
+    return false;
+  }
+  return std::all_of(instrs_.begin(), instrs_.end(), [](const std::unique_ptr<Instruction>& instr) {
+    return instr->target_.arch == Target::Arch::X86;
+  });
+}
+
 void Program::Execute(const std::map<std::string, cinn_pod_value_t>* name2podargs, void* stream, bool use_cache) {
+  if (UseParallelExecutor()) {
+    int num_threads = FLAGS_cinn_parallel_execute_threads;
+    if (!parallel_executor_ || parallel_executor_->num_threads() != num_threads) {
+      parallel_executor_ = std::make_unique<ParallelExecutor>(instrs_, scope_.get(), num_threads);
+    }
+    parallel_executor_->Run(name2podargs, stream, use_cache);
+    return;
+  }
   for (auto& ins : instrs_) {
     ins->Run(name2podargs, false, stream, use_cache);
   }
@@ -746,6 +777,8 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
                                                       std::unordered_set<std::string>&& fetch_var_ids,
                                                       void* stream) {
   Context::Global().ResetNameId();
+  CHECK(!(options.with_memory_plan && options.with_buffer_handle_instruction_inserted))
+      << "with_memory_plan and with_buffer_handle_instruction_inserted can't be enabled at the same time";
   if (FLAGS_cinn_parallel_compile_size) {
     // write group's information into FLAGS_cinn_fusion_groups_graphviz_dir
     graph_->VisualizeGroupedGraph(fetch_var_ids.empty() ? fetch_var_ids_ : fetch_var_ids);
@@ -784,6 +817,10 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
       VLOG(3) << "option.with_buffer_handle_instruction_inserted enable";
       InsertBufferHandlers(&instructions);
     }
+
+    if (options.with_memory_plan) {
+      PlanMemory(instructions, fetch_var_ids.empty() ? fetch_var_ids_ : fetch_var_ids);
+    }
     VLOG(2) << "Compile With Parallel Compiler Done!";
 
     GraphCompiler::CompilationResult compilation_result;
@@ -883,7 +920,7 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
   VLOG(3) << "End of m_builder_.Build()";
   if (this->target_.arch == Target::Arch::X86) {
     utils::RecordEvent("GraphCompiler CodeGenCX86", utils::EventType::kOrdinary);
-    CodeGenCX86 codegen(this->target_, CodeGenCX86::Feature::AVX512);
+    CodeGenCX86 codegen(this->target_, CodeGenCX86::GetFeature(this->target_));
     codegen.SetInlineBuiltinCodes(false);
     auto out = codegen.Compile(build_module, CodeGenC::OutputKind::CImpl);
     VLOG(3) << "[X86] C Code is:\n" << out;
@@ -923,6 +960,10 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
     }
   }
 
+  if (options.with_memory_plan) {
+    PlanMemory(instructions, fetch_var_ids_);
+  }
+
   GraphCompiler::CompilationResult result;
   result.runtime_program.reset(new Program(scope_, std::move(instructions)));
   return result;
@@ -1397,6 +1438,78 @@ void GraphCompiler::InsertBufferHandlers(std::vector<std::unique_ptr<Instruction
   instructions->swap(results);
 }
 
+void GraphCompiler::PlanMemory(const std::vector<std::unique_ptr<Instruction>>& instructions,
+                               const std::unordered_set<std::string>& fetch_var_ids) {
+  utils::RecordEvent("GraphCompiler PlanMemory", utils::EventType::kOrdinary);
+  std::unordered_map<int, std::vector<std::string>> step2malloc, step2free;
+  AnalyzeVariableLifeTime(instructions, &step2malloc, &step2free);
+
+  // the variables may be accessed out of the program are kept in their own buffers
+  std::unordered_set<std::string> excluded_vars(fetch_var_ids.begin(), fetch_var_ids.end());
+  for (auto* output : graph_->outputs) {
+    excluded_vars.insert(output->id());
+  }
+  for (const auto& dst2src : reuse_vars_map_) {
+    excluded_vars.insert(dst2src.first);
+    excluded_vars.insert(dst2src.second);
+  }
+  auto is_intermediate = [&](const std::string& name) {
+    if (excluded_vars.count(name) || !scope_->FindVar(name)) return false;
+    auto* node_data = graph_->RetrieveNode(name) ? graph_->RetrieveNode(name)->safe_as<NodeData>() : nullptr;
+    // graph inputs and constants are not produced by the program, and variables without
+    // consumers are regarded as the results of the program
+    return node_data && !node_data->is_const() && node_data->source_node.get() && node_data->source_node->op() &&
+           !node_data->outlinks().empty();
+  };
+
+  absl::flat_hash_map<std::string, TensorLifetime> name2lifetime;
+  for (const auto& step2vars : step2malloc) {
+    for (const auto& name : step2vars.second) {
+      if (!is_intermediate(name)) continue;
+      auto tensor    = scope_->GetTensor(name);
+      auto& life     = name2lifetime[name];
+      life.name      = name;
+      life.size      = tensor->shape().numel() * tensor->type().bytes();
+      life.first_use = step2vars.first;
+    }
+  }
+  for (const auto& step2vars : step2free) {
+    for (const auto& name : step2vars.second) {
+      if (name2lifetime.count(name)) {
+        name2lifetime[name].last_use = step2vars.first;
+      }
+    }
+  }
+  std::vector<TensorLifetime> lifetimes;
+  for (const auto& name2life : name2lifetime) {
+    if (name2life.second.size > 0) {
+      lifetimes.push_back(name2life.second);
+    }
+  }
+  if (lifetimes.empty()) {
+    return;
+  }
+
+  // keep the same alignment as Tensor::mutable_data on host, and the memory allocated on GPU is aligned to 256 bytes
+  bool is_host       = target_ == common::DefaultHostTarget();
+  uint64_t alignment = is_host ? 1024 : 256;
+  auto plan          = PlanMemoryGreedyBySize(lifetimes, alignment);
+  VLOG(3) << "Memory plan of graph with " << instructions.size() << " instructions: " << lifetimes.size()
+          << " variables planned into a workspace of " << plan.workspace_size << " bytes, naive peak "
+          << plan.naive_size << " bytes, live peak " << plan.live_peak_size << " bytes";
+
+  workspace_ = std::make_shared<Buffer>(target_);
+  if (is_host) {
+    workspace_->Resize(alignment, plan.workspace_size);
+  } else {
+    workspace_->Resize(plan.workspace_size);
+  }
+  for (const auto& life : lifetimes) {
+    auto tensor = scope_->GetTensor(life.name);
+    tensor->get_buffer()->ShareMemory(workspace_, plan.offsets.at(life.name), life.size);
+  }
+}
+
 std::vector<std::string> GraphCompiler::OpGetInputNames(const Node* node) const {
   std::vector<std::string> res;
   if (node->op()->name == "cublas_gemm" || node->op()->name == "cublas_matmul" || node->op()->name == "conv2d" ||
@@ -31,6 +31,7 @@
 #include "cinn/hlir/framework/instruction.h"
 #include "cinn/hlir/framework/op_strategy.h"
 #include "cinn/hlir/framework/parallel_compiler.h"
+#include "cinn/hlir/framework/parallel_executor.h"
 #include "cinn/hlir/framework/scope.h"
 #include "cinn/ir/lowered_func.h"
 #include "cinn/lang/packed_func.h"
@@ -58,6 +59,7 @@ class Program {
 
   /**
    * Execute the program -- that is running all the instructions inside it.
+   * On X86, independent instructions run concurrently when FLAGS_cinn_parallel_execute_threads > 1.
    */
   void Execute(const std::map<std::string, cinn_pod_value_t>* name2podargs = nullptr,
                void* stream                                                = nullptr,
@@ -80,6 +82,11 @@ class Program {
   std::vector<std::unique_ptr<Instruction>> prerun_instrs_;
   // only runtime instructions
   std::vector<std::unique_ptr<Instruction>> instrs_;
+  // run instrs_ according to their dependencies, created at the first parallel execution
+  std::unique_ptr<ParallelExecutor> parallel_executor_;
+
+  // whether run instrs_ with parallel_executor_ or one by one in order
+  bool UseParallelExecutor() const;
 };
 
 /**
@@ -99,6 +106,9 @@ class GraphCompiler final {
     bool with_instantiate_variables              = false;
     bool with_buffer_handle_instruction_inserted = false;
     bool remove_unused_variables                 = true;
+    // place the intermediate variables into one preallocated workspace by their lifetimes,
+    // it can't be used together with with_buffer_handle_instruction_inserted
+    bool with_memory_plan = false;
     // nodes group, it may come from the result of op fusion or graph tuning.
     // nodes in a group will be built into an Instruction
     std::vector<std::shared_ptr<Graph::Group>> groups;
@@ -165,6 +175,12 @@ class GraphCompiler final {
   // applying on variables after no instruction will use them anymore
   void InsertBufferHandlers(std::vector<std::unique_ptr<Instruction>>* instructions);
 
+  // plan the intermediate variables, which are produced and consumed only by the
+  // instructions, into one workspace so that variables with disjoint lifetimes
+  // share the memory, variables to be fetched are excluded
+  void PlanMemory(const std::vector<std::unique_ptr<Instruction>>& instructions,
+                  const std::unordered_set<std::string>& fetch_var_ids);
+
  private:
   // parallel compiler
   std::shared_ptr<ParallelCompiler> parallel_compiler_;
@@ -187,6 +203,8 @@ class GraphCompiler final {
 
   std::unique_ptr<backends::Compiler> compiler_;
   CompileOptions compile_options_;
+  // the workspace holding the planned variables
+  std::shared_ptr<Buffer> workspace_;
 
   ir::Module::Builder m_builder_;
 
@@ -14,12 +14,17 @@
 
 #include "cinn/hlir/framework/memory.h"
 
+#include <gflags/gflags.h>
+
 #ifdef CINN_WITH_CUDA
 #include <cuda.h>
 #include <cuda_runtime.h>
 
 #include "cinn/backends/cuda_util.h"
 #endif
+#include "cinn/hlir/framework/caching_allocator.h"
+
+DECLARE_bool(cinn_x86_use_caching_allocator);
 
 namespace cinn {
 namespace hlir {
@@ -57,7 +62,11 @@ class CudaMemoryMng : public MemoryInterface {
 
 MemoryManager::MemoryManager() {
   Register(Target::Arch::Unk, new X86MemoryMng);
-  Register(Target::Arch::X86, new X86MemoryMng);
+  if (FLAGS_cinn_x86_use_caching_allocator) {
+    Register(Target::Arch::X86, new CachingAllocator);
+  } else {
+    Register(Target::Arch::X86, new X86MemoryMng);
+  }
 #ifdef CINN_WITH_CUDA
   Register(Target::Arch::NVGPU, new CudaMemoryMng);
 #endif
@@ -0,0 +1,105 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/memory_planner.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+inline uint64_t AlignUp(uint64_t x, uint64_t alignment) { return (x + alignment - 1) & ~(alignment - 1); }
+
+inline bool IsLifetimeOverlapped(const TensorLifetime& lhs, const TensorLifetime& rhs) {
+  return lhs.first_use <= rhs.last_use && rhs.first_use <= lhs.last_use;
+}
+}  // namespace
+
+MemoryPlan PlanMemoryGreedyBySize(const std::vector<TensorLifetime>& tensors, uint64_t alignment) {
+  CHECK(alignment > 0 && (alignment & (alignment - 1)) == 0)
+      << "alignment should be a power of two, but got " << alignment;
+  MemoryPlan plan;
+
+  // the order is determined by size first, and then by the lifetime and the name to make the plan stable
+  std::vector<const TensorLifetime*> order;
+  int max_step = -1;
+  for (const auto& tensor : tensors) {
+    CHECK_LE(tensor.first_use, tensor.last_use) << "Invalid lifetime of tensor " << tensor.name;
+    order.push_back(&tensor);
+    plan.naive_size += AlignUp(tensor.size, alignment);
+    max_step = std::max(max_step, tensor.last_use);
+  }
+  std::sort(order.begin(), order.end(), [](const TensorLifetime* lhs, const TensorLifetime* rhs) {
+    if (lhs->size != rhs->size) return lhs->size > rhs->size;
+    if (lhs->first_use != rhs->first_use) return lhs->first_use < rhs->first_use;
+    return lhs->name < rhs->name;
+  });
+
+  struct Placement {
+    const TensorLifetime* tensor;
+    uint64_t offset;
+  };
+  // the placed tensors ordered by offset
+  std::vector<Placement> placed;
+  for (const auto* tensor : order) {
+    uint64_t size        = AlignUp(tensor->size, alignment);
+    uint64_t prev_end    = 0;
+    uint64_t best_offset = std::numeric_limits<uint64_t>::max();
+    uint64_t best_gap    = std::numeric_limits<uint64_t>::max();
+    for (const auto& placement : placed) {
+      if (!IsLifetimeOverlapped(*tensor, *placement.tensor)) continue;
+      if (placement.offset >= prev_end) {
+        uint64_t gap = placement.offset - prev_end;
+        if (gap >= size && gap < best_gap) {
+          best_gap    = gap;
+          best_offset = prev_end;
+        }
+      }
+      prev_end = std::max(prev_end, placement.offset + AlignUp(placement.tensor->size, alignment));
+    }
+    if (best_offset == std::numeric_limits<uint64_t>::max()) {
+      best_offset = prev_end;
+    }
+
+    auto pos = std::upper_bound(placed.begin(), placed.end(), best_offset, [](uint64_t offset, const Placement& p) {
+      return offset < p.offset;
+    });
+    placed.insert(pos, Placement{tensor, best_offset});
+    plan.offsets[tensor->name] = best_offset;
+    plan.workspace_size        = std::max(plan.workspace_size, best_offset + size);
+    VLOG(4) << "Plan tensor " << tensor->name << " of " << tensor->size << " bytes at offset " << best_offset;
+  }
+
+  // sweep the steps to find the peak of the alive bytes
+  std::vector<int64_t> delta(max_step + 2, 0);
+  for (const auto& tensor : tensors) {
+    delta[tensor.first_use] += AlignUp(tensor.size, alignment);
+    delta[tensor.last_use + 1] -= AlignUp(tensor.size, alignment);
+  }
+  int64_t alive = 0;
+  for (auto bytes : delta) {
+    alive += bytes;
+    plan.live_peak_size = std::max<uint64_t>(plan.live_peak_size, alive);
+  }
+  return plan;
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,62 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * The bytes of a tensor and the range of instruction steps [first_use, last_use] where it is alive.
+ */
+struct TensorLifetime {
+  std::string name;
+  uint64_t size{0};
+  int first_use{0};
+  int last_use{0};
+};
+
+/**
+ * The result of memory planning, every planned tensor is placed at an offset of one workspace.
+ */
+struct MemoryPlan {
+  // mapping a tensor's name to its offset in the workspace
+  std::map<std::string, uint64_t> offsets;
+  // bytes of the workspace holding all the planned tensors
+  uint64_t workspace_size{0};
+  // bytes needed if every tensor holds its own buffer
+  uint64_t naive_size{0};
+  // the maximum bytes of the tensors alive at the same step, the lower bound of workspace_size
+  uint64_t live_peak_size{0};
+};
+
+/**
+ * Plan the tensors into one workspace by the greedy-by-size strategy: tensors are placed from the largest to the
+ * smallest, each one is put in the smallest gap between the placed tensors whose lifetimes overlap with it, or
+ * after all of them if no gap fits. Tensors with disjoint lifetimes may share the same memory.
+ *
+ * @param tensors The tensors to plan.
+ * @param alignment The alignment of every offset, should be a power of two.
+ */
+MemoryPlan PlanMemoryGreedyBySize(const std::vector<TensorLifetime>& tensors, uint64_t alignment);
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,119 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/memory_planner.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/optimize.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/utils/data_util.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+// no two tensors alive at the same step occupy the same bytes
+void CheckPlanValid(const std::vector<TensorLifetime>& tensors, const MemoryPlan& plan, uint64_t alignment) {
+  for (int i = 0; i < tensors.size(); ++i) {
+    uint64_t offset_i = plan.offsets.at(tensors[i].name);
+    ASSERT_EQ(offset_i % alignment, 0);
+    ASSERT_LE(offset_i + tensors[i].size, plan.workspace_size);
+    for (int j = i + 1; j < tensors.size(); ++j) {
+      uint64_t offset_j = plan.offsets.at(tensors[j].name);
+      bool live_overlapped =
+          tensors[i].first_use <= tensors[j].last_use && tensors[j].first_use <= tensors[i].last_use;
+      bool memory_overlapped = offset_i < offset_j + tensors[j].size && offset_j < offset_i + tensors[i].size;
+      ASSERT_FALSE(live_overlapped && memory_overlapped) << tensors[i].name << " and " << tensors[j].name;
+    }
+  }
+}
+
+TEST(MemoryPlanner, ShareDisjointLifetimes) {
+  std::vector<TensorLifetime> tensors = {{"a", 1000, 0, 1}, {"b", 1000, 1, 2}, {"c", 1000, 2, 3}, {"d", 500, 3, 4}};
+  auto plan                           = PlanMemoryGreedyBySize(tensors, 64);
+  CheckPlanValid(tensors, plan, 64);
+  // a and c, b and d can share the memory
+  ASSERT_EQ(plan.offsets.at("a"), plan.offsets.at("c"));
+  ASSERT_EQ(plan.offsets.at("b"), plan.offsets.at("d"));
+  ASSERT_EQ(plan.workspace_size, 2048);
+  ASSERT_EQ(plan.naive_size, 1024 * 3 + 512);
+  ASSERT_EQ(plan.live_peak_size, 2048);
+}
+
+TEST(MemoryPlanner, FillGap) {
+  // c is alive together with a and b, but fits in the gap left by the freed x
+  std::vector<TensorLifetime> tensors = {
+      {"x", 256, 0, 1}, {"a", 1024, 0, 3}, {"b", 512, 0, 3}, {"y", 256, 0, 1}, {"c", 256, 2, 3}};
+  auto plan = PlanMemoryGreedyBySize(tensors, 256);
+  CheckPlanValid(tensors, plan, 256);
+  ASSERT_EQ(plan.workspace_size, 2048);
+}
+
+TEST(MemoryPlanner, RandomLifetimes) {
+  std::mt19937 rng(0);
+  std::vector<TensorLifetime> tensors;
+  for (int i = 0; i < 200; ++i) {
+    int first_use = rng() % 100;
+    tensors.push_back({"t" + std::to_string(i), rng() % 100000 + 1, first_use, first_use + int(rng() % 10)});
+  }
+  auto plan = PlanMemoryGreedyBySize(tensors, 1024);
+  CheckPlanValid(tensors, plan, 1024);
+  ASSERT_GE(plan.workspace_size, plan.live_peak_size);
+  ASSERT_LT(plan.workspace_size, plan.naive_size);
+  LOG(INFO) << "workspace: " << plan.workspace_size << ", naive: " << plan.naive_size
+            << ", live peak: " << plan.live_peak_size;
+}
+
+std::vector<float> RunChainGraph(bool with_memory_plan) {
+  frontend::NetBuilder builder("memory_plan");
+  frontend::Variable x = builder.CreateInput(Float(32), {64, 64}, "x");
+  for (int i = 0; i < 8; ++i) {
+    auto w = builder.CreateInput(Float(32), {64, 64}, "w_" + std::to_string(i));
+    x      = builder.Relu(builder.Matmul(x, w));
+  }
+  auto target  = common::DefaultHostTarget();
+  auto program = builder.Build();
+  auto graph   = frontend::Optimize(&program, {x->id}, target);
+  auto scope   = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  options.with_memory_plan           = with_memory_plan;
+  auto runtime_program               = gc.Build(options, {x->id}).runtime_program;
+
+  SetRandData<float>(scope->GetTensor("x"), target, 0);
+  for (int i = 0; i < 8; ++i) {
+    SetRandData<float>(scope->GetTensor("w_" + std::to_string(i)), target, i + 1);
+  }
+  runtime_program->Execute();
+  return GetTensorData<float>(scope->GetTensor(x->id), target);
+}
+
+TEST(MemoryPlanner, GraphCompiler) {
+  auto expected = RunChainGraph(false);
+  auto results  = RunChainGraph(true);
+  ASSERT_EQ(expected.size(), results.size());
+  for (int i = 0; i < expected.size(); ++i) {
+    ASSERT_FLOAT_EQ(expected[i], results[i]);
+  }
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
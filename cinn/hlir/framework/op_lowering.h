@@ -60,6 +60,8 @@ class OpLowerer {
   std::vector<ir::LoweredFunc> Lower(GroupPtr& group);
   std::vector<ir::LoweredFunc> LowerWithoutSchedule(GroupPtr& group);
 
+  const absl::flat_hash_map<std::string, Type>& type_dict() const { return type_dict_; }
+
  private:
   std::vector<ir::LoweredFunc> IRLowerOp(IRComputeFunction, IRScheduleFunction, GroupPtr&);
   std::vector<ir::LoweredFunc> IRLowerNonFusibleOp(GroupPtr&, bool);
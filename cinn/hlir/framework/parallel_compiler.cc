@@ -41,10 +41,32 @@ std::vector<std::unique_ptr<Instruction>> ParallelCompiler::operator()() {
   if (graph_->fusion_groups.size() == 0) {
     hlir::framework::ApplyPasses(graph_.get(), {"BuildNonFusedGroupsPass"});
   }
-  // Task Spilt
-  SplitTask();
-  // launch task
-  LaunchTask();
+  // reuse the code compiled for the same graph before
+  auto* cache = CompilationCache::Global();
+  GraphSignature signature;
+  if (cache) {
+    signature = ComputeGraphSignature(graph_.get(), target_, option_.lowered_funcs);
+    proto::CompiledGraph compiled_graph;
+    if (cache->Load(signature.fingerprint, &compiled_graph) && LoadFromCache(compiled_graph, signature)) {
+      VLOG(2) << "Load the compiled graph " << signature.fingerprint << " from the compilation cache";
+      return MergeResult();
+    }
+  }
+  // skip the groups compiled by the previous compilations
+  ReuseCompiledGroups();
+  if (!pending_groups_.empty()) {
+    // Task Spilt
+    SplitTask();
+    // launch task
+    LaunchTask();
+    KeepCompiledGroups();
+  }
+  if (cache) {
+    proto::CompiledGraph compiled_graph;
+    if (DumpToCache(signature, &compiled_graph)) {
+      cache->Store(signature.fingerprint, compiled_graph);
+    }
+  }
   // merge instruction
   return MergeResult();
 }
@@ -69,16 +91,16 @@ void ParallelCompiler::SplitTask() {
   CHECK(graph_->fusion_groups.size() == option_.lowered_funcs.size() || option_.lowered_funcs.size() == 0);
   // split task
   int max_task_num =
-      FLAGS_cinn_parallel_compile_thread > 0 ? FLAGS_cinn_parallel_compile_thread : graph_->fusion_groups.size();
+      FLAGS_cinn_parallel_compile_thread > 0 ? FLAGS_cinn_parallel_compile_thread : pending_groups_.size();
 
-  int group_per_task = graph_->fusion_groups.size();
+  int group_per_task = pending_groups_.size();
   if (max_task_num > 1) {
     group_per_task = FLAGS_cinn_parallel_compile_size > 0
                          ? FLAGS_cinn_parallel_compile_size
-                         : ((graph_->fusion_groups.size() + max_task_num - 1) / max_task_num);
+                         : ((pending_groups_.size() + max_task_num - 1) / max_task_num);
   }
 
-  for (int idx = 0; idx < graph_->fusion_groups.size(); idx += group_per_task) {
+  for (int idx = 0; idx < pending_groups_.size(); idx += group_per_task) {
     tasks_.emplace_back(this, scope_, graph_, option_, target_);
   }
   VLOG(2) << "Split task to " << tasks_.size() << " sub-task!";
@@ -116,6 +138,9 @@ std::vector<std::unique_ptr<Instruction>> ParallelCompiler::MergeResult() {
       res[task.gidx[idx]] = std::move(task.instructions[idx]);
     }
   }
+  for (int idx = 0; idx < reused_gidx_.size(); ++idx) {
+    res[reused_gidx_[idx]] = std::move(reused_instructions_[idx]);
+  }
   return std::move(res);
 }
 
@@ -182,12 +207,15 @@ void ParallelCompiler::Task::CodegenAndJit() {
 
     // load cumodule
     cumodule.reset(new CUDAModule(ptx, compiler.compile_to_cubin() ? CUDAModule::Kind::CUBIN : CUDAModule::Kind::PTX));
+    device_code          = ptx;
+    device_code_is_cubin = compiler.compile_to_cubin();
     // register kernel
     backends::RuntimeSymbols symbols;
     for (auto& fn : dmodule.functions()) {
       auto cufunc = cumodule->GetFunction(0, fn->name);
       CHECK(cufunc);
       symbols.RegisterVar(fn->name + "_ptr_", reinterpret_cast<void*>(cufunc));
+      device_func_names.push_back(fn->name);
     }
     engine = backends::ExecutionEngine::Create(backends::ExecutionOptions(), std::move(symbols));
     engine->Link<backends::CodeGenCUDA_Host>(hmodule);
@@ -216,10 +244,213 @@ void ParallelCompiler::Task::BuildInstruction() {
   }
 }
 
+bool ParallelCompiler::LoadFromCache(const proto::CompiledGraph& compiled_graph, const GraphSignature& signature) {
+  // each group should be built exactly once, and the variables should be in the graph
+  std::vector<bool> built(graph_->fusion_groups.size(), false);
+  auto valid_vars = [&signature](const google::protobuf::RepeatedField<int32_t>& vars) {
+    return std::all_of(
+        vars.begin(), vars.end(), [&signature](int var) { return var >= 0 && var < signature.var_names.size(); });
+  };
+  for (auto& compiled_task : compiled_graph.tasks()) {
+    for (auto& compiled_instr : compiled_task.instructions()) {
+      int idx = compiled_instr.group_index();
+      if (idx < 0 || idx >= built.size() || built[idx] || !valid_vars(compiled_instr.input_vars()) ||
+          !valid_vars(compiled_instr.output_vars())) {
+        LOG(WARNING) << "The compiled graph " << compiled_graph.fingerprint() << " doesn't match the graph";
+        return false;
+      }
+      built[idx] = true;
+    }
+  }
+  if (std::count(built.begin(), built.end(), false)) {
+    LOG(WARNING) << "The compiled graph " << compiled_graph.fingerprint() << " doesn't match the graph";
+    return false;
+  }
+
+  for (auto& compiled_task : compiled_graph.tasks()) {
+    tasks_.emplace_back(this, scope_, graph_, option_, target_);
+    tasks_.back().LoadFromCache(compiled_task, signature);
+  }
+  return true;
+}
+
+bool ParallelCompiler::DumpToCache(const GraphSignature& signature, proto::CompiledGraph* compiled_graph) {
+  if (!reused_gidx_.empty()) {
+    VLOG(2) << "Some groups are reused from the compiled group cache, skip the compilation cache";
+    return false;
+  }
+  compiled_graph->set_fingerprint(signature.fingerprint);
+  for (auto& task : tasks_) {
+    if (!task.DumpToCache(signature, compiled_graph->add_tasks())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ParallelCompiler::Task::LoadFromCache(const proto::CompiledTask& compiled_task, const GraphSignature& signature) {
+  if (target == common::DefaultNVGPUTarget()) {
+#ifdef CINN_WITH_CUDA
+    using runtime::cuda::CUDAModule;
+    cumodule.reset(new CUDAModule(compiled_task.device_code(),
+                                  compiled_task.device_code_is_cubin() ? CUDAModule::Kind::CUBIN
+                                                                       : CUDAModule::Kind::PTX));
+    backends::RuntimeSymbols symbols;
+    for (auto& fn_name : compiled_task.device_func_names()) {
+      auto cufunc = cumodule->GetFunction(0, fn_name);
+      CHECK(cufunc) << "Can't find the cached kernel : " << fn_name;
+      symbols.RegisterVar(fn_name + "_ptr_", reinterpret_cast<void*>(cufunc));
+    }
+    engine = backends::ExecutionEngine::Create(backends::ExecutionOptions(), std::move(symbols));
+#endif
+  } else {
+    engine = backends::ExecutionEngine::Create(backends::ExecutionOptions());
+  }
+  engine->AddObject(compiled_task.host_object());
+
+  auto to_var_names = [&signature](const google::protobuf::RepeatedField<int32_t>& vars) {
+    std::vector<std::string> names;
+    for (int var : vars) {
+      names.push_back(signature.var_names[var]);
+    }
+    return names;
+  };
+  for (auto& compiled_instr : compiled_task.instructions()) {
+    const auto& fn_name = compiled_instr.func_name();
+    auto input_names    = to_var_names(compiled_instr.input_vars());
+    auto output_names   = to_var_names(compiled_instr.output_vars());
+    auto instr =
+        std::unique_ptr<Instruction>(new Instruction(target, scope.get(), input_names, output_names, fn_name));
+    auto fn_ptr = engine->Lookup(fn_name);
+    CHECK(fn_ptr) << "Can't find the cached function : " << fn_name;
+    instr->SetLoweredFunc(reinterpret_cast<void*>(fn_ptr), fn_name);
+
+    instr->Finalize();
+    gidx.push_back(compiled_instr.group_index());
+    instructions.push_back(std::move(instr));
+  }
+}
+
+bool ParallelCompiler::Task::DumpToCache(const GraphSignature& signature, proto::CompiledTask* compiled_task) {
+  compiled_task->set_host_object(engine->GetObject().str());
+  compiled_task->set_device_code(device_code);
+  compiled_task->set_device_code_is_cubin(device_code_is_cubin);
+  for (auto& fn_name : device_func_names) {
+    compiled_task->add_device_func_names(fn_name);
+  }
+
+  // the variables are recorded by their indices in the signature, since the names may differ in another process
+  auto add_vars = [&signature](const std::vector<std::string>& names, google::protobuf::RepeatedField<int32_t>* vars) {
+    for (auto& name : names) {
+      auto it = signature.var_indices.find(name);
+      if (it == signature.var_indices.end()) {
+        VLOG(2) << "Variable " << name << " isn't in the graph, skip the compilation cache";
+        return false;
+      }
+      vars->Add(it->second);
+    }
+    return true;
+  };
+  for (int idx : gidx) {
+    auto& group          = graph->fusion_groups[idx];
+    auto* compiled_instr = compiled_task->add_instructions();
+    compiled_instr->set_group_index(idx);
+    compiled_instr->set_func_name(group->GetFuncName());
+    if (!add_vars(group->input_names, compiled_instr->mutable_input_vars()) ||
+        !add_vars(group->output_names, compiled_instr->mutable_output_vars())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ParallelCompiler::ReuseCompiledGroups() {
+  auto* group_cache = CompiledGroupCache::Global();
+  if (!group_cache) {
+    for (int idx = 0; idx < graph_->fusion_groups.size(); ++idx) {
+      pending_groups_.push_back(idx);
+    }
+    return;
+  }
+
+  for (int idx = 0; idx < graph_->fusion_groups.size(); ++idx) {
+    auto& group = graph_->fusion_groups[idx];
+    group_signatures_.push_back(option_.lowered_funcs.empty()
+                                    ? ComputeGroupSignature(graph_.get(), group, target_)
+                                    : ComputeGroupSignature(graph_.get(), group, target_, option_.lowered_funcs[idx]));
+    auto& signature     = group_signatures_.back();
+    auto compiled_group = group_cache->Find(signature.fingerprint);
+    if (!compiled_group) {
+      pending_groups_.push_back(idx);
+      continue;
+    }
+
+    VLOG(2) << "Reuse the compiled function " << compiled_group->func_name << " for Group " << idx;
+    // the arguments are set as lowering the group does
+    group->input_names.clear();
+    group->output_names.clear();
+    for (int var : compiled_group->input_vars) {
+      group->input_names.push_back(signature.var_names[var]);
+    }
+    for (int var : compiled_group->output_vars) {
+      group->output_names.push_back(signature.var_names[var]);
+    }
+    auto instr = std::unique_ptr<Instruction>(new Instruction(
+        target_, scope_.get(), group->input_names, group->output_names, compiled_group->func_name));
+    auto fn_ptr = compiled_group->engine->Lookup(compiled_group->func_name);
+    CHECK(fn_ptr) << "Can't find the compiled function : " << compiled_group->func_name;
+    instr->SetLoweredFunc(reinterpret_cast<void*>(fn_ptr), compiled_group->func_name);
+
+    instr->Finalize();
+    reused_gidx_.push_back(idx);
+    reused_groups_.push_back(std::move(compiled_group));
+    reused_instructions_.push_back(std::move(instr));
+  }
+  VLOG(2) << "Reuse " << reused_gidx_.size() << " compiled groups, and compile " << pending_groups_.size()
+          << " groups";
+}
+
+void ParallelCompiler::KeepCompiledGroups() {
+  auto* group_cache = CompiledGroupCache::Global();
+  if (!group_cache) {
+    return;
+  }
+  auto to_var_indices = [](const GraphSignature& signature,
+                           const std::vector<std::string>& names,
+                           std::vector<int>* vars) {
+    for (auto& name : names) {
+      auto it = signature.var_indices.find(name);
+      if (it == signature.var_indices.end()) {
+        return false;
+      }
+      vars->push_back(it->second);
+    }
+    return true;
+  };
+  for (auto& task : tasks_) {
+    for (int idx : task.gidx) {
+      auto& group               = graph_->fusion_groups[idx];
+      auto& signature           = group_signatures_[idx];
+      auto compiled_group       = std::make_shared<CompiledGroup>();
+      compiled_group->func_name = group->GetFuncName();
+      compiled_group->engine    = task.engine;
+#ifdef CINN_WITH_CUDA
+      compiled_group->cumodule = task.cumodule;
+#endif
+      if (!to_var_indices(signature, group->input_names, &compiled_group->input_vars) ||
+          !to_var_indices(signature, group->output_names, &compiled_group->output_vars)) {
+        VLOG(2) << "The arguments of Group " << idx << " aren't all accessed by it, skip caching the group";
+        continue;
+      }
+      group_cache->Insert(signature.fingerprint, std::move(compiled_group));
+    }
+  }
+}
+
 int ParallelCompiler::GetGroupIdx() {
   std::lock_guard<std::mutex> lock(mtx_);
-  if (index < graph_->fusion_groups.size()) {
-    return index++;
+  if (index < pending_groups_.size()) {
+    return pending_groups_[index++];
   } else {
     return -1;
   }
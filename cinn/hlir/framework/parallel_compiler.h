@@ -18,6 +18,7 @@
 
 #include "cinn/backends/llvm/execution_engine.h"
 #include "cinn/common/target.h"
+#include "cinn/hlir/framework/compilation_cache.h"
 #include "cinn/hlir/framework/graph.h"
 #include "cinn/hlir/framework/instruction.h"
 #include "cinn/hlir/framework/op_lowering.h"
@@ -48,6 +49,14 @@ class ParallelCompiler {
   void SplitTask();
   void LaunchTask();
   std::vector<std::unique_ptr<Instruction>> MergeResult();
+  // build the tasks from a graph compiled before, returns false if it doesn't match the graph
+  bool LoadFromCache(const proto::CompiledGraph& compiled_graph, const GraphSignature& signature);
+  // dump the compiled tasks, returns false if any of them can't be cached
+  bool DumpToCache(const GraphSignature& signature, proto::CompiledGraph* compiled_graph);
+  // build the instructions of the groups compiled by the previous compilations, and collect the others to compile
+  void ReuseCompiledGroups();
+  // keep the groups compiled by the tasks for the later compilations
+  void KeepCompiledGroups();
 
  public:
   struct Task {
@@ -58,9 +67,14 @@ class ParallelCompiler {
          const CompileOptions& cp,
          const Target& t)
         : compiler(p), scope(s), graph(g), options(cp), target(t) {}
+    // only movable since the instructions can't be copied
+    Task(Task&& other) = default;
     void Lowering();
     void CodegenAndJit();
     void BuildInstruction();
+    // load the code and build the instructions compiled by a previous task
+    void LoadFromCache(const proto::CompiledTask& compiled_task, const GraphSignature& signature);
+    bool DumpToCache(const GraphSignature& signature, proto::CompiledTask* compiled_task);
 
    public:
     const Target target;
@@ -74,10 +88,14 @@ class ParallelCompiler {
     std::vector<std::vector<ir::LoweredFunc>> lowered_funcs;
 
    public:
-    std::unique_ptr<backends::ExecutionEngine> engine;
+    std::shared_ptr<backends::ExecutionEngine> engine;
 #ifdef CINN_WITH_CUDA
-    std::unique_ptr<runtime::cuda::CUDAModule> cumodule;
+    std::shared_ptr<runtime::cuda::CUDAModule> cumodule;
 #endif
+    // the device code and its kernels, kept for the compilation cache
+    std::string device_code;
+    bool device_code_is_cubin{false};
+    std::vector<std::string> device_func_names;
   };
   std::vector<Task> tasks_;
   int GetGroupIdx();
@@ -85,6 +103,14 @@ class ParallelCompiler {
  private:
   int index{0};
   std::mutex mtx_;
+  // the indices of the groups to compile
+  std::vector<int> pending_groups_;
+  // the signatures of the groups, computed only if the compiled groups are cached
+  std::vector<GraphSignature> group_signatures_;
+  // the groups reused from the compiled group cache, and the instructions built for them
+  std::vector<int> reused_gidx_;
+  std::vector<std::shared_ptr<CompiledGroup>> reused_groups_;
+  std::vector<std::unique_ptr<Instruction>> reused_instructions_;
 
   const common::Target target_;
   const CompileOptions& option_;
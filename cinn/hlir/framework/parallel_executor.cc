@@ -0,0 +1,301 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/parallel_executor.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+ParallelExecutor::ParallelExecutor(const std::vector<std::unique_ptr<Instruction>>& instrs,
+                                   Scope* scope,
+                                   int num_threads)
+    : instrs_(instrs), num_threads_(num_threads) {
+  CHECK_GT(num_threads_, 0) << "num_threads should be greater than 0";
+  BuildDependencies(scope);
+
+  pending_.reset(new std::atomic<int>[instrs_.size()]);
+  for (int tid = 0; tid < num_threads_; ++tid) {
+    queues_.emplace_back(new WorkQueue);
+  }
+  // the calling thread works as the 0-th worker, so only `num_threads_ - 1` threads are launched
+  for (int tid = 1; tid < num_threads_; ++tid) {
+    workers_.emplace_back(&ParallelExecutor::WorkerLoop, this, tid);
+  }
+  VLOG(3) << "ParallelExecutor with " << num_threads_ << " threads runs " << instrs_.size()
+          << " instructions, max parallelism: " << MaxParallelism();
+}
+
+ParallelExecutor::~ParallelExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ParallelExecutor::BuildDependencies(Scope* scope) {
+  int num_instrs = instrs_.size();
+  successors_.assign(num_instrs, {});
+  num_predecessors_.assign(num_instrs, 0);
+  roots_.clear();
+
+  // map each variable to a resource id, variables sharing one buffer(such as the output of a
+  // reshape reusing its input) are mapped to the same resource
+  absl::flat_hash_map<std::string, int> name2resource;
+  absl::flat_hash_map<const Buffer*, int> buffer2resource;
+  struct MemoryRange {
+    uintptr_t begin;
+    uintptr_t end;
+    int resource;
+  };
+  std::vector<MemoryRange> ranges;
+  auto get_resource = [&](const std::string& name) -> int {
+    auto it = name2resource.find(name);
+    if (it != name2resource.end()) {
+      return it->second;
+    }
+    int resource = name2resource.size();
+    auto* var    = scope ? scope->FindVar(name) : nullptr;
+    if (var) {
+      const Buffer* buffer = absl::get<Tensor>(*var)->get_buffer().get();
+      auto inserted        = buffer2resource.try_emplace(buffer, resource);
+      resource             = inserted.first->second;
+      if (inserted.second && buffer->data()->memory) {
+        auto begin = reinterpret_cast<uintptr_t>(buffer->data()->memory);
+        ranges.push_back({begin, begin + buffer->data()->memory_size, resource});
+      }
+    }
+    name2resource.emplace(name, resource);
+    return resource;
+  };
+  for (const auto& instr : instrs_) {
+    for (const auto& args : instr->GetInArgs()) {
+      std::for_each(args.begin(), args.end(), get_resource);
+    }
+    for (const auto& args : instr->GetOutArgs()) {
+      std::for_each(args.begin(), args.end(), get_resource);
+    }
+  }
+
+  // different buffers may share one memory planned by the memory planner, writing
+  // to a buffer is regarded as writing to all the buffers overlapped with it
+  absl::flat_hash_map<int, std::vector<int>> overlapped_resources;
+  std::sort(ranges.begin(), ranges.end(), [](const MemoryRange& lhs, const MemoryRange& rhs) {
+    return lhs.begin < rhs.begin;
+  });
+  for (int i = 0; i < ranges.size(); ++i) {
+    for (int j = i + 1; j < ranges.size() && ranges[j].begin < ranges[i].end; ++j) {
+      overlapped_resources[ranges[i].resource].push_back(ranges[j].resource);
+      overlapped_resources[ranges[j].resource].push_back(ranges[i].resource);
+    }
+  }
+
+  absl::flat_hash_map<int, int> last_writer;
+  absl::flat_hash_map<int, std::vector<int>> readers_since_write;
+  std::vector<std::unordered_set<int>> predecessors(num_instrs);
+  auto add_edge = [&](int from, int to) {
+    if (from != to && predecessors[to].insert(from).second) {
+      successors_[from].push_back(to);
+    }
+  };
+
+  for (int idx = 0; idx < num_instrs; ++idx) {
+    const auto& instr = instrs_[idx];
+    std::unordered_set<int> reads, writes;
+    for (const auto& args : instr->GetInArgs()) {
+      for (const auto& name : args) {
+        reads.insert(get_resource(name));
+      }
+    }
+    for (const auto& args : instr->GetOutArgs()) {
+      for (const auto& name : args) {
+        writes.insert(get_resource(name));
+      }
+    }
+    // a buffer malloc instruction takes the variables as inputs but changes their memory
+    auto fn_names = instr->GetFnNames();
+    if (std::any_of(fn_names.begin(), fn_names.end(), [](const std::string& name) {
+          return utils::Startswith(name, "malloc_buffer_instruction");
+        })) {
+      writes.insert(reads.begin(), reads.end());
+      reads.clear();
+    }
+    std::vector<int> direct_writes(writes.begin(), writes.end());
+    for (int resource : direct_writes) {
+      auto it = overlapped_resources.find(resource);
+      if (it != overlapped_resources.end()) {
+        writes.insert(it->second.begin(), it->second.end());
+      }
+    }
+
+    for (int resource : reads) {
+      if (writes.count(resource)) continue;
+      if (last_writer.count(resource)) {
+        add_edge(last_writer.at(resource), idx);
+      }
+      readers_since_write[resource].push_back(idx);
+    }
+    for (int resource : writes) {
+      if (last_writer.count(resource)) {
+        add_edge(last_writer.at(resource), idx);
+      }
+      for (int reader : readers_since_write[resource]) {
+        add_edge(reader, idx);
+      }
+      readers_since_write[resource].clear();
+      last_writer[resource] = idx;
+    }
+  }
+
+  for (int idx = 0; idx < num_instrs; ++idx) {
+    num_predecessors_[idx] = predecessors[idx].size();
+    if (num_predecessors_[idx] == 0) {
+      roots_.push_back(idx);
+    }
+  }
+}
+
+int ParallelExecutor::MaxParallelism() const {
+  // the instructions are in a topological order already, so the level of each one
+  // can be computed by one pass
+  std::vector<int> level(instrs_.size(), 0);
+  absl::flat_hash_map<int, int> level_width;
+  int max_width = 0;
+  for (int idx = 0; idx < instrs_.size(); ++idx) {
+    max_width = std::max(max_width, ++level_width[level[idx]]);
+    for (int succ : successors_[idx]) {
+      level[succ] = std::max(level[succ], level[idx] + 1);
+    }
+  }
+  return max_width;
+}
+
+void ParallelExecutor::Run(const std::map<std::string, cinn_pod_value_t>* name2podargs, void* stream, bool use_cache) {
+  if (instrs_.empty()) return;
+
+  name2podargs_ = name2podargs;
+  stream_       = stream;
+  use_cache_    = use_cache;
+  for (int idx = 0; idx < instrs_.size(); ++idx) {
+    pending_[idx].store(num_predecessors_[idx], std::memory_order_relaxed);
+  }
+  remaining_.store(instrs_.size(), std::memory_order_release);
+  // distribute the root instructions to all workers in a round-robin way
+  for (int i = 0; i < roots_.size(); ++i) {
+    PushTask(i % num_threads_, roots_[i]);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    ++round_;
+  }
+  cv_.notify_all();
+
+  DrainTasks(0);
+}
+
+void ParallelExecutor::WorkerLoop(int tid) {
+  int64_t finished_round = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      cv_.wait(lock, [this, finished_round] { return stop_ || round_ != finished_round; });
+      if (stop_) return;
+      finished_round = round_;
+    }
+    DrainTasks(tid);
+  }
+}
+
+void ParallelExecutor::DrainTasks(int tid) {
+  while (remaining_.load(std::memory_order_acquire) > 0) {
+    int idx = PopOrSteal(tid);
+    if (idx >= 0) {
+      RunInstruction(tid, idx);
+      continue;
+    }
+    // sleep until new tasks are pushed or all the instructions finished,
+    // instead of spinning and competing with the threads inside kernels
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this] { return stop_ || queued_.load() > 0 || remaining_.load() == 0; });
+    if (stop_) return;
+  }
+}
+
+void ParallelExecutor::RunInstruction(int tid, int idx) {
+  VLOG(4) << "Thread-" << tid << " runs the " << idx << "-th instruction";
+  instrs_[idx]->Run(name2podargs_, false, stream_, use_cache_);
+  for (int succ : successors_[idx]) {
+    if (pending_[succ].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      PushTask(tid, succ);
+    }
+  }
+  if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    { std::lock_guard<std::mutex> lock(mtx_); }
+    cv_.notify_all();
+  }
+}
+
+void ParallelExecutor::PushTask(int tid, int idx) {
+  {
+    std::lock_guard<std::mutex> lock(queues_[tid]->mtx);
+    queues_[tid]->tasks.push_back(idx);
+  }
+  queued_.fetch_add(1, std::memory_order_release);
+  // the idle workers and the ones waiting for a new round share cv_, notifying only one of
+  // them may wake a worker whose predicate is still false and lose the wakeup
+  { std::lock_guard<std::mutex> lock(mtx_); }
+  cv_.notify_all();
+}
+
+int ParallelExecutor::PopOrSteal(int tid) {
+  // take the latest pushed task of its own for locality
+  {
+    auto& queue = *queues_[tid];
+    std::lock_guard<std::mutex> lock(queue.mtx);
+    if (!queue.tasks.empty()) {
+      int idx = queue.tasks.back();
+      queue.tasks.pop_back();
+      queued_.fetch_sub(1, std::memory_order_acq_rel);
+      return idx;
+    }
+  }
+  // steal the oldest task from others
+  for (int i = 1; i < num_threads_; ++i) {
+    auto& queue = *queues_[(tid + i) % num_threads_];
+    std::lock_guard<std::mutex> lock(queue.mtx);
+    if (!queue.tasks.empty()) {
+      int idx = queue.tasks.front();
+      queue.tasks.pop_front();
+      queued_.fetch_sub(1, std::memory_order_acq_rel);
+      return idx;
+    }
+  }
+  return -1;
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
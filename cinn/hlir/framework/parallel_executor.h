@@ -0,0 +1,113 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cinn/common/macros.h"
+#include "cinn/hlir/framework/instruction.h"
+#include "cinn/hlir/framework/scope.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * ParallelExecutor runs the instructions of a Program concurrently according to the data dependencies between them.
+ *
+ * A dependency DAG is built once from the in/out arguments of each instruction: an instruction depends on the last
+ * writer of every variable it touches (read-after-write and write-after-write) and a writer depends on all readers
+ * since the previous write (write-after-read). Variables sharing one buffer are treated as the same resource.
+ * Ready instructions are distributed to per-thread queues, idle workers steal from the others, and the calling
+ * thread takes part in the execution as worker 0.
+ */
+class ParallelExecutor {
+ public:
+  /**
+   * Constructor.
+   * @param instrs The instructions to run, they must outlive the executor and keep their order.
+   * @param scope The scope used to find the variables sharing one buffer, can be null.
+   * @param num_threads The number of threads(including the calling thread) used to run instructions.
+   */
+  ParallelExecutor(const std::vector<std::unique_ptr<Instruction>>& instrs, Scope* scope, int num_threads);
+  ~ParallelExecutor();
+
+  /**
+   * Run all the instructions once, returns after every instruction finished.
+   */
+  void Run(const std::map<std::string, cinn_pod_value_t>* name2podargs = nullptr,
+           void* stream                                                = nullptr,
+           bool use_cache                                              = true);
+
+  int num_threads() const { return num_threads_; }
+
+  // the instructions directly depending on the idx-th instruction
+  const std::vector<int>& successors(int idx) const { return successors_.at(idx); }
+
+  // the number of instructions in the widest level of the dependency DAG
+  int MaxParallelism() const;
+
+ private:
+  void BuildDependencies(Scope* scope);
+
+  void WorkerLoop(int tid);
+  // run ready instructions until all the instructions of the current round finished
+  void DrainTasks(int tid);
+  void RunInstruction(int tid, int idx);
+  void PushTask(int tid, int idx);
+  // pop a task from the own queue, or steal one from others, return -1 if none found
+  int PopOrSteal(int tid);
+
+  struct WorkQueue {
+    std::mutex mtx;
+    std::deque<int> tasks;
+  };
+
+  const std::vector<std::unique_ptr<Instruction>>& instrs_;
+  int num_threads_;
+
+  std::vector<std::vector<int>> successors_;
+  std::vector<int> num_predecessors_;
+  std::vector<int> roots_;
+
+  // the state of the current round
+  std::unique_ptr<std::atomic<int>[]> pending_;
+  std::atomic<int> remaining_{0};
+  std::atomic<int> queued_{0};
+  const std::map<std::string, cinn_pod_value_t>* name2podargs_{nullptr};
+  void* stream_{nullptr};
+  bool use_cache_{true};
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  int64_t round_{0};
+  bool stop_{false};
+
+  CINN_DISALLOW_COPY_AND_ASSIGN(ParallelExecutor);
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
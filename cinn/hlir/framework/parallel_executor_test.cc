@@ -0,0 +1,113 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/parallel_executor.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/optimize.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/utils/data_util.h"
+#include "cinn/utils/timer.h"
+
+DECLARE_int32(cinn_parallel_execute_threads);
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+void AddInstruction(const std::vector<std::string>& in_args,
+                    const std::vector<std::string>& out_args,
+                    std::vector<std::unique_ptr<Instruction>>* instrs) {
+  instrs->emplace_back(new Instruction(common::DefaultHostTarget(), nullptr, in_args, out_args, "fn"));
+}
+}  // namespace
+
+TEST(ParallelExecutor, BuildDependencies) {
+  std::vector<std::unique_ptr<Instruction>> instrs;
+  AddInstruction({"x"}, {"a"}, &instrs);       // 0
+  AddInstruction({"x"}, {"b"}, &instrs);       // 1
+  AddInstruction({"a", "b"}, {"c"}, &instrs);  // 2: read after write
+  AddInstruction({"y"}, {"x"}, &instrs);       // 3: write after read
+  AddInstruction({"c"}, {"c"}, &instrs);       // 4: inplace
+
+  ParallelExecutor executor(instrs, nullptr, 2);
+  EXPECT_EQ(executor.successors(0), std::vector<int>({2, 3}));
+  EXPECT_EQ(executor.successors(1), std::vector<int>({2, 3}));
+  EXPECT_EQ(executor.successors(2), std::vector<int>({4}));
+  EXPECT_TRUE(executor.successors(3).empty());
+  EXPECT_EQ(executor.MaxParallelism(), 2);
+}
+
+// Build a graph with `num_branches` independent towers reading the same input, then sum them up
+std::shared_ptr<Graph> BuildBranchyGraph(int num_branches, const common::Target& target, std::string* output_name) {
+  frontend::NetBuilder builder("branchy_graph");
+  auto x = builder.CreateInput(Float(32), {128, 512}, "x");
+  std::vector<frontend::Variable> branches;
+  for (int i = 0; i < num_branches; ++i) {
+    auto w = builder.CreateInput(Float(32), {512, 512}, "w_" + std::to_string(i));
+    auto y = builder.Matmul(x, w);
+    branches.emplace_back(builder.Tanh(builder.Relu(y)));
+  }
+  auto out = branches.front();
+  for (int i = 1; i < branches.size(); ++i) {
+    out = builder.Add(out, branches[i]);
+  }
+  *output_name = out->id;
+  auto program = builder.Build();
+  return frontend::Optimize(&program, {out->id}, target);
+}
+
+TEST(ParallelExecutor, BranchyGraphBenchmark) {
+  auto target = common::DefaultHostTarget();
+  std::string output_name;
+  auto graph = BuildBranchyGraph(8, target, &output_name);
+  auto scope = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto program                       = gc.Build(options).runtime_program;
+  for (auto& name : scope->var_names()) {
+    SetRandData<float>(scope->GetTensor(std::string(name)), target, 0);
+  }
+
+  auto benchmark = [&](int num_threads, int repeat) {
+    FLAGS_cinn_parallel_execute_threads = num_threads;
+    program->Execute();
+    utils::Timer timer;
+    timer.Start();
+    for (int i = 0; i < repeat; ++i) {
+      program->Execute();
+    }
+    LOG(INFO) << "Execute with " << num_threads << " threads, average time: " << timer.Stop() / repeat << " ms";
+    return GetTensorData<float>(scope->GetTensor(output_name), target);
+  };
+
+  auto serial_results                 = benchmark(1, 20);
+  auto parallel_results               = benchmark(4, 20);
+  FLAGS_cinn_parallel_execute_threads = 1;
+
+  ASSERT_EQ(serial_results.size(), parallel_results.size());
+  for (int i = 0; i < serial_results.size(); ++i) {
+    ASSERT_EQ(serial_results[i], parallel_results[i]);
+  }
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
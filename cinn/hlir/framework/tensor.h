@@ -42,8 +42,9 @@ struct Shape {
   const std::vector<dim_t>& data() const CINN_RESULT_SHOULD_USE { return data_; }
   std::vector<dim_t>& data() CINN_RESULT_SHOULD_USE { return data_; }
   size_t size() const CINN_RESULT_SHOULD_USE { return data_.size(); }
-  uint32_t numel() const CINN_RESULT_SHOULD_USE {
-    return std::accumulate(data_.begin(), data_.end(), 1, [](dim_t a, dim_t b) { return a * b; });
+  //! The number of elements, it is 64-bit to hold the tensors larger than 4GB.
+  uint64_t numel() const CINN_RESULT_SHOULD_USE {
+    return std::accumulate(data_.begin(), data_.end(), uint64_t(1), [](uint64_t a, dim_t b) { return a * b; });
   }
 
  private:
@@ -112,7 +112,7 @@ std::shared_ptr<OpStrategy> StrategyForCustomCall(const framework::NodeAttr &att
   return strategy;
 }
 
-#ifdef CINN_WITH_CUDA
+// The args of gemm are shared by cinn_call_cublas on NVGPU and cinn_call_host_gemm on host
 std::vector<ir::Expr> CustomCallArgsForCublas(const framework::NodeAttr &attrs,
                                               const std::vector<ir::Tensor> &inputs,
                                               const std::vector<std::vector<int>> &output_shapes) {
@@ -216,6 +216,7 @@ std::vector<ir::Expr> CustomCallArgsForCublas(const framework::NodeAttr &attrs,
   return args;
 }
 
+#ifdef CINN_WITH_CUDA
 std::vector<ir::Expr> CustomCallArgsForBatchedCublas(const framework::NodeAttr &attrs,
                                                      const std::vector<ir::Tensor> &inputs,
                                                      const std::vector<std::vector<int>> &output_shapes) {
@@ -846,6 +847,55 @@ std::vector<ir::Expr> CustomCallArgsForMemcpy(const framework::NodeAttr &attrs,
   return {Expr(count)};
 }
 
+// Return the {outer, axis_size, inner} extents of the shape viewed around the axis
+std::vector<ir::Expr> SortSliceExtents(const std::vector<int> &shape, int *axis) {
+  if (*axis < 0) {
+    *axis += shape.size();
+  }
+  CHECK(*axis >= 0 && *axis < static_cast<int>(shape.size())) << "The axis of sort is out of range: " << *axis;
+  int outer = 1, inner = 1;
+  for (int i = 0; i < *axis; ++i) {
+    outer *= shape[i];
+  }
+  for (int i = *axis + 1; i < static_cast<int>(shape.size()); ++i) {
+    inner *= shape[i];
+  }
+  return {ir::Expr(outer), ir::Expr(shape[*axis]), ir::Expr(inner)};
+}
+
+std::vector<ir::Expr> CustomCallArgsForSort(const framework::NodeAttr &attrs,
+                                            const std::vector<ir::Tensor> &inputs,
+                                            const std::vector<std::vector<int>> &output_shapes) {
+  CHECK_EQ(inputs.size(), 1UL) << "The sort custom_call should only has one input";
+  const auto &attr_store = attrs.attr_store;
+  CHECK(attr_store.count("axis")) << "The sort custom_call must has attribute \"axis\"";
+  int axis       = absl::get<int>(attr_store.at("axis"));
+  bool is_ascend = attr_store.count("is_ascend") ? absl::get<bool>(attr_store.at("is_ascend")) : true;
+
+  auto args = SortSliceExtents(ToPodVector<int>(inputs[0]->shape), &axis);
+  args.push_back(ir::Expr(is_ascend));
+  return args;
+}
+
+std::vector<ir::Expr> CustomCallArgsForTopK(const framework::NodeAttr &attrs,
+                                            const std::vector<ir::Tensor> &inputs,
+                                            const std::vector<std::vector<int>> &output_shapes) {
+  CHECK_EQ(inputs.size(), 1UL) << "The top_k custom_call should only has one input";
+  CHECK_EQ(output_shapes.size(), 2UL) << "The top_k custom_call should has values and indices as outputs";
+  const auto &attr_store = attrs.attr_store;
+  CHECK(attr_store.count("k")) << "The top_k custom_call must has attribute \"k\"";
+  CHECK(attr_store.count("axis")) << "The top_k custom_call must has attribute \"axis\"";
+  int k        = absl::get<int>(attr_store.at("k"));
+  int axis     = absl::get<int>(attr_store.at("axis"));
+  bool largest = attr_store.count("largest") ? absl::get<bool>(attr_store.at("largest")) : true;
+
+  auto args = SortSliceExtents(ToPodVector<int>(inputs[0]->shape), &axis);
+  CHECK(k > 0 && k <= args[1].as_int32()) << "The k of top_k should be in range [1, " << args[1] << "]";
+  args.push_back(ir::Expr(k));
+  args.push_back(ir::Expr(largest));
+  return args;
+}
+
 bool RegisteryCustomCallArgsFunc() {
 #ifdef CINN_WITH_CUDA
   CustomCallArgsFuncRegistry::Global().Register(
@@ -896,6 +946,22 @@ bool RegisteryCustomCallArgsFunc() {
 
   CustomCallArgsFuncRegistry::Global().Register(
       "cinn_assert_true_host", common::DefaultHostTarget(), CustomCallArgsForAssertTrue);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_host_gemm", common::DefaultHostTarget(), CustomCallArgsForCublas);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_host_gaussian_random", common::DefaultHostTarget(), CustomCallArgsForGaussianRandom);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_host_uniform_random", common::DefaultHostTarget(), CustomCallArgsForUniformRandom);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_host_randint", common::DefaultHostTarget(), CustomCallArgsForRandInt);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_host_memset", common::DefaultHostTarget(), CustomCallArgsForMemset);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_host_memcpy", common::DefaultHostTarget(), CustomCallArgsForMemcpy);
+  CustomCallArgsFuncRegistry::Global().Register("cinn_host_sort", common::DefaultHostTarget(), CustomCallArgsForSort);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_host_argsort", common::DefaultHostTarget(), CustomCallArgsForSort);
+  CustomCallArgsFuncRegistry::Global().Register("cinn_host_top_k", common::DefaultHostTarget(), CustomCallArgsForTopK);
 
   return true;
 }
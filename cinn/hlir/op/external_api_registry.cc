@@ -14,6 +14,9 @@
 
 #include "cinn/hlir/op/external_api_registry.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace cinn {
 namespace hlir {
 namespace op {
@@ -36,19 +39,61 @@ std::string ExternalApiRegistry::GetExternalApi(const framework::Node* op_node,
   return external_api;
 }
 
+bool ExternalApiRegistry::CanTransform(const framework::Node* op_node,
+                                       const absl::flat_hash_map<std::string, common::Type>& dtype_dict,
+                                       const common::Target& target) {
+  const ExternalApiInfo* external_api_info = Find(GenKey(op_node->op()->name, target));
+  if (!external_api_info) {
+    return false;
+  }
+  return !external_api_info->trans_cond || external_api_info->trans_cond(op_node, dtype_dict);
+}
+
 std::string ExternalApiRegistry::GenKey(const std::string& op_name, const common::Target& target) {
   std::ostringstream oss;
   oss << target;
   return op_name + "_" + oss.str();
 }
 
+const std::vector<common::Type>& HostSortableTypes() {
+  static const std::vector<common::Type> types = {common::F32(), common::F64(), common::I32(), common::I64()};
+  return types;
+}
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
 
+namespace {
+using DTypeDict = absl::flat_hash_map<std::string, ::cinn::common::Type>;
+
+// The condition of the external api only supporting the given dtypes of the first input(or output) of the op node
+::cinn::hlir::op::OpNodeTransCondition DTypeIn(const std::vector<::cinn::common::Type>& dtypes, bool of_input) {
+  return [dtypes, of_input](const ::cinn::hlir::framework::Node* node, const DTypeDict& dtype_dict) {
+    auto links = of_input ? node->inlinks_in_order() : node->outlinks_in_order();
+    if (links.empty()) {
+      return false;
+    }
+    auto* var = (of_input ? links[0]->source() : links[0]->sink())->safe_as<::cinn::hlir::framework::NodeData>();
+    if (!var || !dtype_dict.count(var->id())) {
+      return false;
+    }
+    return std::find(dtypes.begin(), dtypes.end(), dtype_dict.at(var->id())) != dtypes.end();
+  };
+}
+}  // namespace
+
 CINN_REGISTER_HELPER(op_external_api) {
   const auto& default_nvgpu = ::cinn::common::DefaultNVGPUTarget();
   const auto& default_host  = ::cinn::common::DefaultHostTarget();
+  // the host kernels dispatch on a few dtypes, the op nodes of the others are compiled from their compute
+  using ::cinn::common::F32;
+  using ::cinn::common::F64;
+  using ::cinn::common::I32;
+  using ::cinn::common::I64;
+  const auto float_output   = DTypeIn({F32(), F64()}, false);
+  const auto int32_output   = DTypeIn({I32()}, false);
+  const auto sortable_input = DTypeIn(::cinn::hlir::op::HostSortableTypes(), true);
 
   CINN_OP_REGISTER_EXTERNAL_API(matmul, default_nvgpu).set_api_name("cinn_call_cublas");
   CINN_OP_REGISTER_EXTERNAL_API(mul, default_nvgpu).set_api_name("cinn_call_cublas");
@@ -62,6 +107,20 @@ CINN_REGISTER_HELPER(op_external_api) {
   CINN_OP_REGISTER_EXTERNAL_API(triangular_solve, default_nvgpu).set_api_name("cinn_call_triangular_solve_nvgpu");
   CINN_OP_REGISTER_EXTERNAL_API(assert_true, default_nvgpu).set_api_name("cinn_assert_true_nvgpu");
   CINN_OP_REGISTER_EXTERNAL_API(assert_true, default_host).set_api_name("cinn_assert_true_host");
+  CINN_OP_REGISTER_EXTERNAL_API(matmul, default_host).set_api_name("cinn_call_host_gemm").set_trans_cond(float_output);
+  CINN_OP_REGISTER_EXTERNAL_API(mul, default_host).set_api_name("cinn_call_host_gemm").set_trans_cond(float_output);
+  CINN_OP_REGISTER_EXTERNAL_API(gaussian_random, default_host)
+      .set_api_name("cinn_call_host_gaussian_random")
+      .set_trans_cond(float_output);
+  CINN_OP_REGISTER_EXTERNAL_API(uniform_random, default_host)
+      .set_api_name("cinn_call_host_uniform_random")
+      .set_trans_cond(float_output);
+  CINN_OP_REGISTER_EXTERNAL_API(randint, default_host)
+      .set_api_name("cinn_call_host_randint")
+      .set_trans_cond(int32_output);
+  CINN_OP_REGISTER_EXTERNAL_API(sort, default_host).set_api_name("cinn_host_sort").set_trans_cond(sortable_input);
+  CINN_OP_REGISTER_EXTERNAL_API(argsort, default_host).set_api_name("cinn_host_argsort").set_trans_cond(sortable_input);
+  CINN_OP_REGISTER_EXTERNAL_API(top_k, default_host).set_api_name("cinn_host_top_k").set_trans_cond(sortable_input);
 #ifdef CINN_WITH_CUDNN
   CINN_OP_REGISTER_EXTERNAL_API(conv2d, default_nvgpu).set_trans_func([](const ::cinn::hlir::framework::Node* node) {
     CHECK(node->attrs.attr_store.count("conv_type"));
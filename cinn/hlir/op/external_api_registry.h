@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #pragma once
+#include <absl/container/flat_hash_map.h>
+
 #include <sstream>
+#include <vector>
 
 #include "cinn/common/target.h"
 #include "cinn/hlir/framework/node.h"
@@ -28,14 +31,19 @@ namespace hlir {
 namespace op {
 
 using OpNodeTransToExternalApiFunction = std::function<std::string(const framework::Node* op_node)>;
+using OpNodeTransCondition = std::function<bool(const framework::Node* op_node,
+                                                const absl::flat_hash_map<std::string, common::Type>& dtype_dict)>;
 
 // This class contains detail external api information of a specified Operator.
 // To provide the external api name, we can directly set it through `set_api_name`
-// or set a transform function wth `set_trans_func` that return a api name finally
+// or set a transform function wth `set_trans_func` that return a api name finally.
+// If the external api only supports some cases of the op, such as some dtypes, set
+// a condition with `set_trans_cond` and the other cases are kept on the compute path
 struct ExternalApiInfo {
   std::string name;
   std::string api_name;
   OpNodeTransToExternalApiFunction trans_func;
+  OpNodeTransCondition trans_cond;
 
   inline ExternalApiInfo& set_api_name(const std::string& name) {
     this->api_name = name;
@@ -46,6 +54,11 @@ struct ExternalApiInfo {
     this->trans_func = func;
     return *this;
   }
+
+  inline ExternalApiInfo& set_trans_cond(OpNodeTransCondition cond) {
+    this->trans_cond = cond;
+    return *this;
+  }
 };
 
 // A registry that stores external api for ops supported by vendor library
@@ -62,6 +75,12 @@ class ExternalApiRegistry : public Registry<ExternalApiInfo> {
     return nullptr != Registry<ExternalApiInfo>::Find(GenKey(op_name, target));
   }
 
+  // whether the op node can be replaced by its external api on the specified target,
+  // dtype_dict holds the dtypes of the variables of the graph
+  bool CanTransform(const framework::Node* op_node,
+                    const absl::flat_hash_map<std::string, common::Type>& dtype_dict,
+                    const common::Target& target);
+
   // return the api name on the specified target
   std::string GetExternalApi(const framework::Node* op_node, const common::Target& target);
 
@@ -73,6 +92,10 @@ class ExternalApiRegistry : public Registry<ExternalApiInfo> {
   std::string GenKey(const std::string& op_name, const common::Target& target);
 };
 
+// The dtypes of the input the host kernels of sort, argsort and top_k dispatch on, the op nodes of the other dtypes
+// are compiled from their compute
+const std::vector<common::Type>& HostSortableTypes();
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
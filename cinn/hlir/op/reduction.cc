@@ -276,6 +276,12 @@ std::shared_ptr<OpStrategy> StrategyForReduce(const framework::NodeAttr &attrs,
           }
         }
       } else {
+        if (target.arch == Target::Arch::X86 && !WithoutLastDimInReduce(inputs[0]->shape, reduce_axes)) {
+          CHECK(!vec_tensor.empty());
+          Expr reduce_out = vec_tensor[0];
+          VLOG(3) << "Do IRScheduleReduceCPU Schedule!";
+          pe::IRScheduleReduceCPU(ir_sch, reduce_out.as_tensor_ref(), target);
+        }
         std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
         *ret = CINNValuePack{res};
       }
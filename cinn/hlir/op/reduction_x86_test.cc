@@ -0,0 +1,125 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/runtime/flags.h"
+#include "cinn/utils/string.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+using ReduceRef = std::function<float(float, float)>;
+
+// Lower op_name reducing the last axis of a [M, N] tensor on host through the IR schedule of the op, which vectorizes
+// the reduction by IRScheduleReduceCPU, run it and compare the result with a scalar reduction from init by reducer
+void TestReduceLastAxisOnHost(const std::string& op_name, float init, const ReduceRef& reducer, float low, float up) {
+  FLAGS_cinn_ir_schedule = true;
+  // N is not a multiple of any vector factor, so the reduction has a scalar tail
+  int M = 5, N = 37;
+  Placeholder<float> A("A", {Expr(M), Expr(N)});
+
+  auto op       = Operator::Get(op_name);
+  auto strategy = Operator::GetAttrs<StrategyFunction>("CINNStrategy");
+  NodeAttr attrs;
+  attrs.attr_store["dim"]      = std::vector<int>{1};
+  attrs.attr_store["keep_dim"] = false;
+  std::vector<ir::Tensor> inputs{A.tensor()};
+  common::Target target = common::DefaultHostTarget();
+  auto impl             = OpStrategy::SelectImpl(strategy[op](attrs, inputs, {Float(32)}, {{M}}, target));
+
+  std::string func_name = op_name + "_x86";
+  std::string out_name  = "B";
+  common::CINNValuePack cinn_input = common::CINNValuePack{{common::CINNValue(A), common::CINNValue(out_name)}};
+  std::vector<std::string> input_output_names{"A", out_name};
+  auto funcs = GetFuncFromImpl(impl, cinn_input, inputs, input_output_names, func_name, target);
+
+  Module::Builder builder("module_" + func_name, target);
+  for (auto& func : funcs) {
+    VLOG(3) << "The lowered func of " << op_name << " is:\n" << func;
+    builder.AddFunction(func);
+  }
+  ASSERT_EQ(funcs.size(), 1UL);
+  // the reduction is accumulated in a vector and the tail is left scalar
+  ASSERT_NE(utils::GetStreamCnt(funcs[0]).find("_vacc"), std::string::npos);
+
+  auto jit    = backends::ExecutionEngine::Create({});
+  auto module = builder.Build();
+  jit->Link(module);
+  auto fn = jit->Lookup("fn_" + func_name);
+  CHECK(fn);
+  auto fn_ = reinterpret_cast<void (*)(void*, int32_t)>(fn);
+
+  auto* A_buf = common::BufferBuilder(Float(32), {M, N}).set_align(512).set_random().Build();
+  auto* B_buf = common::BufferBuilder(Float(32), {M}).set_align(512).set_zero().Build();
+  auto* ad    = reinterpret_cast<float*>(A_buf->memory);
+  auto* bd    = reinterpret_cast<float*>(B_buf->memory);
+  // the random values are in [0, 1], scale them into [low, up]
+  for (int i = 0; i < M * N; ++i) {
+    ad[i] = low + (up - low) * ad[i];
+  }
+  cinn_pod_value_t a_arg(A_buf), b_arg(B_buf);
+  cinn_pod_value_t args[] = {a_arg, b_arg};
+  fn_(args, 2);
+
+  for (int i = 0; i < M; ++i) {
+    float expected = init;
+    for (int j = 0; j < N; ++j) {
+      expected = reducer(expected, ad[i * N + j]);
+    }
+    // the vector accumulation changes the order of additions and multiplications
+    ASSERT_NEAR(bd[i], expected, 1e-4 * std::max(1.f, std::abs(expected))) << op_name << " at row " << i;
+  }
+}
+
+TEST(Operator, Operator_Reduction_X86_ReduceSum) {
+  TestReduceLastAxisOnHost("reduce_sum", 0.f, [](float a, float b) { return a + b; }, -1.f, 1.f);
+}
+
+TEST(Operator, Operator_Reduction_X86_ReduceMax) {
+  float init = std::numeric_limits<float>::lowest();
+  TestReduceLastAxisOnHost("reduce_max", init, [](float a, float b) { return std::max(a, b); }, -1.f, 1.f);
+}
+
+TEST(Operator, Operator_Reduction_X86_ReduceMin) {
+  float init = std::numeric_limits<float>::max();
+  TestReduceLastAxisOnHost("reduce_min", init, [](float a, float b) { return std::min(a, b); }, -1.f, 1.f);
+}
+
+TEST(Operator, Operator_Reduction_X86_ReduceProd) {
+  // the values stay close to 1 so the product of 37 of them neither overflows nor vanishes
+  TestReduceLastAxisOnHost("reduce_prod", 1.f, [](float a, float b) { return a * b; }, 0.9f, 1.1f);
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -37,13 +37,17 @@ class GraphAlterHelper {
     }
   }
   void TransToCustomCall(const common::Target& target) {
+    using DTypeDict = absl::flat_hash_map<std::string, common::Type>;
+    DTypeDict empty_dtype_dict;
+    const auto& dtype_dict =
+        graph_->HasAttr("inferdtype") ? graph_->GetAttrs<DTypeDict>("inferdtype") : empty_dtype_dict;
     // collect candidate nodes
-    auto mark_nodes = graph_->CollectNodes([this, &target](const common::GraphNode* graph_node) -> bool {
+    auto mark_nodes = graph_->CollectNodes([this, &target, &dtype_dict](const common::GraphNode* graph_node) -> bool {
       if (graph_node->safe_as<Node>()) {
         auto node      = graph_node->safe_as<Node>();
         auto&& op_name = node->op()->name;
-        // a op with external_api registered and not excluded explicitly will be selected
-        if (!IsExcluded(op_name) && ExternalApiRegistry::Global()->Has(op_name, target)) {
+        // a op with external_api registered, supporting the node and not excluded explicitly will be selected
+        if (!IsExcluded(op_name) && ExternalApiRegistry::Global()->CanTransform(node, dtype_dict, target)) {
           VLOG(4) << "Op:" << op_name << " will use custom_call";
           return true;
         }
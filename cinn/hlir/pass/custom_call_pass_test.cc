@@ -0,0 +1,96 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "cinn/frontend/decomposer/test_helper.h"
+
+namespace cinn {
+namespace frontend {
+
+using hlir::framework::Node;
+
+// the name of the op producing the variable named var_id
+std::string ProducerOpName(hlir::framework::Graph* graph, const std::string& var_id) {
+  for (auto* graph_node : graph->CollectNodes([](const common::GraphNode* n) { return n->safe_as<Node>(); })) {
+    auto* node = graph_node->safe_as<Node>();
+    for (auto& link : node->outlinks_in_order()) {
+      if (link->sink()->safe_as<hlir::framework::NodeData>()->id() == var_id) {
+        return node->op()->name;
+      }
+    }
+  }
+  return "";
+}
+
+TEST(TransToCustomCallPass, host_dtype) {
+  NetBuilder builder("host_dtype");
+  auto x_fp32   = builder.CreateInput(Float(32), {16, 32}, "x_fp32");
+  auto y_fp32   = builder.CreateInput(Float(32), {32, 24}, "y_fp32");
+  auto x_int32  = builder.CreateInput(Int(32), {16, 32}, "x_int32");
+  auto y_int32  = builder.CreateInput(Int(32), {32, 24}, "y_int32");
+  auto out_fp32 = builder.Matmul(x_fp32, y_fp32);
+  auto out_int  = builder.Matmul(x_int32, y_int32);
+  auto program  = builder.Build();
+
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<hlir::framework::Graph>(
+      program, std::unordered_set<std::string>{out_fp32->id, out_int->id}, target);
+  hlir::framework::ApplyPass(graph.get(), "TransToCustomCallPass");
+  // cinn_call_host_gemm only supports float32 and float64
+  ASSERT_EQ(ProducerOpName(graph.get(), out_fp32->id), "custom_call");
+  ASSERT_EQ(ProducerOpName(graph.get(), out_int->id), "matmul");
+}
+
+TEST(TransToCustomCallPass, host_int32_matmul) {
+  int M = 16, N = 24, K = 32;
+  NetBuilder builder("host_int32_matmul");
+  auto x       = builder.CreateInput(Int(32), {M, K}, "x");
+  auto y       = builder.CreateInput(Int(32), {K, N}, "y");
+  auto out     = builder.Matmul(x, y);
+  auto program = builder.Build();
+
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<hlir::framework::Graph>(program, std::unordered_set<std::string>{out->id}, target);
+  hlir::framework::ApplyPasses(graph.get(), {"TransToCustomCallPass", "OpFusionPass", "FusionMergePass"});
+
+  auto scope = BuildScope(target, graph);
+  hlir::framework::GraphCompiler gc(target, scope, graph);
+  auto run_program = gc.Build();
+
+  std::vector<int> x_data(M * K), y_data(K * N);
+  for (int i = 0; i < x_data.size(); ++i) {
+    x_data[i] = i % 7 - 3;
+  }
+  for (int i = 0; i < y_data.size(); ++i) {
+    y_data[i] = i % 5 - 2;
+  }
+  std::copy(x_data.begin(), x_data.end(), scope->GetTensor(std::string(x.id()))->mutable_data<int>(target));
+  std::copy(y_data.begin(), y_data.end(), scope->GetTensor(std::string(y.id()))->mutable_data<int>(target));
+  run_program->Execute();
+
+  const int* out_data = scope->GetTensor(out->id)->data<int>();
+  for (int m = 0; m < M; ++m) {
+    for (int n = 0; n < N; ++n) {
+      int expected = 0;
+      for (int k = 0; k < K; ++k) {
+        expected += x_data[m * K + k] * y_data[k * N + n];
+      }
+      ASSERT_EQ(out_data[m * N + n], expected) << "at (" << m << ", " << n << ")";
+    }
+  }
+}
+
+}  // namespace frontend
+}  // namespace cinn
@@ -132,11 +132,12 @@ bool SingleGroupOptimizePass::TryReplaceNodeToCustomCall(Node* node) const {
     node->attrs.op                        = framework::Operator::Get("custom_call");
   }
 
+  bool is_host = graph_->target_ == common::DefaultHostTarget();
   if (can_replace_to_memset) {
-    node->attrs.attr_store["custom_call"] = std::string("cinn_call_cuda_memset");
+    node->attrs.attr_store["custom_call"] = std::string(is_host ? "cinn_call_host_memset" : "cinn_call_cuda_memset");
   }
   if (can_replace_to_memcpy) {
-    node->attrs.attr_store["custom_call"] = std::string("cinn_call_cuda_memcpy");
+    node->attrs.attr_store["custom_call"] = std::string(is_host ? "cinn_call_host_memcpy" : "cinn_call_cuda_memcpy");
   }
 
   return can_replace;
@@ -171,7 +172,7 @@ bool SingleGroupOptimizePass::CanReplaceToMemcpy(Node* node) const {
 }
 
 void SingleGroupOptimizePassImpl(Graph* graph) {
-  if (graph->target_ != common::DefaultNVGPUTarget()) {
+  if (graph->target_ != common::DefaultNVGPUTarget() && graph->target_ != common::DefaultHostTarget()) {
     return;
   }
   graph->fusion_groups = SingleGroupOptimizePass(graph).Apply();
@@ -303,6 +303,20 @@ void IRCudaSplitSchedule(ir::IRSchedule &ir_sch,
   VLOG(3) << "In IRCudaSplitSchedule, After schedule expr is : " << ir_sch.GetModule().GetExprs().at(0);
 }
 
+void IRScheduleReduceCPU(ir::IRSchedule &ir_sch, ir::Tensor out, const common::Target &target) {
+  VLOG(3) << "Before IRScheduleReduceCPU : " << ir_sch.GetModule().GetExprs().at(0);
+  auto loops = ir_sch.GetLoops(out->name);
+  if (loops.empty()) {
+    return;
+  }
+  // the partial results of the lanes are kept by VectorizeLoops
+  int factor = GetBasicFactor(out->type(), target);
+  if (ir::GetLoopExtent(loops.back()) >= factor) {
+    ir_sch.Vectorize(loops.back(), factor);
+  }
+  VLOG(3) << "After IRScheduleReduceCPU : " << ir_sch.GetModule().GetExprs().at(0);
+}
+
 void IRCudaScheduleReduce(ir::IRSchedule &ir_sch,
                           ir::Tensor output,
                           int last_dimension_num,
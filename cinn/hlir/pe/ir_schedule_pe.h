@@ -57,6 +57,9 @@ void IRCudaSplitSchedule(ir::IRSchedule &ir_sch,
                          int axis,
                          const common::Target &target);
 
+// Vectorize the innermost reduce loop of out on the host, which reduces the last dimension of the input.
+void IRScheduleReduceCPU(ir::IRSchedule &ir_sch, ir::Tensor out, const common::Target &target);
+
 void IRCudaScheduleReduce(ir::IRSchedule &ir_sch, ir::Tensor out, int last_dimension_num, const common::Target &target);
 
 void IRCudaScheduleBlockReduce(ir::IRSchedule &ir_sch,
@@ -32,6 +32,7 @@
 #include "cinn/utils/string.h"
 
 DECLARE_bool(cinn_use_cuda_vectorize);
+DECLARE_string(cinn_x86_conv_params_file);
 namespace cinn {
 namespace hlir {
 namespace pe {
@@ -40,6 +41,15 @@ ScheduleParam::ScheduleParam(common::Target::Arch arch) {
   switch (arch) {
     case common::Target::Arch::X86: {
       param_data = CreateX86Params();
+      // the tuned params take precedence over the built-in ones of the same conv shapes
+      if (!FLAGS_cinn_x86_conv_params_file.empty()) {
+        if (std::ifstream(FLAGS_cinn_x86_conv_params_file).good()) {
+          LoadSerialData(&param_data, FLAGS_cinn_x86_conv_params_file);
+        } else {
+          LOG(WARNING) << "Can not open the x86 conv params file " << FLAGS_cinn_x86_conv_params_file
+                       << ", only the built-in params are used";
+        }
+      }
       break;
     }
     case common::Target::Arch::NVGPU: {
@@ -85,7 +95,7 @@ int SplitEven(int origin) {
 }
 
 int GetBasicFactor(const Type &type, const common::Target &target) {
-  int target_native_vector_bits = target.get_target_bits() * 8;
+  int target_native_vector_bits = target.get_native_vector_bits();
   int type_bits                 = type.bits();
   return target_native_vector_bits / type_bits;
 }
@@ -148,7 +158,7 @@ void ScheduleInjectiveCPU1(poly::Stage *stage,
     CHECK_EQ(stage->n_out_dims(), output_shape.size())
         << "The origin stage out dims should be same with output_shape sizes";
     poly::Iterator fused          = stage->axis(dims - 1);
-    int target_native_vector_bits = target.get_target_bits() * 8;
+    int target_native_vector_bits = target.get_native_vector_bits();
     int type_bits                 = stage->tensor()->type().bits();
     int prod_size                 = output_shape.back();
     // fuse conservatively for the complex index from poly and may not benefit a lot compared with llvm optimization,
@@ -609,6 +619,14 @@ void GetConv2dFactors(absl::flat_hash_map<std::string, int> *factors,
                       bool import_params) {
   if (import_params) {
     auto &params = ScheduleParam::get_x86_instance().GetParam();
+    if (!params.count(key)) {
+      // fall back to the params of the same conv shape without the model name and index in front
+      auto pos = key.find("X86ScheduleConv");
+      if (pos != std::string::npos && pos > 0 && params.count(key.substr(pos))) {
+        VLOG(3) << "Can not find saved param of the model, use the one of the same shape, key is: " << key;
+        return GetConv2dFactors(factors, oc, ic, fc, oh, ow, type, target, key.substr(pos), import_params);
+      }
+    }
     if (params.count(key)) {
       VLOG(3) << "find saved param, key is: " << key;
       CHECK(!params[key]["oc_bn"].empty());
@@ -0,0 +1,60 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A tool to tune the x86 conv schedule params on the local CPU, usage:
+//   tune_x86_conv_params --conv_keys_file=convs.txt --output_file=x86_conv_params.log
+// Each line of conv_keys_file is a conv shape in the key format of X86ScheduleConv, such as
+//   X86ScheduleConv input 1 64 56 56 weight 64 64 3 3 stride 1 1 padding 1 1 dilation 1 1
+// and the output file is loaded by setting FLAGS_cinn_x86_conv_params_file to it.
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cinn/hlir/pe/schedule.h"
+#include "cinn/hlir/pe/x86_conv_tuner.h"
+
+DEFINE_string(conv_keys_file, "", "The file listing the keys of the conv shapes to tune, one per line.");
+DEFINE_string(output_file, "x86_conv_params.log", "The file to save the tuned params.");
+DEFINE_int32(repeat, 10, "The number of times to run a kernel for its average cost.");
+DEFINE_int32(num_rounds, 2, "The number of passes over all the factors.");
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  CHECK(!FLAGS_conv_keys_file.empty()) << "--conv_keys_file is required";
+
+  std::ifstream is(FLAGS_conv_keys_file);
+  CHECK(is.is_open()) << "Failed to open " << FLAGS_conv_keys_file;
+  std::vector<cinn::hlir::pe::X86ConvShape> shapes;
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.find_first_not_of(" \t") != std::string::npos) {
+      shapes.push_back(cinn::hlir::pe::X86ConvShape::FromKey(line));
+    }
+  }
+
+  cinn::hlir::pe::X86ConvTuner::Config config;
+  config.repeat     = FLAGS_repeat;
+  config.num_rounds = FLAGS_num_rounds;
+  cinn::hlir::pe::X86ConvTuner tuner(cinn::common::DefaultHostTarget(), config);
+  absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, std::vector<int>>> model_data;
+  tuner.Tune(shapes, &model_data);
+  cinn::hlir::pe::SaveSerialData(model_data, FLAGS_output_file);
+  LOG(INFO) << "Save the params of " << model_data.size() << " conv shapes into " << FLAGS_output_file;
+  return 0;
+}
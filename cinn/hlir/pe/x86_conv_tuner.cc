@@ -0,0 +1,286 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/pe/x86_conv_tuner.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/cinn.h"
+#include "cinn/hlir/pe/nn.h"
+#include "cinn/hlir/pe/schedule.h"
+#include "cinn/runtime/cinn_runtime.h"
+#include "cinn/utils/timer.h"
+
+namespace cinn {
+namespace hlir {
+namespace pe {
+
+namespace {
+// The prefix of the key to register the params being measured into ScheduleParam
+constexpr char kTuningKeyPrefix[] = "X86ConvTuner ";
+
+std::vector<Expr> ToExprs(const std::vector<int> &shape) {
+  std::vector<Expr> exprs;
+  for (int dim : shape) {
+    exprs.emplace_back(dim);
+  }
+  return exprs;
+}
+
+// Set the inner block size of a factor, and the number of blocks in front as the built-in params do
+void SetBlockFactor(absl::flat_hash_map<std::string, std::vector<int>> *params,
+                    const std::string &factor,
+                    int extent,
+                    int block) {
+  (*params)[factor] = {extent / block, block};
+}
+
+// Allocate a float32 buffer of the shape on host filled with the value
+cinn_buffer_t *NewHostBuffer(const std::vector<int> &shape, float value) {
+  auto *buf = cinn_buffer_t::new_(cinn_x86_device, cinn_float32_t(), shape, 32);
+  cinn_buffer_malloc(nullptr, buf);
+  std::fill_n(reinterpret_cast<float *>(buf->memory), buf->num_elements(), value);
+  return buf;
+}
+}  // namespace
+
+std::string X86ConvShape::Key() const {
+  return GenerateX86ConvKey(input_shape, weight_shape, strides, paddings, dilations);
+}
+
+X86ConvShape X86ConvShape::FromKey(const std::string &key) {
+  auto pos = key.find("X86ScheduleConv");
+  CHECK(pos != std::string::npos) << "Invalid key of X86ScheduleConv: " << key;
+  std::istringstream is(key.substr(pos));
+  X86ConvShape shape;
+  auto read_values = [&](const std::string &name, int num_values, std::vector<int> *values) {
+    std::string token;
+    is >> token;
+    CHECK_EQ(token, name) << "Invalid key of X86ScheduleConv: " << key;
+    values->resize(num_values);
+    for (auto &value : *values) {
+      is >> value;
+    }
+  };
+  std::string schedule_name;
+  is >> schedule_name;
+  read_values("input", 4, &shape.input_shape);
+  read_values("weight", 4, &shape.weight_shape);
+  read_values("stride", 2, &shape.strides);
+  read_values("padding", 2, &shape.paddings);
+  read_values("dilation", 2, &shape.dilations);
+  CHECK(!is.fail()) << "Invalid key of X86ScheduleConv: " << key;
+  return shape;
+}
+
+std::vector<int> X86ConvShape::OutputShape() const {
+  int h_out = (input_shape[2] + 2 * paddings[0] - dilations[0] * (weight_shape[2] - 1) - 1) / strides[0] + 1;
+  int w_out = (input_shape[3] + 2 * paddings[1] - dilations[1] * (weight_shape[3] - 1) - 1) / strides[1] + 1;
+  return {input_shape[0], weight_shape[0], h_out, w_out};
+}
+
+X86ConvTuner::X86ConvTuner(const common::Target &target, const Config &config) : target_(target), config_(config) {
+  CHECK(target_.arch == common::Target::Arch::X86) << "X86ConvTuner only tunes on x86";
+  CHECK_GT(config_.repeat, 0) << "repeat should be greater than 0";
+  CHECK_GT(config_.num_rounds, 0) << "num_rounds should be greater than 0";
+}
+
+std::vector<int> X86ConvTuner::CandidateFactors(int extent, int max_factor) {
+  std::vector<int> factors;
+  for (int i = 1; i <= std::min(extent, max_factor); ++i) {
+    if (extent % i == 0) {
+      factors.push_back(i);
+    }
+  }
+  return factors;
+}
+
+absl::flat_hash_map<std::string, std::vector<int>> X86ConvTuner::InitialParams(const X86ConvShape &shape) const {
+  absl::flat_hash_map<std::string, std::vector<int>> params;
+  auto &param_data = ScheduleParam::get_x86_instance().GetParam();
+  auto it          = param_data.find(shape.Key());
+  if (it != param_data.end()) {
+    params = it->second;
+  } else {
+    int oc            = shape.weight_shape[0];
+    int ic            = shape.input_shape[1];
+    auto output_shape = shape.OutputShape();
+    absl::flat_hash_map<std::string, int> factors;
+    GetConv2dFactors(
+        &factors, oc, ic, ic, shape.Is1x1() ? output_shape[2] : -1, output_shape[3], Float(32), target_, "", false);
+    SetBlockFactor(&params, "ic_bn", ic, factors["ic_bn"]);
+    SetBlockFactor(&params, "oc_bn", oc, factors["oc_bn"]);
+    SetBlockFactor(&params, "ow_bn", output_shape[3], factors["ow_bn"]);
+    if (factors.count("oh_bn")) {
+      params["oh_bn"] = {factors["oh_bn"]};
+    }
+  }
+  // the factor used by the schedule but missing in the params defaults to 1 or not to unroll
+  if (shape.Is1x1() && !params.count("oh_bn")) {
+    params["oh_bn"] = {1};
+  } else if (!shape.Is1x1() && !params.count("unroll_kw")) {
+    params["unroll_kw"] = {0};
+  }
+  return params;
+}
+
+std::vector<int> X86ConvTuner::Candidates(const X86ConvShape &shape,
+                                          const absl::flat_hash_map<std::string, std::vector<int>> &params,
+                                          const std::string &factor) const {
+  auto output_shape = shape.OutputShape();
+  int oh            = output_shape[2];
+  int ow            = output_shape[3];
+  if (factor == "ic_bn") {
+    return CandidateFactors(shape.input_shape[1], config_.max_channel_bn);
+  } else if (factor == "oc_bn") {
+    return CandidateFactors(shape.weight_shape[0], config_.max_channel_bn);
+  } else if (factor == "ow_bn") {
+    int max_ow_bn = config_.max_ow_bn;
+    if (shape.Is1x1()) {
+      max_ow_bn = std::min(max_ow_bn, config_.max_oh_ow_bn / params.at("oh_bn").back());
+    }
+    return CandidateFactors(ow, max_ow_bn);
+  } else if (factor == "oh_bn") {
+    return CandidateFactors(oh, config_.max_oh_ow_bn / params.at("ow_bn").back());
+  } else if (factor == "unroll_kw") {
+    return {0, 1};
+  }
+  LOG(FATAL) << "Unknown factor of X86ScheduleConv: " << factor;
+  return {};
+}
+
+absl::flat_hash_map<std::string, std::vector<int>> X86ConvTuner::Tune(const X86ConvShape &shape) {
+  CHECK_EQ(shape.input_shape[1], shape.weight_shape[1]) << "X86ConvTuner doesn't tune group conv";
+  auto output_shape = shape.OutputShape();
+  const std::vector<std::pair<std::string, int>> extents = {
+      {"ic_bn", shape.input_shape[1]},
+      {"oc_bn", shape.weight_shape[0]},
+      {"ow_bn", output_shape[3]},
+      {shape.Is1x1() ? "oh_bn" : "unroll_kw", -1}};
+
+  auto best_params = InitialParams(shape);
+  double best_cost = Measure(shape, best_params);
+  VLOG(3) << "Initial cost of " << shape.Key() << ": " << best_cost << " ms";
+  for (int round = 0; round < config_.num_rounds; ++round) {
+    bool improved = false;
+    for (const auto &factor_extent : extents) {
+      const std::string &factor = factor_extent.first;
+      for (int candidate : Candidates(shape, best_params, factor)) {
+        if (candidate == best_params.at(factor).back()) {
+          continue;
+        }
+        auto params = best_params;
+        if (factor_extent.second > 0) {
+          SetBlockFactor(&params, factor, factor_extent.second, candidate);
+        } else {
+          params[factor] = {candidate};
+        }
+        double cost = Measure(shape, params);
+        VLOG(4) << factor << "=" << candidate << ", cost: " << cost << " ms";
+        if (cost < best_cost) {
+          best_cost   = cost;
+          best_params = std::move(params);
+          improved    = true;
+        }
+      }
+    }
+    if (!improved) {
+      break;
+    }
+  }
+  VLOG(3) << "Best cost of " << shape.Key() << ": " << best_cost << " ms";
+  return best_params;
+}
+
+void X86ConvTuner::Tune(
+    const std::vector<X86ConvShape> &shapes,
+    absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, std::vector<int>>> *model_data) {
+  CHECK(model_data);
+  for (const auto &shape : shapes) {
+    (*model_data)[shape.Key()] = Tune(shape);
+  }
+}
+
+double X86ConvTuner::Measure(const X86ConvShape &shape,
+                             const absl::flat_hash_map<std::string, std::vector<int>> &params) {
+  // the params are looked up by the key in ScheduleParam while creating and scheduling the conv
+  auto &param_data = ScheduleParam::get_x86_instance().GetParam();
+  std::string key  = kTuningKeyPrefix + shape.Key();
+  param_data[key]  = params;
+
+  Placeholder<float> input(UniqName("input"), ToExprs(shape.input_shape));
+  Placeholder<float> weights(UniqName("weights"), ToExprs(shape.weight_shape));
+  auto outs = Conv2d_NCHW_5D(input.tensor(),
+                             weights.tensor(),
+                             shape.paddings[0],
+                             shape.paddings[1],
+                             shape.strides[0],
+                             shape.strides[1],
+                             shape.dilations[0],
+                             shape.dilations[1],
+                             key,
+                             UniqName("conv2d_out"),
+                             target_);
+  CHECK_EQ(outs.size(), 5U) << "Conv2d_NCHW_5D should return 5 tensors";
+  auto stages = CreateStages({input, weights});
+  for (auto &t : outs) {
+    stages->InsertLazily(t);
+  }
+  bool do_padding = shape.paddings[0] != 0 || shape.paddings[1] != 0;
+  // outs are {res, packed_out, weights_dilation, input_pad, data}
+  if (shape.Is1x1()) {
+    Conv2d_NCHWc_1X1_Schedule_CPU(stages, outs[0], outs[1], outs[3], outs[2], outs[4], target_, key, do_padding);
+  } else {
+    Conv2d_NCHWc_Schedule_CPU(stages, outs[0], outs[1], outs[3], outs[2], outs[4], target_, key, do_padding);
+  }
+  param_data.erase(key);
+
+  std::string fn_name = UniqName("x86_conv_tuner_fn");
+  Module::Builder builder("x86_conv_tuner", target_);
+  auto func = Lower(fn_name, stages, {input, weights, outs[0]}, {}, {}, &builder);
+  builder.AddFunction(func);
+  auto engine = backends::ExecutionEngine::Create({});
+  engine->Link(builder.Build());
+  auto fn = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup(fn_name));
+  CHECK(fn) << "Failed to compile the conv kernel of " << shape.Key();
+
+  // the cost doesn't depend on the values, which are only kept away from zeros and denormals
+  auto *input_buf   = NewHostBuffer(shape.input_shape, 0.5f);
+  auto *weights_buf = NewHostBuffer(shape.weight_shape, 0.5f);
+  auto *output_buf  = NewHostBuffer(shape.OutputShape(), 0.f);
+  cinn_pod_value_t args[] = {cinn_pod_value_t(input_buf), cinn_pod_value_t(weights_buf), cinn_pod_value_t(output_buf)};
+  // ignore the first run for the lazy initialization
+  fn(args, 3);
+  utils::Timer timer;
+  timer.Start();
+  for (int i = 0; i < config_.repeat; ++i) {
+    fn(args, 3);
+  }
+  double cost = timer.Stop() / config_.repeat;
+
+  for (auto *buf : {input_buf, weights_buf, output_buf}) {
+    cinn_buffer_free(nullptr, buf);
+    cinn_buffer_t::delete_(buf);
+  }
+  return cost;
+}
+
+}  // namespace pe
+}  // namespace hlir
+}  // namespace cinn
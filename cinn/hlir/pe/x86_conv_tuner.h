@@ -0,0 +1,98 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <string>
+#include <vector>
+
+#include "cinn/common/target.h"
+
+namespace cinn {
+namespace hlir {
+namespace pe {
+
+// The shape of a NCHW conv2d without groups, identified by the key of X86ScheduleConv
+struct X86ConvShape {
+  std::vector<int> input_shape;   // N, C, H, W
+  std::vector<int> weight_shape;  // C_out, C_in, filter_h, filter_w
+  std::vector<int> strides{1, 1};
+  std::vector<int> paddings{0, 0};
+  std::vector<int> dilations{1, 1};
+
+  std::string Key() const;
+
+  // Parse the shape from a key generated by GenerateX86ConvKey, the model name and index in front are ignored
+  static X86ConvShape FromKey(const std::string &key);
+
+  std::vector<int> OutputShape() const;
+
+  bool Is1x1() const { return weight_shape[2] == 1 && weight_shape[3] == 1; }
+};
+
+/**
+ * Tune the blocking factors used by Conv2d_NCHWc_Schedule_CPU and Conv2d_NCHWc_1X1_Schedule_CPU, that are
+ * ic_bn, oc_bn, ow_bn and unroll_kw (oh_bn for 1x1 conv), by measuring the compiled kernels on the local CPU.
+ *
+ * Starting from the params in ScheduleParam or the ones computed by GetConv2dFactors, each factor is replaced
+ * in turn by its best candidate with the others fixed, and the tuned params can be saved by SaveSerialData
+ * into a file loaded by FLAGS_cinn_x86_conv_params_file.
+ */
+class X86ConvTuner {
+ public:
+  struct Config {
+    // the number of times to run a kernel for its average cost
+    int repeat = 10;
+    // the number of passes over all the factors
+    int num_rounds = 2;
+    // the upper bounds of the candidate factors
+    int max_channel_bn = 64;
+    int max_ow_bn      = 16;
+    // the upper bound of oh_bn * ow_bn for 1x1 conv
+    int max_oh_ow_bn = 32;
+  };
+
+  X86ConvTuner(const common::Target &target, const Config &config);
+
+  // Return the best params of a conv shape in the format of ScheduleParam
+  absl::flat_hash_map<std::string, std::vector<int>> Tune(const X86ConvShape &shape);
+
+  // Tune all the conv shapes and append the params to the model_data keyed by their shapes
+  void Tune(const std::vector<X86ConvShape> &shapes,
+            absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, std::vector<int>>> *model_data);
+
+  // Return the average cost of the conv kernel scheduled with the params, unit: ms
+  double Measure(const X86ConvShape &shape, const absl::flat_hash_map<std::string, std::vector<int>> &params);
+
+  // Return the divisors of extent not greater than max_factor in ascending order
+  static std::vector<int> CandidateFactors(int extent, int max_factor);
+
+ private:
+  // Return the params to start tuning, from ScheduleParam if the shape has been recorded
+  absl::flat_hash_map<std::string, std::vector<int>> InitialParams(const X86ConvShape &shape) const;
+
+  // Return the candidates of a factor when the other ones are fixed
+  std::vector<int> Candidates(const X86ConvShape &shape,
+                              const absl::flat_hash_map<std::string, std::vector<int>> &params,
+                              const std::string &factor) const;
+
+  common::Target target_;
+  Config config_;
+};
+
+}  // namespace pe
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,89 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/pe/x86_conv_tuner.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "cinn/hlir/pe/schedule.h"
+
+namespace cinn {
+namespace hlir {
+namespace pe {
+
+TEST(X86ConvShape, FromKey) {
+  X86ConvShape shape;
+  shape.input_shape  = {1, 64, 56, 56};
+  shape.weight_shape = {128, 64, 3, 3};
+  shape.strides      = {2, 2};
+  shape.paddings     = {1, 1};
+  std::string key    = shape.Key();
+  ASSERT_EQ(key, "X86ScheduleConv input 1 64 56 56 weight 128 64 3 3 stride 2 2 padding 1 1 dilation 1 1");
+
+  auto parsed = X86ConvShape::FromKey("resnet18 index 7 " + key);
+  ASSERT_EQ(parsed.Key(), key);
+  ASSERT_EQ(parsed.OutputShape(), std::vector<int>({1, 128, 28, 28}));
+  ASSERT_FALSE(parsed.Is1x1());
+}
+
+TEST(X86ConvTuner, CandidateFactors) {
+  ASSERT_EQ(X86ConvTuner::CandidateFactors(56, 16), std::vector<int>({1, 2, 4, 7, 8, 14}));
+  ASSERT_EQ(X86ConvTuner::CandidateFactors(3, 64), std::vector<int>({1, 3}));
+}
+
+TEST(X86ConvTuner, TuneAndLoad) {
+  X86ConvShape conv_3x3;
+  conv_3x3.input_shape  = {1, 8, 14, 14};
+  conv_3x3.weight_shape = {16, 8, 3, 3};
+  conv_3x3.paddings     = {1, 1};
+  X86ConvShape conv_1x1;
+  conv_1x1.input_shape  = {1, 16, 14, 14};
+  conv_1x1.weight_shape = {8, 16, 1, 1};
+
+  X86ConvTuner::Config config;
+  config.repeat     = 1;
+  config.num_rounds = 1;
+  X86ConvTuner tuner(common::DefaultHostTarget(), config);
+  absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, std::vector<int>>> model_data;
+  tuner.Tune({conv_3x3, conv_1x1}, &model_data);
+  ASSERT_EQ(model_data.size(), 2);
+  auto &params_3x3 = model_data.at(conv_3x3.Key());
+  ASSERT_EQ(8 % params_3x3.at("ic_bn").back(), 0);
+  ASSERT_EQ(16 % params_3x3.at("oc_bn").back(), 0);
+  ASSERT_EQ(14 % params_3x3.at("ow_bn").back(), 0);
+  ASSERT_EQ(params_3x3.count("unroll_kw"), 1);
+  ASSERT_EQ(model_data.at(conv_1x1.Key()).count("oh_bn"), 1);
+
+  // the saved params are applied on the conv of the same shape in any model
+  std::string file_name = "./test_x86_conv_params.log";
+  SaveSerialData(model_data, file_name);
+  auto &param_data = ScheduleParam::get_x86_instance().GetParam();
+  LoadSerialData(&param_data, file_name);
+  std::remove(file_name.c_str());
+  absl::flat_hash_map<std::string, int> factors;
+  std::string model_key = "model index 0 " + conv_3x3.Key();
+  GetConv2dFactors(&factors, 16, 8, 8, -1, 14, Float(32), common::DefaultHostTarget(), model_key);
+  ASSERT_EQ(factors["ic_bn"], params_3x3.at("ic_bn").back());
+  ASSERT_EQ(factors["oc_bn"], params_3x3.at("oc_bn").back());
+  ASSERT_EQ(factors["ow_bn"], params_3x3.at("ow_bn").back());
+  ASSERT_EQ(factors["unroll_kw"], params_3x3.at("unroll_kw").back());
+  param_data.erase(conv_3x3.Key());
+  param_data.erase(conv_1x1.Key());
+}
+
+}  // namespace pe
+}  // namespace hlir
+}  // namespace cinn
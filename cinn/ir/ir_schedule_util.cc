@@ -227,6 +227,24 @@ std::vector<int> ValidateFactors(const std::vector<int>& factors, int total_exte
   }
 }
 
+std::vector<int> AdaptPerfectTileFactors(const std::vector<int>& factors, int extent) {
+  CHECK(!factors.empty()) << "The factors to adapt should not be empty";
+  CHECK_GT(extent, 0) << "The extent to tile should be positive";
+  std::vector<int> adapted(factors.size());
+  int remaining = extent;
+  for (int i = factors.size() - 1; i > 0; --i) {
+    CHECK_GT(factors[i], 0) << "The factors to adapt should be positive";
+    int factor = std::min(factors[i], remaining);
+    while (remaining % factor != 0) {
+      --factor;
+    }
+    adapted[i] = factor;
+    remaining /= factor;
+  }
+  adapted[0] = remaining;
+  return adapted;
+}
+
 void CHECKRfactorValidation(const Expr& rf_loop, int rf_axis) {
   auto* rf_for = rf_loop.As<ir::For>();
   CHECK(rf_for) << "Expr param of Rfactor must be For node! Please check.";
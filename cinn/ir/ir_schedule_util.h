@@ -234,6 +234,16 @@ void ReplaceExpr(Expr* source, const std::vector<Var>& replaced, const std::vect
  */
 std::vector<int> ValidateFactors(const std::vector<int>& factors, int total_extent);
 
+/**
+ * Re-derive the perfect tile factors sampled for a loop to tile another loop with a different extent.
+ * From the innermost, each factor is replaced by the largest divisor of the remaining extent not greater than it,
+ * and the outermost takes the rest, so the innermost tiles are kept as far as possible.
+ * @param factors The original factors whose product is the extent of the original loop.
+ * @param extent The extent of the loop to be tiled.
+ * @return The new factors whose product is extent.
+ */
+std::vector<int> AdaptPerfectTileFactors(const std::vector<int>& factors, int extent);
+
 void CHECKRfactorValidation(const Expr& rf_loop, int rf_axis);
 
 /**
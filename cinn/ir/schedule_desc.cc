@@ -16,12 +16,16 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <functional>
+#include <numeric>
 #include <typeinfo>
 #include <utility>
 
 #include "cinn/common/macros.h"
 #include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
+#include "cinn/utils/functional.h"
 #include "cinn/utils/string.h"
 
 namespace cinn {
@@ -561,14 +565,143 @@ struct ExprEqual {
   bool operator()(const Expr& lhs, const Expr& rhs) const { return lhs.get() == rhs.get(); }
 };
 
-void ScheduleDesc::Append(Step&& step) { steps_.emplace_back(std::move(step)); }
+// The finalizer of splitmix64, every bit of the input affects every bit of the output
+uint64_t Mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+// Combine a value into a fingerprint. Unlike utils::HashCombine, the hash of the value and the combined result
+// are mixed, since std::hash of an integer is the identity and the small integers of the decisions would
+// cancel each other out in a chain of shifts and xors
+template <typename T>
+uint64_t FingerprintCombine(uint64_t seed, const T& value) {
+  return Mix64(seed + 0x9e3779b97f4a7c15ULL + Mix64(std::hash<T>()(value)));
+}
+
+// Combine the value of an Attribute into a hash key
+struct AttributeHasher {
+  uint64_t hash_key;
+
+  template <typename T>
+  void operator()(const T& value) {
+    hash_key = FingerprintCombine(hash_key, value);
+  }
+
+  template <typename T>
+  void operator()(const std::vector<T>& values) {
+    hash_key = FingerprintCombine(hash_key, values.size());
+    for (auto&& value : values) {
+      hash_key = FingerprintCombine(hash_key, static_cast<T>(value));
+    }
+  }
+};
+
+ScheduleDesc::ScheduleDesc(const std::vector<Step>& steps) {
+  for (auto&& step : steps) {
+    Append(Step(step));
+  }
+}
+
+ScheduleDesc::ScheduleDesc(std::vector<Step>&& steps) {
+  for (auto&& step : steps) {
+    Append(std::move(step));
+  }
+}
+
+void ScheduleDesc::Append(Step&& step) {
+  steps_.emplace_back(std::move(step));
+  UpdateFingerprint();
+}
 
 void ScheduleDesc::Pop() {
-  if (!steps_.empty()) {
-    steps_.pop_back();
+  if (steps_.empty()) {
+    return;
+  }
+  // an output may be also produced by a preceding step, so the indices are rebuilt from the beginning
+  steps_.pop_back();
+  std::vector<Step> steps = std::move(steps_);
+  steps_.clear();
+  fingerprints_.clear();
+  output_indices_.clear();
+  for (auto&& step : steps) {
+    Append(std::move(step));
   }
 }
 
+void ScheduleDesc::UpdateFingerprint() {
+  const Step& step  = steps_.back();
+  uint64_t hash_key = fingerprints_.empty() ? 0 : fingerprints_.back();
+  hash_key          = FingerprintCombine(hash_key, step.type);
+
+  // the iteration order of a hash map is not deterministic, so the keys are sorted
+  std::vector<const std::string*> names;
+  for (auto&& param2exprs : step.inputs) {
+    names.push_back(&param2exprs.first);
+  }
+  std::sort(names.begin(), names.end(), [](const std::string* lhs, const std::string* rhs) { return *lhs < *rhs; });
+  for (const std::string* name : names) {
+    hash_key = FingerprintCombine(hash_key, *name);
+    for (auto&& expr : step.inputs.at(*name)) {
+      auto it  = output_indices_.find(expr.ptr());
+      hash_key = FingerprintCombine(hash_key, it != output_indices_.end() ? it->second : -1);
+    }
+  }
+
+  names.clear();
+  for (auto&& attr2value : step.attrs) {
+    names.push_back(&attr2value.first);
+  }
+  std::sort(names.begin(), names.end(), [](const std::string* lhs, const std::string* rhs) { return *lhs < *rhs; });
+  for (const std::string* name : names) {
+    const auto& attr_value = step.attrs.at(*name);
+    AttributeHasher hasher{FingerprintCombine(FingerprintCombine(hash_key, *name), attr_value.index())};
+    absl::visit(hasher, attr_value);
+    hash_key = hasher.hash_key;
+  }
+
+  for (auto&& expr : step.outputs) {
+    output_indices_.emplace(expr.ptr(), output_indices_.size());
+  }
+  hash_key = FingerprintCombine(hash_key, step.outputs.size());
+  fingerprints_.push_back(hash_key);
+}
+
+bool ScheduleDesc::SameSteps(const ScheduleDesc& other) const {
+  if (steps_.size() != other.steps_.size()) {
+    return false;
+  }
+  // an input is compared by the order of the output producing it, -1 if it is not produced by a step
+  auto input_index = [](const ScheduleDesc& desc, const Expr& expr) {
+    auto it = desc.output_indices_.find(expr.ptr());
+    return it != desc.output_indices_.end() ? it->second : -1;
+  };
+  for (int i = 0; i < steps_.size(); ++i) {
+    const Step& lhs = steps_[i];
+    const Step& rhs = other.steps_[i];
+    if (lhs.type != rhs.type || lhs.attrs != rhs.attrs || lhs.outputs.size() != rhs.outputs.size() ||
+        lhs.inputs.size() != rhs.inputs.size()) {
+      return false;
+    }
+    for (auto&& param2exprs : lhs.inputs) {
+      auto it = rhs.inputs.find(param2exprs.first);
+      if (it == rhs.inputs.end() || it->second.size() != param2exprs.second.size()) {
+        return false;
+      }
+      for (int j = 0; j < param2exprs.second.size(); ++j) {
+        if (input_index(*this, param2exprs.second[j]) != input_index(other, it->second[j])) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
 void ScheduleDesc::Replay(IRSchedule* schedule, bool without_post_schedule) const {
   ReplayWithProto(this->ToProto(), schedule, without_post_schedule);
 }
@@ -613,7 +746,8 @@ proto::ScheduleDesc ScheduleDesc::ToProto() const {
 
 std::vector<Expr> ScheduleDesc::ReplayWithProto(const proto::ScheduleDesc& desc_proto,
                                                 IRSchedule* sch,
-                                                bool without_post_schedule) {
+                                                bool without_post_schedule,
+                                                bool adapt_tile_factors) {
   VLOG(4) << "proto::ScheduleDesc:\n" << desc_proto.DebugString();
   if (desc_proto.steps().empty()) {
     LOG(WARNING) << "Input proto::ScheduleDesc is empty";
@@ -646,6 +780,17 @@ std::vector<Expr> ScheduleDesc::ReplayWithProto(const proto::ScheduleDesc& desc_
     for (auto&& attr : step_proto.attrs()) {
       step.attrs[attr.name()] = AttrProtoToVariant(attr);
     }
+    if (adapt_tile_factors && step.type == "SamplePerfectTile") {
+      int extent    = GetLoopExtent(step.inputs.at("loop").front());
+      auto decision = absl::get<std::vector<int>>(step.attrs.at("decision"));
+      bool is_perfect_tile =
+          !decision.empty() && std::all_of(decision.begin(), decision.end(), [](int factor) { return factor > 0; });
+      if (is_perfect_tile && std::accumulate(decision.begin(), decision.end(), 1, std::multiplies<int>()) != extent) {
+        step.attrs["decision"] = AdaptPerfectTileFactors(decision, extent);
+        VLOG(4) << "Adapt the decision of SamplePerfectTile from [" << utils::Join(decision, ",") << "] to ["
+                << utils::Join(absl::get<std::vector<int>>(step.attrs.at("decision")), ",") << "]";
+      }
+    }
 
     PackedStepContext context(step, step_kind, sch);
     step.outputs = step_kind->Apply(&context);
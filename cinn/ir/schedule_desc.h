@@ -55,16 +55,19 @@ class ScheduleDesc {
    * @param desc_proto The proto of the ScheduleDesc to be re-applied.
    * @param sch The original IRSchedule to be replayed the description on.
    * @param without_post_schedule Determine whether to delete the post schedules.
+   * @param adapt_tile_factors Whether to re-derive the decisions of SamplePerfectTile that don't match the extents
+   * of the loops, used to replay a description recorded on a ModuleExpr with the same structure but other shapes.
    */
   static std::vector<Expr> ReplayWithProto(const proto::ScheduleDesc& desc_proto,
                                            IRSchedule* sch,
-                                           bool without_post_schedule = false);
+                                           bool without_post_schedule = false,
+                                           bool adapt_tile_factors    = false);
 
   ScheduleDesc() = default;
 
-  ScheduleDesc(const std::vector<Step>& steps) : steps_(steps) {}
+  ScheduleDesc(const std::vector<Step>& steps);
 
-  ScheduleDesc(std::vector<Step>&& steps) : steps_(steps) {}
+  ScheduleDesc(std::vector<Step>&& steps);
 
   // Append a new step
   void Append(Step&& step);
@@ -72,6 +75,22 @@ class ScheduleDesc {
   // Pop the last step
   void Pop();
 
+  /**
+   * \brief Return a fingerprint of the recorded steps, which is computed incrementally on Append.
+   * It covers the type, attributes (including sampled decisions) and inputs of each step, where
+   * an input is represented by the order of the output producing it rather than its content, so
+   * two ScheduleDescs applying the same steps on the same original ModuleExpr get the same fingerprint
+   * regardless of the size of the IR.
+   */
+  uint64_t Fingerprint() const { return fingerprints_.empty() ? 0 : fingerprints_.back(); }
+
+  /**
+   * \brief Whether this and the other ScheduleDesc record the same steps, it compares what Fingerprint covers:
+   * the type, attributes and inputs of each step, where an input is represented by the order of the output
+   * producing it. Two different ScheduleDescs may collide in the fingerprint, but never pass this comparison.
+   */
+  bool SameSteps(const ScheduleDesc& other) const;
+
   /**
    * \brief Replay this description to a new IRSchedule that is initialzied by a semantics-euqal original ModuleExpr.
    * @param schedule The original IRSchedule to be replayed the description on.
@@ -85,7 +104,7 @@ class ScheduleDesc {
   // return detail string of a ScheduleDesc for debug;
   std::string DebugString() const { return ToProto().DebugString(); }
 
-  std::vector<Step> Steps() const { return steps_; }
+  const std::vector<Step>& Steps() const { return steps_; }
 
   bool Empty() const { return steps_.empty(); }
 
@@ -99,7 +118,14 @@ class ScheduleDesc {
   ScheduleDesc ForkAndUpdate(int step_idx, utils::Attribute decision, bool without_post_schedule) const;
 
  private:
+  // Update the fingerprint and the output indices with the last step
+  void UpdateFingerprint();
+
   std::vector<Step> steps_;  // all operations are recorded in order.
+  // the fingerprint of steps_[0, i] at index i
+  std::vector<uint64_t> fingerprints_;
+  // map each output Expr to the order it first appears, in the same way as ToProto names it
+  absl::flat_hash_map<const IrNode*, int> output_indices_;
 };
 
 }  // namespace ir
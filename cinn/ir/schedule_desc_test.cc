@@ -17,10 +17,13 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <unordered_set>
+
 #include "cinn/cinn.h"
 #include "cinn/common/context.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
 #include "cinn/lang/lower.h"
 #include "cinn/optim/ir_copy.h"
 #include "cinn/utils/string.h"
@@ -805,5 +808,100 @@ TEST_F(TestScheduleDesc, StepKind_SampleCategorical) {
   CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
 }
 
+TEST_F(TestScheduleDesc, Fingerprint) {
+  lowered_funcs = LowerCompute({32, 32}, target);
+  auto split_fn = [this](const std::vector<int>& factors) {
+    ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+    auto loops            = ir_sch.GetLoops("B");
+    ir_sch.Split(loops[0], factors);
+    return ir_sch.GetTraceDesc();
+  };
+  ScheduleDesc trace1 = split_fn({4, 8});
+  ScheduleDesc trace2 = split_fn({4, 8});
+  ScheduleDesc trace3 = split_fn({8, 4});
+  ASSERT_EQ(trace1.Fingerprint(), trace2.Fingerprint());
+  ASSERT_NE(trace1.Fingerprint(), trace3.Fingerprint());
+  // a ScheduleDesc constructed from the steps gets the same fingerprint
+  ASSERT_EQ(ScheduleDesc(trace1.Steps()).Fingerprint(), trace1.Fingerprint());
+
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+  ir_sch.GetLoops("B");
+  trace3.Pop();
+  ASSERT_EQ(trace3.Fingerprint(), ir_sch.GetTraceDesc().Fingerprint());
+  trace3.Pop();
+  ASSERT_EQ(trace3.Fingerprint(), ScheduleDesc().Fingerprint());
+
+  // the loops are referred by the order of outputs, so splitting another loop differs
+  ir::IRSchedule ir_sch2 = MakeIRSchedule(lowered_funcs);
+  auto loops             = ir_sch2.GetLoops("B");
+  ir_sch2.Split(loops[1], {4, 8});
+  ASSERT_NE(trace1.Fingerprint(), ir_sch2.GetTraceDesc().Fingerprint());
+}
+
+TEST(ScheduleDesc, FingerprintOfDecisions) {
+  auto make_trace = [](const std::vector<std::vector<int>>& decisions) {
+    ScheduleDesc trace;
+    for (const auto& decision : decisions) {
+      trace.Append(ScheduleDesc::Step("SamplePerfectTile", {}, {{"decision", decision}}, {}));
+    }
+    return trace;
+  };
+  // the pair collided when the decisions were combined by identity hashes in a chain of shifts and xors
+  ScheduleDesc trace1 = make_trace({{1, 1, 64, 4}, {1, 2, 128, 1}});
+  ScheduleDesc trace2 = make_trace({{1, 1, 64, 4}, {1, 4, 1, 64}});
+  ASSERT_NE(trace1.Fingerprint(), trace2.Fingerprint());
+  ASSERT_FALSE(trace1.SameSteps(trace2));
+  ASSERT_TRUE(trace1.SameSteps(make_trace({{1, 1, 64, 4}, {1, 2, 128, 1}})));
+
+  // no pair of the 4-way factorizations of 256 in two steps collides
+  std::vector<std::vector<int>> factorizations;
+  for (int a = 1; a <= 256; a *= 2) {
+    for (int b = 1; a * b <= 256; b *= 2) {
+      for (int c = 1; a * b * c <= 256; c *= 2) {
+        factorizations.push_back({a, b, c, 256 / (a * b * c)});
+      }
+    }
+  }
+  std::unordered_set<uint64_t> fingerprints;
+  for (const auto& first : factorizations) {
+    for (const auto& second : factorizations) {
+      ASSERT_TRUE(fingerprints.insert(make_trace({first, second}).Fingerprint()).second);
+    }
+  }
+}
+
+TEST(AdaptPerfectTileFactors, Basic) {
+  ASSERT_EQ(AdaptPerfectTileFactors({4, 8}, 32), std::vector<int>({4, 8}));
+  ASSERT_EQ(AdaptPerfectTileFactors({4, 8}, 64), std::vector<int>({8, 8}));
+  // the inner factors are kept as close as possible, and the outermost one takes the remaining extent
+  ASSERT_EQ(AdaptPerfectTileFactors({2, 4, 8}, 48), std::vector<int>({2, 3, 8}));
+  ASSERT_EQ(AdaptPerfectTileFactors({1, 16}, 12), std::vector<int>({1, 12}));
+  ASSERT_EQ(AdaptPerfectTileFactors({4, 8}, 7), std::vector<int>({1, 7}));
+}
+
+TEST_F(TestScheduleDesc, ReplayWithAdaptedTileFactors) {
+  lowered_funcs         = LowerCompute({32, 32}, target);
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+  auto loops            = ir_sch.GetLoops("B");
+  auto sample           = ir_sch.SamplePerfectTile(loops[0], 2, 8, {4, 8});
+  ir_sch.Split(loops[0], sample);
+  proto::ScheduleDesc trace_proto = ir_sch.GetTraceDesc().ToProto();
+
+  // replay the trace on a larger shape
+  lowered_funcs             = LowerCompute({64, 32}, target);
+  ir::IRSchedule replay_sch = MakeIRSchedule(lowered_funcs);
+  ScheduleDesc::ReplayWithProto(trace_proto, &replay_sch, false, /*adapt_tile_factors=*/true);
+  loops = replay_sch.GetLoops("B");
+  ASSERT_EQ(loops.size(), 3);
+  EXPECT_EQ(GetLoopExtent(loops[0]), 8);
+  EXPECT_EQ(GetLoopExtent(loops[1]), 8);
+  EXPECT_EQ(GetLoopExtent(loops[2]), 32);
+  // the adapted decision is traced for replaying on the new shape exactly
+  ir::IRSchedule replay_sch2 = MakeIRSchedule(lowered_funcs);
+  ScheduleDesc::ReplayWithProto(replay_sch.GetTraceDesc().ToProto(), &replay_sch2);
+  ASSERT_EQ(utils::GetStreamCnt(replay_sch.GetModule().GetExprs().front()),
+            utils::GetStreamCnt(replay_sch2.GetModule().GetExprs().front()));
+}
+
 }  // namespace ir
 }  // namespace cinn
@@ -272,7 +272,8 @@ struct IRCopyVisitor : public ir::IRVisitorBase<Expr> {
 
   Expr Visit(const Let* op) override {
     auto value = Visit(&op->symbol);
-    auto body  = Visit(&op->body);
+    Expr body;
+    if (op->body.defined()) body = Visit(&op->body);
 
     return Let::Make(value, body);
   }
@@ -26,11 +26,14 @@
 #include "cinn/common/cas.h"
 #include "cinn/common/ir_util.h"
 #include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_compare.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/ir_printer.h"
+#include "cinn/ir/operation.h"
 #include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_replace.h"
 #include "cinn/optim/ir_simplify.h"
+#include "cinn/optim/remove_schedule_block.h"
 #include "cinn/optim/tensor_write_tell.h"
 #include "cinn/optim/unroll_loops.h"
 #include "cinn/utils/functional.h"
@@ -689,7 +692,23 @@ struct VectorizeLoops_ : public IRMutator<Expr *> {
         return;
       }
 
-      const int factor  = forloop->vectorize_info().factor;
+      const int factor = forloop->vectorize_info().factor;
+      Expr tail_forloop;
+      // the reduction and the tail are only rewritten on host, an unknown target keeps the previous behavior
+      if (target.arch == Target::Arch::X86 && node->extent.As<IntImm>()) {
+        if (node->extent.as_int32() < factor) {
+          VLOG(5) << "Not vectorize the loop over " << loopvar_name << " shorter than the factor " << factor;
+          node->reset_vectorize_info();
+          var_intervals.erase(loopvar_name);
+          return;
+        }
+        if (VectorizeReduction(node, factor, expr)) {
+          var_intervals.erase(loopvar_name);
+          return;
+        }
+        tail_forloop = SplitTail(node, factor);
+      }
+
       auto _new_forloop = SplitForLoop(node, factor);
       if (!_new_forloop.defined()) {
         IRMutator<>::Visit(&node->body, &node->body);
@@ -746,12 +765,194 @@ struct VectorizeLoops_ : public IRMutator<Expr *> {
       } else {
         node->body = new_forloop->body;
       }
+      if (tail_forloop.defined()) {
+        *expr = Block::Make({*expr, tail_forloop});
+      }
     } else {
       IRMutator::Visit(forloop, expr);
     }
     var_intervals.erase(loopvar_name);
   }
 
+  //! Leave the iterations of a constant extent beyond the multiple of \p factor to a scalar loop.
+  //! @return The scalar loop, undefined if the extent is a multiple of \p factor.
+  Expr SplitTail(For *forloop, int factor) {
+    int extent      = forloop->extent.as_int32();
+    int main_extent = extent / factor * factor;
+    if (main_extent == extent) return Expr();
+
+    Var tail_var(common::UniqName(forloop->loop_var->name + "_tail"));
+    Expr tail_body = IRCopy(forloop->body);
+    optim::IrReplace(&tail_body, forloop->loop_var, Expr(tail_var));
+    forloop->extent = make_const(forloop->extent->type(), main_extent);
+    var_intervals.erase(forloop->loop_var->name);
+    var_intervals.emplace(forloop->loop_var->name, common::CasInterval{0, main_extent - 1});
+    VLOG(5) << "Split the scalar tail [" << main_extent << ", " << extent << ") from the loop over "
+            << forloop->loop_var;
+    return For::Make(tail_var,
+                     make_const(forloop->extent->type(), main_extent),
+                     make_const(forloop->extent->type(), extent),
+                     ForType::Serial,
+                     forloop->device_api,
+                     tail_body);
+  }
+
+  static Expr MakeReduceOp(IrNodeTy op_type, Expr a, Expr b) {
+    switch (op_type) {
+      case IrNodeTy::Add:
+        return Add::Make(a, b);
+      case IrNodeTy::Mul:
+        return Mul::Make(a, b);
+      case IrNodeTy::Max:
+        return Max::Make(a, b);
+      case IrNodeTy::Min:
+        return Min::Make(a, b);
+      default:
+        LOG(FATAL) << "Not supported reduce op " << op_type;
+    }
+    return Expr();
+  }
+
+  //! Vectorize the loop with a constant extent if its body is a reduction over the loop var, T[idx] = op(T[idx], value)
+  //! where op is one of +, *, max and min, idx doesn't use the loop var and value doesn't read T. Each lane keeps a
+  //! partial result in a local array, they are combined after the loop, and the iterations beyond the multiple of
+  //! \p factor are left to a scalar tail.
+  //! @return Whether the loop is vectorized, \p expr is replaced by the new statements if it is.
+  bool VectorizeReduction(For *forloop, int factor, Expr *expr) {
+    auto single_stmt = [](Expr stmt) {
+      while (stmt.As<Block>() && stmt.As<Block>()->stmts.size() == 1) {
+        stmt = stmt.As<Block>()->stmts.front();
+      }
+      return stmt;
+    };
+    Expr stmt = single_stmt(forloop->body);
+    if (stmt.As<ScheduleBlockRealize>()) {
+      // replace the iter vars with the loop vars bound to them
+      stmt = IRCopy(stmt);
+      RemoveScheduleBlock(&stmt);
+      stmt = single_stmt(stmt);
+    }
+    auto *store = stmt.As<Store>();
+    if (!store || !store->is_addr_tensor()) return false;
+    Type type = store->value.type();
+    if (!type.is_scalar() || type.is_bool() || !(type.is_float() || type.is_int() || type.is_uint())) return false;
+
+    Expr a, b;
+    auto op_type = store->value->node_type();
+    if (auto *add = store->value.As<Add>()) {
+      a = add->a(), b = add->b();
+    } else if (auto *mul = store->value.As<Mul>()) {
+      a = mul->a(), b = mul->b();
+    } else if (auto *max = store->value.As<Max>()) {
+      a = max->a(), b = max->b();
+    } else if (auto *min = store->value.As<Min>()) {
+      a = min->a(), b = min->b();
+    } else {
+      return false;
+    }
+
+    const Var &var = forloop->loop_var;
+    auto use_var   = [&](const Expr &e) {
+      return !ir::CollectIRNodes(e, [&](const Expr *x) { return x->As<_Var_>() && x->As<_Var_>()->name == var->name; })
+                  .empty();
+    };
+    auto is_reduced = [&](const Expr &e) {
+      auto *load = e.As<Load>();
+      if (!load || !load->is_addr_tensor() || load->name() != store->name() ||
+          load->indices.size() != store->indices.size()) {
+        return false;
+      }
+      for (int i = 0; i < load->indices.size(); ++i) {
+        if (!ir::IrEqualVisitor().Compare(load->indices[i], store->indices[i])) return false;
+      }
+      return true;
+    };
+    Expr value = is_reduced(a) ? b : (is_reduced(b) ? a : Expr());
+    if (!value.defined() || !use_var(value)) return false;
+    for (auto &index : store->indices) {
+      if (use_var(index)) return false;
+    }
+    auto reads_reduced = ir::CollectIRNodes(value, [&](const Expr *x) {
+      return x->As<Load>() && x->As<Load>()->is_addr_tensor() && x->As<Load>()->name() == store->name();
+    });
+    if (!reads_reduced.empty()) return false;
+
+    int extent = forloop->extent.as_int32();
+    int times  = extent / factor;
+    VLOG(2) << "Vectorizing the reduction over " << var << " extent " << extent << " factor " << factor;
+
+    // the local array of the partial results
+    auto *tensor         = store->tensor.As<_Tensor_>();
+    std::string acc_name = common::UniqName(tensor->name + "_vacc");
+    Var acc_var(acc_name, type.with_lanes(factor));
+    // it has its own placeholder operation, so it is not regarded as another view of the reduced tensor
+    ir::Tensor acc(
+        acc_name, type, {Expr(factor)}, {Expr(factor)}, ir::PlaceholderOp::Make(acc_name, {Expr(factor)}, type));
+    Var lane(Context::Global().NewName("vi"));
+    var_intervals.emplace(lane->name, common::CasInterval{0, factor - 1});
+    auto lane_value = [&](Expr index) {
+      Expr res = IRCopy(value);
+      optim::IrReplace(&res, var, index);
+      return res;
+    };
+
+    // the lanes start from the first vector of values
+    std::vector<Expr> stmts{Let::Make(acc_var, Expr())};
+    Expr init = Store::Make(acc, lane_value(Expr(lane)), {Expr(lane)});
+    Vectorizer(lane, factor, var_intervals).Visit(&init);
+    stmts.push_back(init);
+    if (times > 1) {
+      Var outer(common::UniqName(var->name + "_outer"));
+      var_intervals.emplace(outer->name, common::CasInterval{1, times - 1});
+      Expr partial = Load::Make(acc, {Expr(lane)});
+      Expr update  = Store::Make(
+          acc, MakeReduceOp(op_type, partial, lane_value(Expr(outer) * factor + Expr(lane))), {Expr(lane)});
+      Vectorizer(lane, factor, var_intervals).Visit(&update);
+      stmts.push_back(For::Make(outer,
+                                make_const(forloop->extent->type(), 1),
+                                make_const(forloop->extent->type(), times),
+                                ForType::Serial,
+                                forloop->device_api,
+                                Block::Make({update})));
+      var_intervals.erase(outer->name);
+    }
+    var_intervals.erase(lane->name);
+
+    // combine the lanes pairwise
+    std::vector<Expr> partials;
+    for (int i = 0; i < factor; ++i) {
+      partials.push_back(Load::Make(acc, {make_const(i)}));
+    }
+    while (partials.size() > 1) {
+      std::vector<Expr> combined;
+      for (int i = 0; i + 1 < partials.size(); i += 2) {
+        combined.push_back(MakeReduceOp(op_type, partials[i], partials[i + 1]));
+      }
+      if (partials.size() % 2) {
+        combined.push_back(partials.back());
+      }
+      partials.swap(combined);
+    }
+    Expr reduced = Load::Make(store->tensor, IRCopy(store->indices));
+    stmts.push_back(
+        Store::Make(store->tensor, MakeReduceOp(op_type, reduced, partials.front()), IRCopy(store->indices)));
+
+    if (times * factor < extent) {
+      Var tail_var(common::UniqName(var->name + "_tail"));
+      Expr tail_store = IRCopy(stmt);
+      optim::IrReplace(&tail_store, var, Expr(tail_var));
+      stmts.push_back(For::Make(tail_var,
+                                make_const(forloop->extent->type(), times * factor),
+                                forloop->extent,
+                                ForType::Serial,
+                                forloop->device_api,
+                                Block::Make({tail_store})));
+    }
+    *expr = Block::Make(stmts);
+    VLOG(2) << "after vectorize reduction:\n" << *expr;
+    return true;
+  }
+
   //! unroll the forloop if its' extent is min type by solving the condition extent
   //! @return The new forloop.
   bool UnrollCmpFor(For *outer_for, For *inner_for, Expr *expr) {
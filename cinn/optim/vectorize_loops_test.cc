@@ -22,6 +22,7 @@
 #include "cinn/common/common.h"
 #include "cinn/common/ir_util.h"
 #include "cinn/ir/ir_operators.h"
+#include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/optim/optimize.h"
 #include "cinn/optim/transform_polyfor_to_for.h"
@@ -232,6 +233,78 @@ TEST(Vectorize, single_for) {
   LOG(INFO) << "Forloop\n" << forloop;
 }
 
+TEST(Vectorize, reduce_sum) {
+  Placeholder<float> A("A", std::vector<int>{{4, 20}});
+  Placeholder<float> C("C", std::vector<int>{{4}});
+
+  Var i("i");
+  Var k("k");
+  // C[i] = C[i] + A[i, k]
+  Expr body = Store::Make(
+      ir::Tensor(C),
+      ir::Add::Make(ir::Load::Make(ir::Tensor(C), {Expr(i)}), ir::Load::Make(ir::Tensor(A), {Expr(i) * 20 + k})),
+      {Expr(i)});
+  body = ir::Block::Make({body});
+
+  VectorizeInfo vectorize_info(0, 8);
+  Expr forloop = ir::For::Make(k,
+                               common::make_const(0),
+                               common::make_const(20),
+                               ir::ForType::Vectorized,
+                               ir::DeviceAPI::UNK,
+                               body,
+                               vectorize_info);
+
+  VectorizeLoops(&forloop, common::DefaultHostTarget());
+  optim::Simplify(&forloop);
+  auto out = GetStreamCnt(forloop);
+  LOG(INFO) << "Forloop\n" << out;
+
+  // the lanes accumulate to a local vector which is combined once after the loop
+  EXPECT_NE(out.find("C_vacc"), std::string::npos);
+  EXPECT_NE(out.find("Ramp("), std::string::npos);
+  EXPECT_NE(out.find("k_outer"), std::string::npos);
+  EXPECT_NE(out.find(", 1, 2)"), std::string::npos);
+  EXPECT_NE(out.find("k_tail"), std::string::npos);
+  EXPECT_NE(out.find(", 16, 20)"), std::string::npos);
+  EXPECT_EQ(out.find("C[Ramp("), std::string::npos);
+}
+
+TEST(Vectorize, scalar_tail) {
+  Placeholder<float> A("A", std::vector<int>{{10}});
+  Placeholder<float> C("C", std::vector<int>{{10}});
+
+  Var k("k");
+  Expr body    = Store::Make(ir::Tensor(C), ir::Load::Make(ir::Tensor(A), {Expr(k)}) * 2.f, {Expr(k)});
+  Expr forloop = ir::For::Make(k,
+                               common::make_const(0),
+                               common::make_const(10),
+                               ir::ForType::Vectorized,
+                               ir::DeviceAPI::UNK,
+                               ir::Block::Make({body}),
+                               VectorizeInfo(0, 4));
+
+  VectorizeLoops(&forloop, common::DefaultHostTarget());
+  optim::Simplify(&forloop);
+  auto out = GetStreamCnt(forloop);
+  LOG(INFO) << "Forloop\n" << out;
+
+  EXPECT_NE(out.find("C[Ramp("), std::string::npos);
+  EXPECT_NE(out.find("k_tail"), std::string::npos);
+  EXPECT_NE(out.find(", 8, 10)"), std::string::npos);
+
+  // a loop shorter than the factor stays scalar
+  Expr short_loop = ir::For::Make(k,
+                                  common::make_const(0),
+                                  common::make_const(3),
+                                  ir::ForType::Vectorized,
+                                  ir::DeviceAPI::UNK,
+                                  ir::Block::Make({IRCopy(body)}),
+                                  VectorizeInfo(0, 4));
+  VectorizeLoops(&short_loop, common::DefaultHostTarget());
+  EXPECT_EQ(GetStreamCnt(short_loop).find("Ramp("), std::string::npos);
+}
+
 TEST(Vectorize, cuda_vectorize) {
   Expr M(100);
   Expr N(500);
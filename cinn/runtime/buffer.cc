@@ -42,8 +42,8 @@ Shape::value_type Shape::operator[](int i) const {
   return data_[i];
 }
 
-uint32_t Shape::num_elements() const {
-  uint32_t res = ndims_ > 0 ? 1 : 0;
+uint64_t Shape::num_elements() const {
+  uint64_t res = ndims_ > 0 ? 1 : 0;
   for (int i = 0; i < ndims(); i++) res *= (*this)[i];
   return res;
 }
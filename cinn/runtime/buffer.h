@@ -46,7 +46,7 @@ struct Shape {
   void Resize(int ndim);
 
   //! Get the number of elements the shape defines.
-  uint32_t num_elements() const;
+  uint64_t num_elements() const;
 
   //! Get i-th element.
   value_type& operator[](int i);
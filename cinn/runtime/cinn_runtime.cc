@@ -39,7 +39,7 @@ int cinn_buffer_free(void* context, struct cinn_buffer_t* buf) {
   return buf->device_interface->impl->free(context, buf);
 }
 
-void* cinn_buffer_slice(struct cinn_buffer_t* buf, uint32_t offset) {
+void* cinn_buffer_slice(struct cinn_buffer_t* buf, uint64_t offset) {
   CINN_CHECK(buf);
   uint64_t offset_byte = offset * buf->type.bytes();
   CINN_CHECK_LT(offset_byte, buf->memory_size);
@@ -311,16 +311,16 @@ struct cinn_device_interface_impl_t {
 // The device implementations
 extern struct cinn_device_interface_t* cinn_x86_device_interface();
 
-inline cinn::common::bfloat16 cinn_buffer_load_bfloat16(struct cinn_buffer_t* buf, uint32_t index) {
+inline cinn::common::bfloat16 cinn_buffer_load_bfloat16(struct cinn_buffer_t* buf, uint64_t index) {
   return ((cinn::common::bfloat16*)buf->memory)[index];  // NOLINT
 }
-inline cinn::common::float16 cinn_buffer_load_float16(struct cinn_buffer_t* buf, uint32_t index) {
+inline cinn::common::float16 cinn_buffer_load_float16(struct cinn_buffer_t* buf, uint64_t index) {
   return ((cinn::common::float16*)buf->memory)[index];  // NOLINT
 }
-inline float cinn_buffer_load_float32(struct cinn_buffer_t* buf, uint32_t index) {
+inline float cinn_buffer_load_float32(struct cinn_buffer_t* buf, uint64_t index) {
   return ((float*)buf->memory)[index];  // NOLINT
 }
-inline double cinn_buffer_load_float64(struct cinn_buffer_t* buf, uint32_t index) {
+inline double cinn_buffer_load_float64(struct cinn_buffer_t* buf, uint64_t index) {
   return ((double*)buf->memory)[index];  // NOLINT
 }
 #endif  // __cplusplus
@@ -329,7 +329,7 @@ inline double cinn_buffer_load_float64(struct cinn_buffer_t* buf, uint32_t index
 extern "C" {
 #endif
 
-CINN_ALWAYS_INLINE void* cinn_buffer_slice(struct cinn_buffer_t* buf, uint32_t offset);
+CINN_ALWAYS_INLINE void* cinn_buffer_slice(struct cinn_buffer_t* buf, uint64_t offset);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,413 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_custom_call.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/host_gemm.h"
+#include "cinn/runtime/flags.h"
+#include "cinn/utils/profiler.h"
+
+#ifdef CINN_WITH_MKL_CBLAS
+#include "cinn/runtime/cpu/cblas.h"
+#endif
+
+namespace {
+
+using cinn::runtime::cpu::Philox4x32;
+
+/**
+ * Compute out = alpha * op(A) * op(B) + beta * out for a single matrix, where op(A) is M x K and op(B) is K x N in
+ * row-major, and out is N x M if trans_o else M x N.
+ */
+template <typename T>
+void HostGemm(const T* A,
+              const T* B,
+              T* out,
+              int M,
+              int N,
+              int K,
+              bool trans_a,
+              bool trans_b,
+              bool trans_o,
+              float alpha,
+              float beta) {
+  cinn::runtime::cpu::PackedGemm<T>(M,
+                                    N,
+                                    K,
+                                    static_cast<T>(alpha),
+                                    A,
+                                    trans_a ? 1 : K,
+                                    trans_a ? M : 1,
+                                    B,
+                                    trans_b ? 1 : N,
+                                    trans_b ? K : 1,
+                                    static_cast<T>(beta),
+                                    out,
+                                    trans_o ? 1 : N,
+                                    trans_o ? M : 1);
+}
+
+#ifdef CINN_WITH_MKL_CBLAS
+inline CBLAS_TRANSPOSE ToCblasTranspose(bool trans) { return trans ? CblasTrans : CblasNoTrans; }
+
+void HostGemm(const float* A,
+              const float* B,
+              float* out,
+              int M,
+              int N,
+              int K,
+              bool trans_a,
+              bool trans_b,
+              bool trans_o,
+              float alpha,
+              float beta) {
+  int lda = trans_a ? M : K;
+  int ldb = trans_b ? K : N;
+  if (trans_o) {
+    // out^T = op(B)^T * op(A)^T
+    cblas_sgemm(CblasRowMajor,
+                ToCblasTranspose(!trans_b),
+                ToCblasTranspose(!trans_a),
+                N,
+                M,
+                K,
+                alpha,
+                B,
+                ldb,
+                A,
+                lda,
+                beta,
+                out,
+                M);
+  } else {
+    cblas_sgemm(CblasRowMajor,
+                ToCblasTranspose(trans_a),
+                ToCblasTranspose(trans_b),
+                M,
+                N,
+                K,
+                alpha,
+                A,
+                lda,
+                B,
+                ldb,
+                beta,
+                out,
+                N);
+  }
+}
+#endif
+
+template <typename T>
+void HostBatchedGemm(cinn_buffer_t* A,
+                     cinn_buffer_t* B,
+                     cinn_buffer_t* out,
+                     bool trans_a,
+                     bool trans_b,
+                     bool trans_o,
+                     float alpha,
+                     float beta,
+                     const int a_shape[4],
+                     const int b_shape[4]) {
+  int M = trans_a ? a_shape[3] : a_shape[2];
+  int K = trans_a ? a_shape[2] : a_shape[3];
+  int N = trans_b ? b_shape[2] : b_shape[3];
+  CHECK_EQ(K, trans_b ? b_shape[3] : b_shape[2]) << "The K dimension of gemm should be equal";
+  for (int i = 0; i < 2; ++i) {
+    CHECK(a_shape[i] == b_shape[i] || a_shape[i] == 1 || b_shape[i] == 1)
+        << "The batch dimensions of gemm can't be broadcast: " << a_shape[i] << " vs " << b_shape[i];
+  }
+  int batch1 = std::max(a_shape[0], b_shape[0]);
+  int batch2 = std::max(a_shape[1], b_shape[1]);
+
+  const T* A_data = reinterpret_cast<const T*>(A->memory);
+  const T* B_data = reinterpret_cast<const T*>(B->memory);
+  T* out_data     = reinterpret_cast<T*>(out->memory);
+  for (int i = 0; i < batch1; ++i) {
+    for (int j = 0; j < batch2; ++j) {
+      int64_t a_id = static_cast<int64_t>(a_shape[0] == 1 ? 0 : i) * a_shape[1] + (a_shape[1] == 1 ? 0 : j);
+      int64_t b_id = static_cast<int64_t>(b_shape[0] == 1 ? 0 : i) * b_shape[1] + (b_shape[1] == 1 ? 0 : j);
+      int64_t o_id = static_cast<int64_t>(i) * batch2 + j;
+      HostGemm(A_data + a_id * M * K,
+               B_data + b_id * K * N,
+               out_data + o_id * M * N,
+               M,
+               N,
+               K,
+               trans_a,
+               trans_b,
+               trans_o,
+               alpha,
+               beta);
+    }
+  }
+}
+
+// Map the 24 high bits of x to a float in [0, 1)
+inline float ToUniformFloat(uint32_t x) { return (x >> 8) * (1.0f / (1u << 24)); }
+
+// Map the 53 high bits of (hi, lo) to a double in [0, 1)
+inline double ToUniformDouble(uint32_t hi, uint32_t lo) {
+  uint64_t x = (static_cast<uint64_t>(hi) << 32 | lo) >> 11;
+  return x * (1.0 / (1ull << 53));
+}
+
+// Resolve the seed of a call taking num_counters counters and return its first counter. As curand on NVGPU, seed 0
+// takes the global random seed and continues from the counters taken by the previous calls with it, so it generates
+// different numbers on every execution. A nonzero seed always starts from counter 0 to be reproducible.
+uint64_t TakePhiloxCounters(int seed, uint64_t num_counters, uint64_t* rand_seed) {
+  if (seed != 0) {
+    *rand_seed = static_cast<uint64_t>(seed);
+    return 0;
+  }
+  static std::mutex mtx;
+  static std::unordered_map<uint64_t, uint64_t> next_counters;
+  *rand_seed = cinn::runtime::RandomSeed::GetOrSet();
+  std::lock_guard<std::mutex> lock(mtx);
+  uint64_t& next_counter = next_counters[*rand_seed];
+  uint64_t first_counter = next_counter;
+  next_counter += num_counters;
+  return first_counter;
+}
+
+// Fill out[0, numel) by fn(random numbers of a counter, begin, end) which fills out[begin, end), each counter fills
+// num_per_counter elements so that the results are the same however the buffer is split.
+template <typename Fn>
+void PhiloxFill(int seed, size_t numel, int num_per_counter, const Fn& fn) {
+  uint64_t rand_seed     = 0;
+  uint64_t first_counter = TakePhiloxCounters(seed, (numel + num_per_counter - 1) / num_per_counter, &rand_seed);
+  Philox4x32 philox(rand_seed);
+  for (size_t begin = 0, counter = first_counter; begin < numel; begin += num_per_counter, ++counter) {
+    fn(philox(static_cast<uint64_t>(counter)), begin, std::min(numel, begin + num_per_counter));
+  }
+}
+
+}  // namespace
+
+void cinn_call_host_gemm(void* v_args,
+                         int num_args,
+                         bool trans_a,
+                         bool trans_b,
+                         bool trans_o,
+                         float alpha,
+                         float beta,
+                         int a1,
+                         int a2,
+                         int a3,
+                         int a4,
+                         int b1,
+                         int b2,
+                         int b3,
+                         int b4) {
+  cinn::utils::RecordEvent record_run("cinn_call_host_gemm", cinn::utils::EventType::kInstruction);
+  CHECK_EQ(num_args, 3) << "The cinn_call_host_gemm only accept two inputs and a output";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* A       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* B       = args[1].operator cinn_buffer_t*();
+  cinn_buffer_t* out     = args[2].operator cinn_buffer_t*();
+  VLOG(4) << "call cinn_call_host_gemm with a1 ~ a4: " << a1 << " " << a2 << " " << a3 << " " << a4
+          << ", b1 ~ b4: " << b1 << " " << b2 << " " << b3 << " " << b4 << ", trans_a: " << trans_a
+          << ", trans_b: " << trans_b << ", trans_o: " << trans_o;
+
+  const int a_shape[4] = {a1, a2, a3, a4};
+  const int b_shape[4] = {b1, b2, b3, b4};
+  if (A->type == cinn_float32_t()) {
+    HostBatchedGemm<float>(A, B, out, trans_a, trans_b, trans_o, alpha, beta, a_shape, b_shape);
+  } else if (A->type == cinn_float64_t()) {
+    HostBatchedGemm<double>(A, B, out, trans_a, trans_b, trans_o, alpha, beta, a_shape, b_shape);
+  } else {
+    LOG(FATAL) << "cinn_call_host_gemm only support float32 and float64! Please check.";
+  }
+}
+
+void cinn_call_host_memset(void* v_args, int num_args, int value, size_t count) {
+  CHECK_EQ(num_args, 1) << "The cinn_call_host_memset only accept a output";
+  VLOG(4) << "call cinn_call_host_memset with value=" << value << ", count=" << count;
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  std::memset(args[0].operator cinn_buffer_t*()->memory, value, count);
+}
+
+void cinn_call_host_memcpy(void* v_args, int num_args, size_t count) {
+  CHECK_EQ(num_args, 2) << "The cinn_call_host_memcpy only accept a input and a output";
+  VLOG(4) << "call cinn_call_host_memcpy with count=" << count;
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  void* input            = args[0].operator cinn_buffer_t*()->memory;
+  void* output           = args[1].operator cinn_buffer_t*()->memory;
+  if (input != output) {
+    std::memcpy(output, input, count);
+  }
+}
+
+void cinn_call_host_gaussian_random(void* v_args, int num_args, float mean, float std, int seed) {
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* output  = args[0].operator cinn_buffer_t*();
+  cinn_type_t dtype      = output->type;
+  size_t numel           = output->num_elements();
+  VLOG(4) << "cinn_call_host_gaussian_random: output_size=" << numel << ", mean=" << mean << ", std=" << std
+          << ", seed=" << seed;
+
+  // Box-Muller transform, 1 - u is in (0, 1] to avoid log(0)
+  constexpr double kTwoPi = 6.283185307179586;
+  if (dtype == cinn_float32_t()) {
+    float* ptr = reinterpret_cast<float*>(output->memory);
+    PhiloxFill(seed, numel, 4, [&](const std::array<uint32_t, 4>& r, size_t begin, size_t end) {
+      float values[4];
+      for (int i = 0; i < 4; i += 2) {
+        float radius  = std::sqrt(-2.0f * std::log(1.0f - ToUniformFloat(r[i])));
+        float theta   = static_cast<float>(kTwoPi) * ToUniformFloat(r[i + 1]);
+        values[i]     = radius * std::cos(theta);
+        values[i + 1] = radius * std::sin(theta);
+      }
+      for (size_t i = begin; i < end; ++i) {
+        ptr[i] = mean + std * values[i - begin];
+      }
+    });
+  } else if (dtype == cinn_float64_t()) {
+    double* ptr = reinterpret_cast<double*>(output->memory);
+    PhiloxFill(seed, numel, 2, [&](const std::array<uint32_t, 4>& r, size_t begin, size_t end) {
+      double radius    = std::sqrt(-2.0 * std::log(1.0 - ToUniformDouble(r[0], r[1])));
+      double theta     = kTwoPi * ToUniformDouble(r[2], r[3]);
+      double values[2] = {radius * std::cos(theta), radius * std::sin(theta)};
+      for (size_t i = begin; i < end; ++i) {
+        ptr[i] = mean + std * values[i - begin];
+      }
+    });
+  } else {
+    LOG(FATAL) << "gaussian_random only support float32 and float64! Please check.";
+  }
+}
+
+void cinn_call_host_uniform_random(void* v_args, int num_args, float min, float max, int seed) {
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* output  = args[0].operator cinn_buffer_t*();
+  cinn_type_t dtype      = output->type;
+  size_t numel           = output->num_elements();
+  VLOG(4) << "cinn_call_host_uniform_random: output_size=" << numel << ", min=" << min << ", max=" << max
+          << ", seed=" << seed;
+
+  if (dtype == cinn_float32_t()) {
+    float* ptr = reinterpret_cast<float*>(output->memory);
+    PhiloxFill(seed, numel, 4, [&](const std::array<uint32_t, 4>& r, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        ptr[i] = min + (max - min) * ToUniformFloat(r[i - begin]);
+      }
+    });
+  } else if (dtype == cinn_float64_t()) {
+    double* ptr = reinterpret_cast<double*>(output->memory);
+    PhiloxFill(seed, numel, 2, [&](const std::array<uint32_t, 4>& r, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        ptr[i] = min + (static_cast<double>(max) - min) * ToUniformDouble(r[2 * (i - begin)], r[2 * (i - begin) + 1]);
+      }
+    });
+  } else {
+    LOG(FATAL) << "uniform_random only support float32 and float64! Please check.";
+  }
+}
+
+void cinn_call_host_randint(void* v_args, int num_args, int seed) {
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* output  = args[0].operator cinn_buffer_t*();
+  cinn_type_t dtype      = output->type;
+  size_t numel           = output->num_elements();
+  VLOG(4) << "cinn_call_host_randint: output_size=" << numel << ", seed=" << seed;
+
+  if (dtype == cinn_int32_t()) {
+    // the values are non-negative so that the remainder of a range is in the range
+    int* ptr = reinterpret_cast<int*>(output->memory);
+    PhiloxFill(seed, numel, 4, [&](const std::array<uint32_t, 4>& r, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        ptr[i] = static_cast<int>(r[i - begin] >> 1);
+      }
+    });
+  } else {
+    LOG(FATAL) << "randint only support int32! Please check.";
+  }
+}
+
+CINN_REGISTER_HELPER(host_custom_call) {
+  using cinn::backends::FunctionProto;
+  auto host_target = cinn::common::DefaultHostTarget();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_host_gemm, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<bool>()   // trans_a
+      .AddInputType<bool>()   // trans_b
+      .AddInputType<bool>()   // trans_o
+      .AddInputType<float>()  // alpha
+      .AddInputType<float>()  // beta
+      .AddInputType<int>()    // a1
+      .AddInputType<int>()    // a2
+      .AddInputType<int>()    // a3
+      .AddInputType<int>()    // a4
+      .AddInputType<int>()    // b1
+      .AddInputType<int>()    // b2
+      .AddInputType<int>()    // b3
+      .AddInputType<int>()    // b4
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_host_memset, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()   // v_args
+      .AddInputType<int>()     // num_args
+      .AddInputType<int>()     // value
+      .AddInputType<size_t>()  // count
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_host_memcpy, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()   // v_args
+      .AddInputType<int>()     // num_args
+      .AddInputType<size_t>()  // count
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_host_gaussian_random, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<float>()  // mean
+      .AddInputType<float>()  // std
+      .AddInputType<int>()    // seed
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_host_uniform_random, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<float>()  // min
+      .AddInputType<float>()  // max
+      .AddInputType<int>()    // seed
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_host_randint, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // seed
+      .End();
+
+  return true;
+}
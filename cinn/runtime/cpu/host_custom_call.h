@@ -0,0 +1,103 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+/**
+ * \file This file implements the functions called by custom_call on host, they are the counterparts of the ones
+ * implemented by cuBLAS, cuRAND and the CUDA runtime on NVGPU and take the same arguments except the stream.
+ */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+/**
+ * \brief Compute out = alpha * op(A) * op(B) + beta * out, where A's shape is [a1, a2, a3, a4] and B's shape is
+ * [b1, b2, b3, b4], the batch dimensions are broadcast and the out is transposed if trans_o.
+ */
+void cinn_call_host_gemm(void* v_args,
+                         int num_args,
+                         bool trans_a,
+                         bool trans_b,
+                         bool trans_o,
+                         float alpha,
+                         float beta,
+                         int a1,
+                         int a2,
+                         int a3,
+                         int a4,
+                         int b1,
+                         int b2,
+                         int b3,
+                         int b4);
+
+void cinn_call_host_memset(void* v_args, int num_args, int value, size_t count);
+
+void cinn_call_host_memcpy(void* v_args, int num_args, size_t count);
+
+void cinn_call_host_gaussian_random(void* v_args, int num_args, float mean, float std, int seed);
+
+void cinn_call_host_uniform_random(void* v_args, int num_args, float min, float max, int seed);
+
+void cinn_call_host_randint(void* v_args, int num_args, int seed);
+}  // extern "C"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+/**
+ * The Philox4x32-10 counter-based generator of Random123, it maps a 128-bit counter to 4 random uint32 under a
+ * 64-bit key. The results of different counters are independent, so a buffer can be filled in any order.
+ */
+class Philox4x32 {
+ public:
+  explicit Philox4x32(uint64_t seed) : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {}
+
+  std::array<uint32_t, 4> operator()(const std::array<uint32_t, 4>& counter) const {
+    std::array<uint32_t, 4> ctr = counter;
+    std::array<uint32_t, 2> key = key_;
+    for (int round = 0; round < 10; ++round) {
+      uint64_t prod0 = static_cast<uint64_t>(kMul0) * ctr[0];
+      uint64_t prod1 = static_cast<uint64_t>(kMul1) * ctr[2];
+      ctr            = {static_cast<uint32_t>(prod1 >> 32) ^ ctr[1] ^ key[0],
+             static_cast<uint32_t>(prod1),
+             static_cast<uint32_t>(prod0 >> 32) ^ ctr[3] ^ key[1],
+             static_cast<uint32_t>(prod0)};
+      key[0] += kWeyl0;
+      key[1] += kWeyl1;
+    }
+    return ctr;
+  }
+
+  // Return the random numbers of the index-th counter
+  std::array<uint32_t, 4> operator()(uint64_t index) const {
+    return (*this)({static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), 0, 0});
+  }
+
+ private:
+  static constexpr uint32_t kMul0  = 0xD2511F53;
+  static constexpr uint32_t kMul1  = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+  std::array<uint32_t, 2> key_;
+};
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
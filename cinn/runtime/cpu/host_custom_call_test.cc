@@ -0,0 +1,174 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_custom_call.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+#include "cinn/runtime/flags.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+TEST(Philox4x32, KnownAnswer) {
+  // the known answer tests of Random123
+  using Counter = std::array<uint32_t, 4>;
+  Counter expected0{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+  ASSERT_EQ(Philox4x32(0)(Counter{0, 0, 0, 0}), expected0);
+  Counter expected1{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+  ASSERT_EQ(Philox4x32(0xffffffffffffffffull)(Counter{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}), expected1);
+  Counter expected2{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+  ASSERT_EQ(Philox4x32(0x299f31d0a4093822ull)(Counter{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}), expected2);
+}
+
+TEST(cinn_call_host_gemm, basic) {
+  // A: [2, 3, M, K] broadcast with B: [1, 3, K, N]
+  int M = 37, N = 300, K = 150;
+  for (bool trans_a : {false, true}) {
+    for (bool trans_b : {false, true}) {
+      for (bool trans_o : {false, true}) {
+        auto* A   = common::BufferBuilder(Float(32), {2, 3, trans_a ? K : M, trans_a ? M : K}).set_random().Build();
+        auto* B   = common::BufferBuilder(Float(32), {1, 3, trans_b ? N : K, trans_b ? K : N}).set_random().Build();
+        auto* out = common::BufferBuilder(Float(32), {2, 3, M, N}).set_val(1.0f).Build();
+        auto args = common::ArgsBuilder().Add(A).Add(B).Add(out).Build();
+        cinn_call_host_gemm(args.data(),
+                            args.size(),
+                            trans_a,
+                            trans_b,
+                            trans_o,
+                            0.5f,
+                            2.0f,
+                            2,
+                            3,
+                            trans_a ? K : M,
+                            trans_a ? M : K,
+                            1,
+                            3,
+                            trans_b ? N : K,
+                            trans_b ? K : N);
+
+        auto* A_data   = reinterpret_cast<float*>(A->memory);
+        auto* B_data   = reinterpret_cast<float*>(B->memory);
+        auto* out_data = reinterpret_cast<float*>(out->memory);
+        for (int i = 0; i < 2 * 3; ++i) {
+          const float* a = A_data + i * M * K;
+          const float* b = B_data + (i % 3) * K * N;
+          for (int m = 0; m < M; ++m) {
+            for (int n = 0; n < N; ++n) {
+              float expected = 0.0f;
+              for (int k = 0; k < K; ++k) {
+                expected += (trans_a ? a[k * M + m] : a[m * K + k]) * (trans_b ? b[n * K + k] : b[k * N + n]);
+              }
+              expected  = 0.5f * expected + 2.0f;
+              float got = out_data[i * M * N + (trans_o ? n * M + m : m * N + n)];
+              ASSERT_NEAR(got, expected, 1e-3 * std::abs(expected) + 1e-3);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(cinn_call_host_memcpy, basic) {
+  auto* x   = common::BufferBuilder(Float(32), {3, 5}).set_random().Build();
+  auto* out = common::BufferBuilder(Float(32), {15}).set_random().Build();
+  auto args = common::ArgsBuilder().Add(x).Add(out).Build();
+  cinn_call_host_memcpy(args.data(), args.size(), 15 * sizeof(float));
+  ASSERT_EQ(std::memcmp(x->memory, out->memory, 15 * sizeof(float)), 0);
+
+  auto memset_args = common::ArgsBuilder().Add(out).Build();
+  cinn_call_host_memset(memset_args.data(), memset_args.size(), 0, 15 * sizeof(float));
+  for (int i = 0; i < 15; ++i) {
+    ASSERT_EQ(reinterpret_cast<float*>(out->memory)[i], 0.0f);
+  }
+}
+
+TEST(cinn_call_host_random, basic) {
+  int numel  = 100003;
+  auto* out  = common::BufferBuilder(Float(32), {numel}).set_zero().Build();
+  auto* out1 = common::BufferBuilder(Float(32), {numel}).set_zero().Build();
+  auto args  = common::ArgsBuilder().Add(out).Build();
+  auto args1 = common::ArgsBuilder().Add(out1).Build();
+  auto* data = reinterpret_cast<float*>(out->memory);
+
+  cinn_call_host_gaussian_random(args.data(), args.size(), 1.0f, 2.0f, 7);
+  double sum = 0.0, square_sum = 0.0;
+  for (int i = 0; i < numel; ++i) {
+    sum += data[i];
+    square_sum += data[i] * data[i];
+  }
+  double mean = sum / numel;
+  EXPECT_NEAR(mean, 1.0, 0.05);
+  EXPECT_NEAR(std::sqrt(square_sum / numel - mean * mean), 2.0, 0.05);
+  // the same seed generates the same numbers
+  cinn_call_host_gaussian_random(args1.data(), args1.size(), 1.0f, 2.0f, 7);
+  ASSERT_EQ(std::memcmp(out->memory, out1->memory, numel * sizeof(float)), 0);
+
+  cinn_call_host_uniform_random(args.data(), args.size(), -3.0f, 5.0f, 7);
+  sum = 0.0;
+  for (int i = 0; i < numel; ++i) {
+    ASSERT_GE(data[i], -3.0f);
+    ASSERT_LT(data[i], 5.0f);
+    sum += data[i];
+  }
+  EXPECT_NEAR(sum / numel, 1.0, 0.05);
+
+  auto* int_out    = common::BufferBuilder(Int(32), {numel}).set_zero().Build();
+  auto int_args    = common::ArgsBuilder().Add(int_out).Build();
+  auto* int_data   = reinterpret_cast<int*>(int_out->memory);
+  int num_distinct = 0;
+  cinn_call_host_randint(int_args.data(), int_args.size(), 7);
+  for (int i = 0; i < numel; ++i) {
+    ASSERT_GE(int_data[i], 0);
+    num_distinct += i == 0 || int_data[i] != int_data[i - 1];
+  }
+  EXPECT_GT(num_distinct, numel - 10);
+}
+
+TEST(cinn_call_host_random, seed) {
+  int numel  = 1001;
+  auto* out  = common::BufferBuilder(Float(32), {numel}).set_zero().Build();
+  auto* out1 = common::BufferBuilder(Float(32), {numel}).set_zero().Build();
+  auto args  = common::ArgsBuilder().Add(out).Build();
+  auto args1 = common::ArgsBuilder().Add(out1).Build();
+
+  // seed 0 continues the random numbers of the previous call, so every execution differs
+  for (unsigned long long global_seed : {0ULL, 123ULL}) {
+    RandomSeed::GetOrSet(global_seed);
+    cinn_call_host_uniform_random(args.data(), args.size(), 0.0f, 1.0f, 0);
+    cinn_call_host_uniform_random(args1.data(), args1.size(), 0.0f, 1.0f, 0);
+    ASSERT_NE(std::memcmp(out->memory, out1->memory, numel * sizeof(float)), 0);
+    cinn_call_host_gaussian_random(args.data(), args.size(), 0.0f, 1.0f, 0);
+    cinn_call_host_gaussian_random(args1.data(), args1.size(), 0.0f, 1.0f, 0);
+    ASSERT_NE(std::memcmp(out->memory, out1->memory, numel * sizeof(float)), 0);
+  }
+  RandomSeed::Clear();
+
+  // a nonzero seed reproduces the same numbers, even after the calls with seed 0
+  cinn_call_host_uniform_random(args.data(), args.size(), 0.0f, 1.0f, 7);
+  cinn_call_host_uniform_random(args1.data(), args1.size(), 0.0f, 1.0f, 0);
+  cinn_call_host_uniform_random(args1.data(), args1.size(), 0.0f, 1.0f, 7);
+  ASSERT_EQ(std::memcmp(out->memory, out1->memory, numel * sizeof(float)), 0);
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,364 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_gemm.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+namespace {
+
+// The vectors of a row of the micro-kernel, a tile is MR x (kGemmVectorsPerRow * lanes)
+constexpr int kGemmVectorsPerRow = 2;
+// The rows of the micro-kernels, kGemmVectorsPerRow * MR accumulators and the vectors of a row of B take 15 of
+// the 16 registers of AVX and 27 of the 32 registers of AVX-512
+constexpr int kGemmAvxMR    = 6;
+constexpr int kGemmAvx512MR = 12;
+
+template <typename T>
+using MicroKernelFn =
+    void (*)(int kc, const T* a, const T* b, T alpha, T beta, T* c, int64_t rs_c, int64_t cs_c, int m, int n);
+
+/**
+ * Compute the kMR x NR tile of C = alpha * A * B + beta * C in registers, where a is a micro-panel of A packed as
+ * [kc, kMR] and b is a micro-panel of B packed as [kc, NR]. Only the top-left m x n of the tile is written back.
+ */
+template <typename T, int kMR, int kLanes>
+inline __attribute__((always_inline)) void MicroKernel(
+    int kc, const T* a, const T* b, T alpha, T beta, T* c, int64_t rs_c, int64_t cs_c, int m, int n) {
+  typedef T Vec __attribute__((vector_size(kLanes * sizeof(T))));
+  constexpr int kNR = kGemmVectorsPerRow * kLanes;
+
+  // the loops over the tile are unrolled to keep the accumulators in registers
+  Vec acc[kMR][kGemmVectorsPerRow];
+#pragma GCC unroll 16
+  for (int i = 0; i < kMR; ++i) {
+#pragma GCC unroll 4
+    for (int j = 0; j < kGemmVectorsPerRow; ++j) {
+      acc[i][j] = Vec{};
+    }
+  }
+  for (int p = 0; p < kc; ++p, a += kMR, b += kNR) {
+    Vec b_vec[kGemmVectorsPerRow];
+#pragma GCC unroll 4
+    for (int j = 0; j < kGemmVectorsPerRow; ++j) {
+      std::memcpy(&b_vec[j], b + j * kLanes, sizeof(Vec));
+    }
+#pragma GCC unroll 16
+    for (int i = 0; i < kMR; ++i) {
+      T a_val = a[i];
+#pragma GCC unroll 4
+      for (int j = 0; j < kGemmVectorsPerRow; ++j) {
+        acc[i][j] += a_val * b_vec[j];
+      }
+    }
+  }
+
+  if (m == kMR && n == kNR && cs_c == 1) {
+#pragma GCC unroll 16
+    for (int i = 0; i < kMR; ++i) {
+      T* c_row = c + i * rs_c;
+#pragma GCC unroll 4
+      for (int j = 0; j < kGemmVectorsPerRow; ++j) {
+        Vec res = alpha * acc[i][j];
+        if (beta != T(0)) {
+          Vec c_vec;
+          std::memcpy(&c_vec, c_row + j * kLanes, sizeof(Vec));
+          res += beta * c_vec;
+        }
+        std::memcpy(c_row + j * kLanes, &res, sizeof(Vec));
+      }
+    }
+    return;
+  }
+  T tile[kMR][kNR];
+  std::memcpy(tile, acc, sizeof(tile));
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      T& dst = c[i * rs_c + j * cs_c];
+      dst    = beta == T(0) ? alpha * tile[i][j] : alpha * tile[i][j] + beta * dst;
+    }
+  }
+}
+
+template <typename T>
+void MicroKernelAvx(int kc, const T* a, const T* b, T alpha, T beta, T* c, int64_t rs_c, int64_t cs_c, int m, int n) {
+  MicroKernel<T, kGemmAvxMR, 32 / sizeof(T)>(kc, a, b, alpha, beta, c, rs_c, cs_c, m, n);
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+template <typename T>
+__attribute__((target("avx512f"))) void MicroKernelAvx512(
+    int kc, const T* a, const T* b, T alpha, T beta, T* c, int64_t rs_c, int64_t cs_c, int m, int n) {
+  MicroKernel<T, kGemmAvx512MR, 64 / sizeof(T)>(kc, a, b, alpha, beta, c, rs_c, cs_c, m, n);
+}
+#endif
+
+int RoundDown(int x, int factor, int lower, int upper) { return std::min(std::max(x / factor * factor, lower), upper); }
+
+// Resize the buffer to hold size elements and return its data aligned to 64 bytes
+template <typename T>
+T* AlignedBuffer(std::vector<T>* buffer, size_t size) {
+  constexpr size_t kAlignment = 64;
+  buffer->resize(size + kAlignment / sizeof(T));
+  auto addr = reinterpret_cast<uintptr_t>(buffer->data());
+  return reinterpret_cast<T*>((addr + kAlignment - 1) / kAlignment * kAlignment);
+}
+
+/**
+ * Pack the rows x depth block of a matrix starting from src into the micro-panels of width w, each micro-panel is
+ * [depth, w] and the rows out of the block are padded with zeros. The element (i, p) of the block is
+ * src[i * rs + p * cs].
+ */
+template <typename T>
+void PackPanels(const T* src, int64_t rs, int64_t cs, int rows, int depth, int w, T* dst) {
+  for (int r0 = 0; r0 < rows; r0 += w, dst += depth * w) {
+    int rb = std::min(w, rows - r0);
+    for (int p = 0; p < depth; ++p) {
+      const T* src_p = src + r0 * rs + p * cs;
+      T* dst_p       = dst + p * w;
+      for (int i = 0; i < rb; ++i) {
+        dst_p[i] = src_p[i * rs];
+      }
+      std::fill(dst_p + rb, dst_p + w, T(0));
+    }
+  }
+}
+
+// The work of multiplying a packed panel of B, the blocks of A are split into the work items
+template <typename T>
+struct GemmPanelWork {
+  const GemmBlocking* blocking;
+  MicroKernelFn<T> kernel;
+  const T* A;
+  int64_t rs_a;
+  int64_t cs_a;
+  const T* packed_b;
+  T alpha;
+  T beta;
+  T* C;
+  int64_t rs_c;
+  int64_t cs_c;
+  // the extents of the panel
+  int M;
+  int nc;
+  int kc;
+  // each work item computes a block of A with a chunk of the columns of the panel
+  int num_n_chunks;
+  int n_chunk;
+  int num_items;
+
+  void Run(int item) const {
+    int m0 = item / num_n_chunks * blocking->mc;
+    int mb = std::min(blocking->mc, M - m0);
+    int n0 = item % num_n_chunks * n_chunk;
+    int n1 = std::min(nc, n0 + n_chunk);
+    int mr = blocking->mr;
+    int nr = blocking->nr;
+    thread_local std::vector<T> packed_a_buffer;
+    T* packed_a = AlignedBuffer(&packed_a_buffer, static_cast<size_t>(blocking->mc) * kc);
+    PackPanels(A + m0 * rs_a, rs_a, cs_a, mb, kc, mr, packed_a);
+    for (int jr = n0; jr < n1; jr += nr) {
+      const T* b = packed_b + static_cast<int64_t>(jr / nr) * kc * nr;
+      for (int ir = 0; ir < mb; ir += mr) {
+        kernel(kc,
+               packed_a + static_cast<int64_t>(ir / mr) * kc * mr,
+               b,
+               alpha,
+               beta,
+               C + (m0 + ir) * rs_c + jr * cs_c,
+               rs_c,
+               cs_c,
+               std::min(mr, mb - ir),
+               std::min(nr, n1 - jr));
+      }
+    }
+  }
+};
+
+template <typename T>
+int GemmPanelLambda(int task_id, int num_task, void* datas) {
+  const auto* work = static_cast<const GemmPanelWork<T>*>(datas);
+  for (int item = task_id; item < work->num_items; item += num_task) {
+    work->Run(item);
+  }
+  return 0;
+}
+
+template <typename T>
+MicroKernelFn<T> GetMicroKernel(const GemmBlocking& blocking) {
+#if defined(__x86_64__) || defined(_M_X64)
+  if (blocking.isa == "avx512f") {
+    return MicroKernelAvx512<T>;
+  }
+#endif
+  return MicroKernelAvx<T>;
+}
+
+}  // namespace
+
+template <typename T>
+GemmBlocking MakeGemmBlocking(const common::CpuInfo& cpu) {
+  GemmBlocking blocking;
+#if defined(__x86_64__) || defined(_M_X64)
+  bool avx512 = cpu.Has(common::CpuInfo::Feature::AVX512F);
+#else
+  bool avx512 = false;
+#endif
+  blocking.isa = avx512 ? "avx512f" : "avx";
+  blocking.mr  = avx512 ? kGemmAvx512MR : kGemmAvxMR;
+  blocking.nr  = kGemmVectorsPerRow * (avx512 ? 64 : 32) / static_cast<int>(sizeof(T));
+
+  // the caches of an unknown CPU are regarded as the common ones
+  int l1 = cpu.l1_cache_size > 0 ? cpu.l1_cache_size : 32 << 10;
+  int l2 = cpu.l2_cache_size > 0 ? cpu.l2_cache_size : 256 << 10;
+  int l3 = cpu.l3_cache_size > 0 ? cpu.l3_cache_size : 8 << 20;
+  // a micro-panel of B stays in half of L1 while the micro-panels of A stream through the other half
+  blocking.kc = RoundDown(l1 / 2 / (blocking.nr * sizeof(T)), 8, 64, 512);
+  // a block of A takes half of L2
+  blocking.mc = RoundDown(l2 / 2 / (blocking.kc * sizeof(T)), blocking.mr, blocking.mr, 40 * blocking.mr);
+  // a panel of B takes half of L3, which is shared by the cores
+  blocking.nc = RoundDown(l3 / 2 / (blocking.kc * sizeof(T)), blocking.nr, blocking.nr, 4096);
+  VLOG(3) << "The blocking of gemm with " << blocking.isa << ": mr=" << blocking.mr << ", nr=" << blocking.nr
+          << ", kc=" << blocking.kc << ", mc=" << blocking.mc << ", nc=" << blocking.nc;
+  return blocking;
+}
+
+template <typename T>
+const GemmBlocking& GetGemmBlocking() {
+  static const GemmBlocking blocking = MakeGemmBlocking<T>(common::DefaultHostTarget().cpu);
+  return blocking;
+}
+
+template <typename T>
+void PackedGemm(int M,
+                int N,
+                int K,
+                T alpha,
+                const T* A,
+                int64_t rs_a,
+                int64_t cs_a,
+                const T* B,
+                int64_t rs_b,
+                int64_t cs_b,
+                T beta,
+                T* C,
+                int64_t rs_c,
+                int64_t cs_c) {
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+  if (K <= 0 || alpha == T(0)) {
+    for (int i = 0; i < M; ++i) {
+      for (int j = 0; j < N; ++j) {
+        T& dst = C[i * rs_c + j * cs_c];
+        dst    = beta == T(0) ? T(0) : beta * dst;
+      }
+    }
+    return;
+  }
+
+  const GemmBlocking& blocking         = GetGemmBlocking<T>();
+  static const MicroKernelFn<T> kernel = GetMicroKernel<T>(blocking);
+  int num_m_blocks                     = (M + blocking.mc - 1) / blocking.mc;
+  int num_threads                      = max_concurrency();
+  thread_local std::vector<T> packed_b_buffer;
+
+  for (int jc = 0; jc < N; jc += blocking.nc) {
+    int nc = std::min(blocking.nc, N - jc);
+    // split the columns of the panel if there are not enough blocks of A to feed the threads
+    int num_nr_blocks = (nc + blocking.nr - 1) / blocking.nr;
+    int num_n_chunks  = std::min((num_threads + num_m_blocks - 1) / num_m_blocks, num_nr_blocks);
+    int n_chunk       = (num_nr_blocks + num_n_chunks - 1) / num_n_chunks * blocking.nr;
+    num_n_chunks      = (nc + n_chunk - 1) / n_chunk;
+    for (int pc = 0; pc < K; pc += blocking.kc) {
+      int kc      = std::min(blocking.kc, K - pc);
+      T* packed_b = AlignedBuffer(&packed_b_buffer, static_cast<size_t>(num_nr_blocks) * blocking.nr * kc);
+      PackPanels(B + pc * rs_b + jc * cs_b, cs_b, rs_b, nc, kc, blocking.nr, packed_b);
+
+      GemmPanelWork<T> work;
+      work.blocking     = &blocking;
+      work.kernel       = kernel;
+      work.A            = A + pc * cs_a;
+      work.rs_a         = rs_a;
+      work.cs_a         = cs_a;
+      work.packed_b     = packed_b;
+      work.alpha        = alpha;
+      // the panels after the first one accumulate to C
+      work.beta         = pc == 0 ? beta : T(1);
+      work.C            = C + jc * cs_c;
+      work.rs_c         = rs_c;
+      work.cs_c         = cs_c;
+      work.M            = M;
+      work.nc           = nc;
+      work.kc           = kc;
+      work.num_n_chunks = num_n_chunks;
+      work.n_chunk      = n_chunk;
+      work.num_items    = num_m_blocks * num_n_chunks;
+      int num_task      = std::min(work.num_items, num_threads);
+      if (num_task == 1) {
+        GemmPanelLambda<T>(0, 1, &work);
+      } else {
+        cinn_backend_parallel_launch(GemmPanelLambda<T>, &work, num_task);
+      }
+    }
+  }
+}
+
+template GemmBlocking MakeGemmBlocking<float>(const common::CpuInfo&);
+template GemmBlocking MakeGemmBlocking<double>(const common::CpuInfo&);
+template const GemmBlocking& GetGemmBlocking<float>();
+template const GemmBlocking& GetGemmBlocking<double>();
+template void PackedGemm<float>(int,
+                                int,
+                                int,
+                                float,
+                                const float*,
+                                int64_t,
+                                int64_t,
+                                const float*,
+                                int64_t,
+                                int64_t,
+                                float,
+                                float*,
+                                int64_t,
+                                int64_t);
+template void PackedGemm<double>(int,
+                                 int,
+                                 int,
+                                 double,
+                                 const double*,
+                                 int64_t,
+                                 int64_t,
+                                 const double*,
+                                 int64_t,
+                                 int64_t,
+                                 double,
+                                 double*,
+                                 int64_t,
+                                 int64_t);
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+/**
+ * \file This file implements the built-in gemm of the host used when MKL is absent. It follows the BLIS design:
+ * op(B) is packed into a KC x NC panel kept in L3 cache, op(A) into MC x KC blocks kept in L2 cache, and a
+ * register-blocked MR x NR micro-kernel streams the KC x NR micro-panels of B from L1 cache.
+ */
+#include <cstdint>
+#include <string>
+
+#include "cinn/common/cpu_info.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+//! The blocking factors of the gemm of a data type.
+struct GemmBlocking {
+  // the rows and the columns computed by a micro-kernel in registers
+  int mr;
+  int nr;
+  // the depth of a packed panel, a micro-panel of A and B fits in L1 cache
+  int kc;
+  // the rows of a packed block of A, fits in L2 cache
+  int mc;
+  // the columns of a packed panel of B, fits in L3 cache
+  int nc;
+  // the instruction set of the micro-kernel, avx512f or avx
+  std::string isa;
+};
+
+/**
+ * Return the blocking factors of the data type T derived from the vector width supported by the cpu and the sizes
+ * of its caches, the common sizes are taken for the caches unknown.
+ */
+template <typename T>
+GemmBlocking MakeGemmBlocking(const common::CpuInfo& cpu);
+
+/**
+ * Return the blocking factors of the data type T on the CPU of DefaultHostTarget(), which are made once at the
+ * first call.
+ */
+template <typename T>
+const GemmBlocking& GetGemmBlocking();
+
+/**
+ * \brief Compute C = alpha * op(A) * op(B) + beta * C, where op(A) is M x K and op(B) is K x N.
+ *
+ * The matrices are given by strides, the element (i, j) of op(A) is A[i * rs_a + j * cs_a], and the same for op(B)
+ * and C, so the transposes are expressed by swapping the strides. C is not read if beta is 0.
+ */
+template <typename T>
+void PackedGemm(int M,
+                int N,
+                int K,
+                T alpha,
+                const T* A,
+                int64_t rs_a,
+                int64_t cs_a,
+                const T* B,
+                int64_t rs_b,
+                int64_t cs_b,
+                T beta,
+                T* C,
+                int64_t rs_c,
+                int64_t cs_c);
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
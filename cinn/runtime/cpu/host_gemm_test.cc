@@ -0,0 +1,124 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_gemm.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "cinn/common/target.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+template <typename T>
+void TestPackedGemm(int M, int N, int K, bool trans_a, bool trans_b, bool trans_c, T alpha, T beta) {
+  std::mt19937 engine(M * N + K);
+  std::uniform_real_distribution<T> dist(-1, 1);
+  std::vector<T> A(M * K), B(K * N), C(M * N);
+  for (auto& v : A) {
+    v = dist(engine);
+  }
+  for (auto& v : B) {
+    v = dist(engine);
+  }
+  // C is not read if beta is 0
+  for (auto& v : C) {
+    v = beta == T(0) ? NAN : dist(engine);
+  }
+
+  int64_t rs_a = trans_a ? 1 : K, cs_a = trans_a ? M : 1;
+  int64_t rs_b = trans_b ? 1 : N, cs_b = trans_b ? K : 1;
+  int64_t rs_c = trans_c ? 1 : N, cs_c = trans_c ? M : 1;
+  std::vector<T> expected(M * N);
+  for (int i = 0; i < M; ++i) {
+    for (int j = 0; j < N; ++j) {
+      double sum = 0.0;
+      for (int k = 0; k < K; ++k) {
+        sum += static_cast<double>(A[i * rs_a + k * cs_a]) * B[k * rs_b + j * cs_b];
+      }
+      T c                           = C[i * rs_c + j * cs_c];
+      expected[i * rs_c + j * cs_c] = alpha * sum + (beta == T(0) ? T(0) : beta * c);
+    }
+  }
+
+  PackedGemm<T>(M, N, K, alpha, A.data(), rs_a, cs_a, B.data(), rs_b, cs_b, beta, C.data(), rs_c, cs_c);
+  for (int i = 0; i < M * N; ++i) {
+    ASSERT_NEAR(C[i], expected[i], 1e-4 * K) << "M=" << M << ", N=" << N << ", K=" << K << ", index " << i;
+  }
+}
+
+TEST(PackedGemm, blocking) {
+  using Feature = common::CpuInfo::Feature;
+  // the micro-kernel follows the vector width and the blocks follow the caches
+  common::CpuInfo avx512_cpu(
+      "skylake-avx512", {Feature::AVX, Feature::AVX2, Feature::FMA, Feature::AVX512F}, 32 << 10, 1 << 20, 16 << 20);
+  auto blocking = MakeGemmBlocking<float>(avx512_cpu);
+  ASSERT_EQ(blocking.isa, "avx512f");
+  ASSERT_EQ(blocking.mr, 12);
+  ASSERT_EQ(blocking.nr, 32);
+  ASSERT_EQ(blocking.kc, 128);
+  ASSERT_EQ(blocking.mc, 480);
+  ASSERT_EQ(blocking.nc, 4096);
+
+  // the unknown L3 is regarded as 8MB
+  common::CpuInfo avx2_cpu("haswell", {Feature::AVX, Feature::AVX2, Feature::FMA}, 64 << 10, 512 << 10);
+  blocking = MakeGemmBlocking<float>(avx2_cpu);
+  ASSERT_EQ(blocking.isa, "avx");
+  ASSERT_EQ(blocking.mr, 6);
+  ASSERT_EQ(blocking.nr, 16);
+  ASSERT_EQ(blocking.kc, 512);
+  ASSERT_EQ(blocking.mc, 126);
+  ASSERT_EQ(blocking.nc, 2048);
+
+  // the built-in gemm runs with the CPU of the host target
+  const auto& host = GetGemmBlocking<float>();
+  auto expected    = MakeGemmBlocking<float>(common::DefaultHostTarget().cpu);
+  ASSERT_EQ(host.isa, expected.isa);
+  ASSERT_EQ(host.kc, expected.kc);
+  ASSERT_EQ(host.mc, expected.mc);
+  ASSERT_EQ(host.nc, expected.nc);
+}
+
+TEST(PackedGemm, float32) {
+  const auto& blocking = GetGemmBlocking<float>();
+  ASSERT_EQ(blocking.kc % 8, 0);
+  ASSERT_EQ(blocking.mc % blocking.mr, 0);
+  ASSERT_EQ(blocking.nc % blocking.nr, 0);
+  // the shapes cover the tails of the micro-kernel and the blocks
+  std::vector<std::vector<int>> shapes = {
+      {1, 1, 1}, {7, 33, 5}, {37, 300, 150}, {130, 70, blocking.kc + 3}, {blocking.mc + 5, 129, 257}};
+  for (const auto& shape : shapes) {
+    for (int trans = 0; trans < 8; ++trans) {
+      TestPackedGemm<float>(
+          shape[0], shape[1], shape[2], trans & 1, trans & 2, trans & 4, 0.5f, trans % 3 ? 2.0f : 0.0f);
+    }
+  }
+}
+
+TEST(PackedGemm, float64) {
+  for (int trans = 0; trans < 8; ++trans) {
+    TestPackedGemm<double>(45, 67, 300, trans & 1, trans & 2, trans & 4, 1.0, trans % 3 ? -1.0 : 0.0);
+  }
+  // K = 0 only scales C
+  TestPackedGemm<double>(3, 4, 0, false, false, false, 1.0, 2.0);
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
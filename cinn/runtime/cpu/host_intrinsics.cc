@@ -17,6 +17,10 @@
 #include <glog/logging.h>
 #include <math.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "cinn/backends/extern_func_jit_register.h"
 #include "cinn/backends/function_prototype.h"
 #include "cinn/common/target.h"
@@ -26,6 +30,153 @@
 #include "cinn/runtime/cpu/mkl_math.h"
 #endif
 
+namespace {
+
+// NaN is ordered after all the other values so that the comparison is a strict weak ordering.
+template <typename T>
+inline bool HostSortLess(T a, T b) {
+  return a < b;
+}
+
+template <>
+inline bool HostSortLess(float a, float b) {
+  return isnan(b) ? !isnan(a) : a < b;
+}
+
+template <>
+inline bool HostSortLess(double a, double b) {
+  return isnan(b) ? !isnan(a) : a < b;
+}
+
+/**
+ * Sort every slice along the axis of a buffer viewed as [outer, axis_size, inner], and call fn(outer_id, inner_id,
+ * items) with the first num_items (value, index) pairs of the slice in order. Equal values are ordered by their
+ * indices, so that the result is stable. If num_items is less than axis_size, the first num_items items are kept
+ * in a heap in one pass over the slice, that makes top-k O(n * log(k)) for a slice of n elements.
+ */
+template <typename T, typename Fn>
+void HostSortSlices(
+    const cinn_buffer_t* x, int outer, int axis_size, int inner, int num_items, bool is_ascend, const Fn& fn) {
+  CHECK_GT(num_items, 0);
+  CHECK_LE(num_items, axis_size);
+  using Item = std::pair<T, int>;
+  auto less  = [](const Item& a, const Item& b) {
+    return HostSortLess(a.first, b.first) || (!HostSortLess(b.first, a.first) && a.second < b.second);
+  };
+  auto greater = [](const Item& a, const Item& b) {
+    return HostSortLess(b.first, a.first) || (!HostSortLess(a.first, b.first) && a.second < b.second);
+  };
+  auto sort_slice = [&](const T* slice, std::vector<Item>* items, const auto& before) {
+    items->clear();
+    if (num_items == axis_size) {
+      for (int k = 0; k < axis_size; ++k) {
+        items->emplace_back(slice[static_cast<int64_t>(k) * inner], k);
+      }
+      std::sort(items->begin(), items->end(), before);
+      return;
+    }
+    // the top of the heap is the last one of the items selected so far
+    for (int k = 0; k < axis_size; ++k) {
+      Item item(slice[static_cast<int64_t>(k) * inner], k);
+      if (static_cast<int>(items->size()) < num_items) {
+        items->push_back(item);
+        std::push_heap(items->begin(), items->end(), before);
+      } else if (before(item, items->front())) {
+        std::pop_heap(items->begin(), items->end(), before);
+        items->back() = item;
+        std::push_heap(items->begin(), items->end(), before);
+      }
+    }
+    std::sort_heap(items->begin(), items->end(), before);
+  };
+  const T* data = reinterpret_cast<const T*>(x->memory);
+  std::vector<Item> items;
+  items.reserve(axis_size);
+  for (int i = 0; i < outer; ++i) {
+    for (int j = 0; j < inner; ++j) {
+      const T* slice = data + static_cast<int64_t>(i) * axis_size * inner + j;
+      if (is_ascend) {
+        sort_slice(slice, &items, less);
+      } else {
+        sort_slice(slice, &items, greater);
+      }
+      fn(i, j, items);
+    }
+  }
+}
+
+template <typename T>
+void HostSort(cinn_buffer_t* x, cinn_buffer_t* out, int outer, int axis_size, int inner, bool is_ascend) {
+  T* out_data = reinterpret_cast<T*>(out->memory);
+  HostSortSlices<T>(
+      x, outer, axis_size, inner, axis_size, is_ascend, [&](int i, int j, const std::vector<std::pair<T, int>>& items) {
+        T* slice = out_data + static_cast<int64_t>(i) * axis_size * inner + j;
+        for (int k = 0; k < axis_size; ++k) {
+          slice[static_cast<int64_t>(k) * inner] = items[k].first;
+        }
+      });
+}
+
+template <typename T>
+void HostArgSort(cinn_buffer_t* x,
+                 cinn_buffer_t* indices,
+                 cinn_buffer_t* ranks,
+                 int outer,
+                 int axis_size,
+                 int inner,
+                 bool is_ascend) {
+  int* indices_data = reinterpret_cast<int*>(indices->memory);
+  int* ranks_data   = ranks ? reinterpret_cast<int*>(ranks->memory) : nullptr;
+  HostSortSlices<T>(
+      x, outer, axis_size, inner, axis_size, is_ascend, [&](int i, int j, const std::vector<std::pair<T, int>>& items) {
+        int64_t offset = static_cast<int64_t>(i) * axis_size * inner + j;
+        for (int k = 0; k < axis_size; ++k) {
+          indices_data[offset + static_cast<int64_t>(k) * inner] = items[k].second;
+          if (ranks_data) {
+            ranks_data[offset + static_cast<int64_t>(items[k].second) * inner] = k;
+          }
+        }
+      });
+}
+
+template <typename T>
+void HostTopK(cinn_buffer_t* x,
+              cinn_buffer_t* values,
+              cinn_buffer_t* indices,
+              int outer,
+              int axis_size,
+              int inner,
+              int k,
+              bool largest) {
+  T* values_data        = reinterpret_cast<T*>(values->memory);
+  int64_t* indices_data = reinterpret_cast<int64_t*>(indices->memory);
+  HostSortSlices<T>(
+      x, outer, axis_size, inner, k, !largest, [&](int i, int j, const std::vector<std::pair<T, int>>& items) {
+        int64_t offset = static_cast<int64_t>(i) * k * inner + j;
+        for (int l = 0; l < k; ++l) {
+          values_data[offset + static_cast<int64_t>(l) * inner]  = items[l].first;
+          indices_data[offset + static_cast<int64_t>(l) * inner] = items[l].second;
+        }
+      });
+}
+
+}  // namespace
+
+#define CINN_HOST_SORT_DISPATCH(FUNC, TYPE, ...)          \
+  do {                                                    \
+    if (TYPE == cinn_float32_t()) {                       \
+      FUNC<float>(__VA_ARGS__);                           \
+    } else if (TYPE == cinn_float64_t()) {                \
+      FUNC<double>(__VA_ARGS__);                          \
+    } else if (TYPE == cinn_int32_t()) {                  \
+      FUNC<int>(__VA_ARGS__);                             \
+    } else if (TYPE == cinn_int64_t()) {                  \
+      FUNC<int64_t>(__VA_ARGS__);                         \
+    } else {                                              \
+      LOG(FATAL) << #FUNC << " doesn't support the type"; \
+    }                                                     \
+  } while (0)
+
 extern "C" {
 
 void __cinn_host_tanh_v(const cinn_buffer_t* x, cinn_buffer_t* out) {
@@ -112,6 +263,35 @@ CINN_HOST_GT_NUM(int64, int64_t)
 
 #undef CINN_HOST_GT_NUM
 
+void cinn_host_sort(void* v_args, int num_args, int outer, int axis_size, int inner, bool is_ascend) {
+  CHECK_EQ(num_args, 2) << "cinn_host_sort takes 1 input and 1 output";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* out     = args[1].operator cinn_buffer_t*();
+  CINN_HOST_SORT_DISPATCH(HostSort, x->type, x, out, outer, axis_size, inner, is_ascend);
+}
+
+void cinn_host_argsort(void* v_args, int num_args, int outer, int axis_size, int inner, bool is_ascend) {
+  CHECK(num_args == 2 || num_args == 3) << "cinn_host_argsort takes 1 input and 1 or 2 outputs";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* indices = args[1].operator cinn_buffer_t*();
+  // the second output of argsort is the rank of each element
+  cinn_buffer_t* ranks = num_args == 3 ? args[2].operator cinn_buffer_t*() : nullptr;
+  CINN_HOST_SORT_DISPATCH(HostArgSort, x->type, x, indices, ranks, outer, axis_size, inner, is_ascend);
+}
+
+void cinn_host_top_k(void* v_args, int num_args, int outer, int axis_size, int inner, int k, bool largest) {
+  CHECK_EQ(num_args, 3) << "cinn_host_top_k takes 1 input and 2 outputs";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* values  = args[1].operator cinn_buffer_t*();
+  cinn_buffer_t* indices = args[2].operator cinn_buffer_t*();
+  CINN_HOST_SORT_DISPATCH(HostTopK, x->type, x, values, indices, outer, axis_size, inner, k, largest);
+}
+
+#undef CINN_HOST_SORT_DISPATCH
+
 int cinn_host_resize_bilinear(const cinn_buffer_t* buf,
                               const int c_size,
                               const int in_h,
@@ -406,6 +586,37 @@ CINN_REGISTER_HELPER(host_intrinsics) {
 
 #undef _REGISTER_CINN_HOST_GT_NUM
 
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_sort, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // outer
+      .AddInputType<int>()    // axis_size
+      .AddInputType<int>()    // inner
+      .AddInputType<bool>()   // is_ascend
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_argsort, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // outer
+      .AddInputType<int>()    // axis_size
+      .AddInputType<int>()    // inner
+      .AddInputType<bool>()   // is_ascend
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_top_k, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // outer
+      .AddInputType<int>()    // axis_size
+      .AddInputType<int>()    // inner
+      .AddInputType<int>()    // k
+      .AddInputType<bool>()   // largest
+      .End();
+
   REGISTER_EXTERN_FUNC_HELPER(cinn_host_resize_bilinear, host_target)
       .SetRetType<int>()
       .AddInputType<cinn_buffer_t*>()
@@ -55,6 +55,15 @@ CINN_HOST_GT_NUM(int64, int64_t)
 
 #undef CINN_HOST_GT_NUM
 
+//! sort extern functions called by custom_call, the input and outputs are viewed as [outer, axis_size, inner]
+//@{
+void cinn_host_sort(void* v_args, int num_args, int outer, int axis_size, int inner, bool is_ascend);
+
+void cinn_host_argsort(void* v_args, int num_args, int outer, int axis_size, int inner, bool is_ascend);
+
+void cinn_host_top_k(void* v_args, int num_args, int outer, int axis_size, int inner, int k, bool largest);
+//@}
+
 int cinn_host_resize_bilinear(const cinn_buffer_t* buf,
                               const int c_size,
                               const int in_h,
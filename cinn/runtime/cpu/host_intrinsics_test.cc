@@ -16,6 +16,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include "cinn/backends/compiler.h"
 #include "cinn/backends/llvm/execution_engine.h"
 #include "cinn/backends/llvm/simple_jit.h"
@@ -203,6 +207,58 @@ TEST(cinn_host_gt_num_fp32, basic) {
   }
 }
 
+TEST(cinn_host_argsort, basic) {
+  // sort along the first axis, whose elements are strided in the buffer
+  int M = 10, N = 20;
+  auto* x_buf       = common::BufferBuilder(Float(32), {M, N}).set_random().Build();
+  auto* sorted_buf  = common::BufferBuilder(Float(32), {M, N}).set_zero().Build();
+  auto* indices_buf = common::BufferBuilder(Int(32), {M, N}).set_zero().Build();
+  auto* ranks_buf   = common::BufferBuilder(Int(32), {M, N}).set_zero().Build();
+  auto sort_args    = common::ArgsBuilder().Add(x_buf).Add(sorted_buf).Build();
+  auto argsort_args = common::ArgsBuilder().Add(x_buf).Add(indices_buf).Add(ranks_buf).Build();
+  cinn_host_sort(sort_args.data(), sort_args.size(), 1, M, N, false);
+  cinn_host_argsort(argsort_args.data(), argsort_args.size(), 1, M, N, false);
+
+  auto* x_data       = reinterpret_cast<float*>(x_buf->memory);
+  auto* sorted_data  = reinterpret_cast<float*>(sorted_buf->memory);
+  auto* indices_data = reinterpret_cast<int*>(indices_buf->memory);
+  auto* ranks_data   = reinterpret_cast<int*>(ranks_buf->memory);
+  for (int j = 0; j < N; j++) {
+    std::vector<int> expected(M);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::stable_sort(
+        expected.begin(), expected.end(), [&](int a, int b) { return x_data[a * N + j] > x_data[b * N + j]; });
+    for (int i = 0; i < M; i++) {
+      ASSERT_EQ(indices_data[i * N + j], expected[i]);
+      ASSERT_EQ(ranks_data[expected[i] * N + j], i);
+      ASSERT_EQ(sorted_data[i * N + j], x_data[expected[i] * N + j]);
+    }
+  }
+}
+
+TEST(cinn_host_top_k, basic) {
+  int M = 4, N = 50000, K = 10;
+  auto* x_buf       = common::BufferBuilder(Float(32), {M, N}).set_random().Build();
+  auto* values_buf  = common::BufferBuilder(Float(32), {M, K}).set_zero().Build();
+  auto* indices_buf = common::BufferBuilder(Int(64), {M, K}).set_zero().Build();
+  auto args         = common::ArgsBuilder().Add(x_buf).Add(values_buf).Add(indices_buf).Build();
+  cinn_host_top_k(args.data(), args.size(), M, N, 1, K, true);
+
+  auto* x_data       = reinterpret_cast<float*>(x_buf->memory);
+  auto* values_data  = reinterpret_cast<float*>(values_buf->memory);
+  auto* indices_data = reinterpret_cast<int64_t*>(indices_buf->memory);
+  for (int i = 0; i < M; i++) {
+    std::vector<int> expected(N);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::stable_sort(
+        expected.begin(), expected.end(), [&](int a, int b) { return x_data[i * N + a] > x_data[i * N + b]; });
+    for (int k = 0; k < K; k++) {
+      ASSERT_EQ(indices_data[i * K + k], expected[k]);
+      ASSERT_EQ(values_data[i * K + k], x_data[i * N + expected[k]]);
+    }
+  }
+}
+
 }  // namespace cpu
 }  // namespace runtime
 }  // namespace cinn
@@ -14,6 +14,8 @@
 
 #include "cinn/runtime/cpu/thread_backend.h"
 
+#include <gflags/gflags.h>
+
 #include <algorithm>
 #include <vector>
 
@@ -24,38 +26,48 @@
 #include "cinn/backends/extern_func_jit_register.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/common/cas.h"
+#include "cinn/runtime/cpu/thread_pool.h"
 #include "cinn/runtime/intrinsic.h"
 
+DECLARE_string(cinn_host_parallel_backend);
+
 int max_concurrency() {
-  int max_concurrency = 1;
-  const char* val     = getenv("CINN_NUM_THREADS");
-  if (val == nullptr) {
-    val = getenv("OMP_NUM_THREADS");
-  }
-  if (val != nullptr) {
-    max_concurrency = atoi(val);
-  } else {
-    max_concurrency = std::thread::hardware_concurrency();
+  // the environment variables are read only once, since it is called on each parallel launch
+  static const int max_concurrency = []() {
+    int max_concurrency = 1;
+    const char* val     = getenv("CINN_NUM_THREADS");
+    if (val == nullptr) {
+      val = getenv("OMP_NUM_THREADS");
+    }
+    if (val != nullptr) {
+      max_concurrency = atoi(val);
+    } else {
+      max_concurrency = std::thread::hardware_concurrency();
 #if defined(_M_X64) || defined(__x86_64__)
-    max_concurrency /= 2;  // ignore hyper-threading
+      max_concurrency /= 2;  // ignore hyper-threading
 #endif
-  }
-  return std::max(max_concurrency, 1);
+    }
+    return std::max(max_concurrency, 1);
+  }();
+  return max_concurrency;
 }
 
 int cinn_backend_parallel_launch(FCINNParallelLambda flambda, void* datas, int num_task) {
   int num_workers = max_concurrency();
   if (num_task == 0) num_task = num_workers;
 #ifdef CINN_USE_OPENMP
-  omp_set_num_threads(num_task);
+  if (FLAGS_cinn_host_parallel_backend == "openmp") {
 #pragma omp parallel num_threads(num_task)
-  {
-    int thread_num = omp_get_thread_num();
-    (*flambda)(thread_num, num_task, datas);
+    {
+      int thread_num = omp_get_thread_num();
+      (*flambda)(thread_num, num_task, datas);
+    }
+    return 0;
   }
-#else
-  LOG(FATAL) << "CINN host parallel launch need OpenMP! Please check.";
 #endif  // CINN_USE_OPENMP
+  CHECK(FLAGS_cinn_host_parallel_backend == "openmp" || FLAGS_cinn_host_parallel_backend == "thread_pool")
+      << "Unknown host parallel backend " << FLAGS_cinn_host_parallel_backend;
+  cinn::runtime::cpu::ThreadPool::Global()->Launch(flambda, datas, num_task);
   return 0;
 }
 
@@ -0,0 +1,125 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/thread_backend.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cinn/runtime/cpu/thread_pool.h"
+#include "cinn/utils/timer.h"
+
+DECLARE_string(cinn_host_parallel_backend);
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+namespace {
+struct TaskCounter {
+  explicit TaskCounter(int num_task) : counts(num_task) {}
+  std::vector<std::atomic<int>> counts;
+};
+
+int CountTask(int task_id, int num_task, void* datas) {
+  auto* counter = static_cast<TaskCounter*>(datas);
+  counter->counts[task_id]++;
+  return 0;
+}
+
+void CheckEachTaskRunOnce(const TaskCounter& counter) {
+  for (int i = 0; i < counter.counts.size(); ++i) {
+    ASSERT_EQ(counter.counts[i].load(), 1) << "task " << i;
+  }
+}
+}  // namespace
+
+TEST(ThreadPool, EachTaskRunOnce) {
+  ThreadPool pool(4, false);
+  for (int num_task : {1, 2, 3, 4, 7, 64, 1000}) {
+    for (int repeat = 0; repeat < 100; ++repeat) {
+      TaskCounter counter(num_task);
+      pool.Launch(CountTask, &counter, num_task);
+      CheckEachTaskRunOnce(counter);
+    }
+  }
+}
+
+TEST(ThreadPool, ConcurrentAndNestedLaunch) {
+  ThreadPool pool(4, true);
+  // each task launches a nested job, which runs serially on the calling worker
+  auto nested_launch = [](int task_id, int num_task, void* datas) -> int {
+    auto* counters = static_cast<std::vector<TaskCounter>*>(datas);
+    ThreadPool::Global()->Launch(CountTask, &counters->at(task_id), counters->at(task_id).counts.size());
+    return 0;
+  };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int repeat = 0; repeat < 100; ++repeat) {
+        std::vector<TaskCounter> counters;
+        counters.reserve(8);
+        for (int i = 0; i < 8; ++i) {
+          counters.emplace_back(16);
+        }
+        pool.Launch(nested_launch, &counters, counters.size());
+        for (const auto& counter : counters) {
+          CheckEachTaskRunOnce(counter);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+int EmptyTask(int task_id, int num_task, void* datas) {
+  static_cast<int*>(datas)[task_id * 16] = task_id;
+  return 0;
+}
+
+TEST(ThreadBackend, LaunchLatencyBenchmark) {
+  const int repeat = 10000;
+  std::vector<int> datas(max_concurrency() * 16);
+  auto benchmark = [&](const std::string& backend) {
+    FLAGS_cinn_host_parallel_backend = backend;
+    for (int i = 0; i < 100; ++i) {
+      cinn_backend_parallel_launch(EmptyTask, datas.data(), 0);
+    }
+    utils::Timer timer;
+    timer.Start();
+    for (int i = 0; i < repeat; ++i) {
+      cinn_backend_parallel_launch(EmptyTask, datas.data(), 0);
+    }
+    LOG(INFO) << "Parallel launch with " << backend << " on " << max_concurrency()
+              << " threads, average latency: " << timer.Stop() * 1000 / repeat << " us";
+  };
+
+#ifdef CINN_USE_OPENMP
+  benchmark("openmp");
+#endif
+  benchmark("thread_pool");
+  FLAGS_cinn_host_parallel_backend = "openmp";
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,246 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/thread_pool.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "cinn/runtime/cpu/thread_backend.h"
+
+DECLARE_bool(cinn_thread_pool_bind_cpu);
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+namespace {
+// the number of checks an idle worker spins before parking
+constexpr int kSpinCount = 1 << 16;
+
+// whether the current thread is running the tasks of a launch
+thread_local bool tls_in_task = false;
+
+inline void CpuRelax() {
+#if defined(_M_X64) || defined(__x86_64__)
+  _mm_pause();
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// the pool shared by all the launches, created on the first launch
+std::atomic<ThreadPool*> global_pool{nullptr};
+
+#if defined(__linux__)
+// the workers of the parent don't exist in a forked child, so the child leaves the pool of the
+// parent untouched and creates a new one on its first launch. Only the forking thread runs here.
+void ResetGlobalPoolInChild() { global_pool.store(nullptr); }
+#endif
+
+inline uint64_t PackRange(uint32_t begin, uint32_t end) { return (static_cast<uint64_t>(begin) << 32) | end; }
+inline uint32_t RangeBegin(uint64_t range) { return static_cast<uint32_t>(range >> 32); }
+inline uint32_t RangeEnd(uint64_t range) { return static_cast<uint32_t>(range); }
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads, bool bind_cpu)
+    : num_threads_(std::max(num_threads, 1)), bind_cpu_(bind_cpu), ranges_(new TaskRange[std::max(num_threads, 1)]) {
+  // the calling thread works as the 0-th worker, so only `num_threads_ - 1` threads are launched
+  for (int worker_id = 1; worker_id < num_threads_; ++worker_id) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, worker_id);
+  }
+  VLOG(3) << "ThreadPool with " << num_threads_ << " threads, bind cpu: " << bind_cpu_;
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(park_mtx_);
+    stop_.store(true);
+    ++generation_;
+  }
+  park_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+ThreadPool* ThreadPool::Global() {
+#if defined(__linux__)
+  static const int fork_handler_registered = pthread_atfork(nullptr, nullptr, &ResetGlobalPoolInChild);
+  (void)fork_handler_registered;
+#endif
+  ThreadPool* pool = global_pool.load(std::memory_order_acquire);
+  if (pool != nullptr) {
+    return pool;
+  }
+  // the pool is never destroyed, since the one of a parent is still referenced by its forked children
+  auto* new_pool = new ThreadPool(max_concurrency(), FLAGS_cinn_thread_pool_bind_cpu);
+  if (global_pool.compare_exchange_strong(pool, new_pool, std::memory_order_acq_rel)) {
+    return new_pool;
+  }
+  delete new_pool;
+  return pool;
+}
+
+void ThreadPool::Launch(Lambda lambda, void* datas, int num_task) {
+  if (num_task <= 1 || num_threads_ == 1 || tls_in_task || !launch_mtx_.try_lock()) {
+    for (int task_id = 0; task_id < num_task; ++task_id) {
+      (*lambda)(task_id, num_task, datas);
+    }
+    return;
+  }
+  std::lock_guard<std::mutex> launch_lock(launch_mtx_, std::adopt_lock);
+
+  lambda_   = lambda;
+  datas_    = datas;
+  num_task_ = num_task;
+  num_finished_.store(0);
+  for (int worker_id = 0; worker_id < num_threads_; ++worker_id) {
+    uint32_t begin = static_cast<int64_t>(num_task) * worker_id / num_threads_;
+    uint32_t end   = static_cast<int64_t>(num_task) * (worker_id + 1) / num_threads_;
+    ranges_[worker_id].range.store(PackRange(begin, end));
+  }
+  uint64_t generation = generation_.load() + 1;
+  open_generation_.store(generation);
+  {
+    std::lock_guard<std::mutex> lock(park_mtx_);
+    generation_.store(generation);
+    if (num_parked_ > 0) {
+      park_cv_.notify_all();
+    }
+  }
+
+  RunTasks(0);
+  for (int spins = 0; num_finished_.load(std::memory_order_acquire) < num_task; ++spins) {
+    if (spins < kSpinCount) {
+      CpuRelax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  // close the job, and wait for the workers which have joined it to leave before it is modified by the next launch
+  open_generation_.store(0);
+  while (num_active_workers_.load() > 0) {
+    CpuRelax();
+  }
+}
+
+void ThreadPool::WorkerLoop(int worker_id) {
+  if (bind_cpu_) {
+    BindCpu(worker_id);
+  }
+  uint64_t seen = 0;
+  while (true) {
+    for (int spins = 0; generation_.load(std::memory_order_acquire) == seen && spins < kSpinCount; ++spins) {
+      CpuRelax();
+    }
+    if (generation_.load() == seen) {
+      std::unique_lock<std::mutex> lock(park_mtx_);
+      ++num_parked_;
+      park_cv_.wait(lock, [&]() { return stop_ || generation_.load() != seen; });
+      --num_parked_;
+    }
+    if (stop_.load()) return;
+    seen = generation_.load();
+    // join the job only if it is still open, the check after increasing num_active_workers_
+    // pairs with the closing in Launch, so a job is never run after it is closed
+    num_active_workers_.fetch_add(1);
+    if (open_generation_.load() == seen) {
+      RunTasks(worker_id);
+    }
+    num_active_workers_.fetch_sub(1);
+  }
+}
+
+void ThreadPool::RunTasks(int worker_id) {
+  tls_in_task = true;
+  int task_id = 0;
+  do {
+    while (PopTask(worker_id, &task_id)) {
+      (*lambda_)(task_id, num_task_, datas_);
+      num_finished_.fetch_add(1, std::memory_order_release);
+    }
+  } while (StealTasks(worker_id));
+  tls_in_task = false;
+}
+
+bool ThreadPool::PopTask(int worker_id, int* task_id) {
+  auto& range        = ranges_[worker_id].range;
+  uint64_t old_range = range.load();
+  while (RangeBegin(old_range) < RangeEnd(old_range)) {
+    if (range.compare_exchange_weak(old_range, PackRange(RangeBegin(old_range) + 1, RangeEnd(old_range)))) {
+      *task_id = RangeBegin(old_range);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::StealTasks(int worker_id) {
+  for (int offset = 1; offset < num_threads_; ++offset) {
+    auto& victim       = ranges_[(worker_id + offset) % num_threads_].range;
+    uint64_t old_range = victim.load();
+    while (RangeBegin(old_range) < RangeEnd(old_range)) {
+      uint32_t begin = RangeBegin(old_range), end = RangeEnd(old_range);
+      // steal the back half, and leave the front to the owner
+      uint32_t mid = end - (end - begin + 1) / 2;
+      if (victim.compare_exchange_weak(old_range, PackRange(begin, mid))) {
+        // a range is updated by thieves only when it is not empty, and the own range is empty now
+        ranges_[worker_id].range.store(PackRange(mid, end));
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ThreadPool::BindCpu(int worker_id) {
+#if defined(__linux__)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    LOG(WARNING) << "Failed to get the cpu affinity, worker " << worker_id << " is not bound";
+    return;
+  }
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      cpus.push_back(cpu);
+    }
+  }
+  if (cpus.empty()) return;
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpus[worker_id % cpus.size()], &cpuset);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+    LOG(WARNING) << "Failed to bind worker " << worker_id << " to cpu " << cpus[worker_id % cpus.size()];
+  }
+#else
+  LOG_FIRST_N(WARNING, 1) << "Binding the workers to cpus is only supported on Linux";
+#endif
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
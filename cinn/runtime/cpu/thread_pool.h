@@ -0,0 +1,101 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cinn/common/macros.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+/**
+ * ThreadPool is a persistent worker pool to run the host parallel lambdas without the fork/join cost of OpenMP.
+ *
+ * The calling thread works as the 0-th worker, and the tasks are divided into contiguous chunks, one per worker.
+ * A worker runs the tasks of its own chunk from the front, and steals the back half of another chunk once
+ * its own is exhausted. Idle workers spin for a while before parking, so the back-to-back launches of small
+ * kernels are picked up without waking the threads up.
+ */
+class ThreadPool {
+ public:
+  typedef int (*Lambda)(int task_id, int num_task, void* datas);
+
+  /**
+   * Constructor.
+   * @param num_threads The number of workers including the calling thread.
+   * @param bind_cpu Whether to pin each worker to a CPU.
+   */
+  ThreadPool(int num_threads, bool bind_cpu);
+  ~ThreadPool();
+
+  //! The pool shared by all the launches, sized by max_concurrency(). A forked child process creates its own.
+  static ThreadPool* Global();
+
+  //! Run \p lambda with task ids [0, num_task) and block until all of them finish. The launch runs serially on
+  //! the calling thread if it is issued inside a running task or while another thread is launching.
+  void Launch(Lambda lambda, void* datas, int num_task);
+
+  int num_threads() const { return num_threads_; }
+
+ private:
+  // the unfinished tasks [begin, end) of a worker packed in 64 bits, so that
+  // the owner and the thieves can update it with a single CAS
+  struct alignas(64) TaskRange {
+    std::atomic<uint64_t> range{0};
+  };
+
+  void WorkerLoop(int worker_id);
+  void RunTasks(int worker_id);
+  bool PopTask(int worker_id, int* task_id);
+  bool StealTasks(int worker_id);
+  void BindCpu(int worker_id);
+
+  const int num_threads_;
+  const bool bind_cpu_;
+  std::vector<std::thread> workers_;
+  std::unique_ptr<TaskRange[]> ranges_;
+
+  // the current job
+  Lambda lambda_{nullptr};
+  void* datas_{nullptr};
+  int num_task_{0};
+  alignas(64) std::atomic<int> num_finished_{0};
+  // bumped on each launch to wake the workers up
+  alignas(64) std::atomic<uint64_t> generation_{0};
+  // the generation of the job accepting workers, 0 if the job is closed
+  std::atomic<uint64_t> open_generation_{0};
+  // workers which have joined the current job
+  alignas(64) std::atomic<int> num_active_workers_{0};
+
+  std::mutex launch_mtx_;
+  std::mutex park_mtx_;
+  std::condition_variable park_cv_;
+  int num_parked_{0};
+  std::atomic<bool> stop_{false};
+
+  CINN_DISALLOW_COPY_AND_ASSIGN(ThreadPool);
+};
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -44,6 +44,44 @@ DEFINE_int32(cinn_parallel_compile_thread,
              Int32FromEnv("FLAGS_cinn_parallel_compile_thread", -1),
              "How much thread the parallel compile used.");
 
+DEFINE_int32(cinn_parallel_execute_threads,
+             Int32FromEnv("FLAGS_cinn_parallel_execute_threads", 1),
+             "How much thread used to run the independent instructions of a program concurrently on X86, "
+             "a value not greater than 1 means running them one by one in order.");
+
+DEFINE_string(cinn_jit_object_cache_dir,
+              StringFromEnv("FLAGS_cinn_jit_object_cache_dir", ""),
+              "Specify the directory to persist the JIT compiled objects, which can be reused across processes. "
+              "The cache is disabled if empty.");
+
+DEFINE_int64(cinn_jit_object_cache_max_size,
+             Int64FromEnv("FLAGS_cinn_jit_object_cache_max_size", 1024L),
+             "The maximum total size(MB) of the persistent JIT object cache, the least recently used objects "
+             "are evicted once exceeded, 0 means no limit.");
+
+DEFINE_string(cinn_compilation_cache_dir,
+              StringFromEnv("FLAGS_cinn_compilation_cache_dir", ""),
+              "Specify the directory to persist the compiled graphs, so compiling a graph identical to one compiled "
+              "before only loads and links the code. The cache is disabled if empty.");
+
+DEFINE_int32(cinn_compiled_group_cache_size,
+             Int32FromEnv("FLAGS_cinn_compiled_group_cache_size", 0),
+             "The max number of compiled fusion groups kept in memory, so a structurally identical group in a later "
+             "compilation reuses the jitted function without lowering and codegen. The cache is disabled if 0.");
+
+DEFINE_bool(cinn_x86_use_caching_allocator,
+            BoolFromEnv("FLAGS_cinn_x86_use_caching_allocator", false),
+            "Whether to cache the freed host memory for later allocations instead of returning it to the system.");
+
+DEFINE_string(cinn_host_parallel_backend,
+              StringFromEnv("FLAGS_cinn_host_parallel_backend", "openmp"),
+              "The backend to run the parallel loops of host kernels, openmp or thread_pool. The persistent "
+              "thread_pool is always used if CINN is built without OpenMP.");
+
+DEFINE_bool(cinn_thread_pool_bind_cpu,
+            BoolFromEnv("FLAGS_cinn_thread_pool_bind_cpu", false),
+            "Whether to bind each worker of the host thread pool to a cpu.");
+
 DEFINE_bool(cinn_use_op_fusion, BoolFromEnv("FLAGS_cinn_use_op_fusion", true), "Whether to use op fusion pass.");
 
 DEFINE_bool(cinn_use_common_subexpression_elimination,
@@ -71,6 +109,11 @@ DEFINE_bool(cinn_use_cuda_vectorize,
             BoolFromEnv("FLAGS_cinn_use_cuda_vectorize", false),
             "Whether use cuda vectroize on schedule config");
 
+DEFINE_string(cinn_x86_conv_params_file,
+              StringFromEnv("FLAGS_cinn_x86_conv_params_file", ""),
+              "The file of the x86 conv schedule params tuned by tune_x86_conv_params, which take precedence over the "
+              "built-in ones of the same conv shapes.");
+
 DEFINE_bool(cinn_ir_schedule,
             BoolFromEnv("FLAGS_cinn_ir_schedule", true),
             "Whether use reconstructed schedule primitives.");
@@ -112,6 +155,11 @@ DEFINE_string(cinn_pass_visualize_dir,
 
 DEFINE_bool(enable_auto_tuner, BoolFromEnv("FLAGS_enable_auto_tuner", false), "Whether enable auto tuner.");
 
+DEFINE_int32(auto_schedule_measure_runner_cpus,
+             Int32FromEnv("FLAGS_auto_schedule_measure_runner_cpus", 0),
+             "The number of cpus dedicated to the runner when measuring candidates in parallel, the builders run "
+             "on the other cpus. 0 means no cpu affinity is set.");
+
 DEFINE_bool(auto_schedule_use_cost_model,
             BoolFromEnv("FLAGS_auto_schedule_use_cost_model", true),
             "Whether to use cost model in auto schedule, this is an on-developing flag and it will be removed when "
@@ -9,4 +9,6 @@ set(WITH_CUDA ON)
 
 set(WITH_MKL_CBLAS ON)
 set(WITH_MKLDNN ON)
+# The OpenMP runtime used by the host parallel loops.
+# Possible values: gnu, intel, OFF(use the builtin thread pool of CINN)
 set(USE_OPENMP "intel")
@@ -0,0 +1,102 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/optimize.h"
+#include "cinn/hlir/framework/caching_allocator.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/memory.h"
+#include "cinn/utils/timer.h"
+
+namespace cinn {
+namespace tests {
+
+using hlir::framework::CachingAllocator;
+using hlir::framework::MemoryInterface;
+using hlir::framework::MemoryManager;
+using hlir::framework::Scope;
+
+// The buffer handler instructions allocate and free the buffers of variables by their callbacks, which are
+// bound to the MemoryInterface registered for the target, CachingAllocator on X86 if
+// FLAGS_cinn_x86_use_caching_allocator is set and the system allocator otherwise
+void SetBufferCallbacks(Scope* scope, MemoryInterface* allocator) {
+  for (auto& name : scope->var_names()) {
+    auto tensor   = scope->GetTensor(std::string(name));
+    auto* buffer  = tensor->buffer();
+    size_t nbytes = tensor->shape().numel() * tensor->type().bytes();
+    delete buffer->external_malloc;
+    delete buffer->external_free;
+    buffer->external_malloc = new std::function<int(void*, cinn_buffer_t*)>(
+        [allocator, nbytes](void* ctx, cinn_buffer_t* buf) -> int {
+          buf->memory      = static_cast<uint8_t*>(allocator->aligned_alloc(64, nbytes));
+          buf->memory_size = nbytes;
+          return 0;
+        });
+    buffer->external_free = new std::function<int(void*, cinn_buffer_t*)>([allocator](void* ctx, cinn_buffer_t* buf) {
+      allocator->free(buf->memory);
+      buf->memory = nullptr;
+      return 0;
+    });
+  }
+}
+
+TEST(CachingAllocator, ProgramExecute) {
+  frontend::NetBuilder builder("caching_allocator_benchmark");
+  frontend::Variable x = builder.CreateInput(Float(32), {64, 64}, "x");
+  for (int i = 0; i < 16; ++i) {
+    auto w = builder.CreateInput(Float(32), {64, 64}, "w_" + std::to_string(i));
+    x      = builder.Relu(builder.Matmul(x, w));
+  }
+  auto target  = common::DefaultHostTarget();
+  auto program = builder.Build();
+  auto graph   = frontend::Optimize(&program, {x->id}, target);
+  auto scope   = hlir::framework::BuildScope(target, graph);
+
+  hlir::framework::GraphCompiler gc(target, scope, graph);
+  hlir::framework::GraphCompiler::CompileOptions options;
+  options.with_buffer_handle_instruction_inserted = true;
+  auto runtime_program                            = gc.Build(options).runtime_program;
+
+  auto* allocator         = MemoryManager::Global().RetrieveSafely(target.arch);
+  auto* caching_allocator = dynamic_cast<CachingAllocator*>(allocator);
+  SetBufferCallbacks(scope.get(), allocator);
+  // warmup
+  runtime_program->Execute();
+
+  const int repeat = 1000;
+  utils::Timer timer;
+  timer.Start();
+  for (int i = 0; i < repeat; ++i) {
+    runtime_program->Execute();
+  }
+  LOG(INFO) << "Execute with the " << (caching_allocator ? "caching" : "system")
+            << " allocator registered for X86, average time: " << timer.Stop() / repeat << " ms";
+
+  if (caching_allocator) {
+    auto stats = caching_allocator->GetStats();
+    LOG(INFO) << "CachingAllocator: peak bytes " << stats.peak_allocated_bytes << ", cached bytes "
+              << stats.cached_bytes << ", cache hits " << stats.cache_hits << ", cache misses " << stats.cache_misses
+              << ", fragmentation " << stats.fragmentation();
+    ASSERT_GT(stats.cache_hits, stats.cache_misses);
+  }
+}
+
+}  // namespace tests
+}  // namespace cinn
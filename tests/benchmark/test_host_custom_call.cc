@@ -0,0 +1,159 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+#include "cinn/utils/timer.h"
+
+namespace cinn {
+namespace tests {
+
+using hlir::framework::Graph;
+using hlir::framework::GraphCompiler;
+using hlir::framework::Scope;
+
+/**
+ * Compile a program on host through the generated code or through the host custom calls, run it for repeat times
+ * after a warmup and return the output values and the average cost in ms.
+ */
+class HostCustomCallBenchmark {
+ public:
+  HostCustomCallBenchmark(const frontend::Program& program, const std::string& output, int repeat = 10)
+      : program_(program), output_(output), repeat_(repeat) {}
+
+  std::vector<float> Run(bool use_custom_call, double* cost) {
+    auto target = common::DefaultHostTarget();
+    auto graph  = std::make_shared<Graph>(program_, std::unordered_set<std::string>{output_}, target);
+    if (use_custom_call) {
+      hlir::framework::ApplyPasses(
+          graph.get(), {"TransToCustomCallPass", "OpFusionPass", "FusionMergePass", "SingleGroupOptimizePass"});
+    } else {
+      hlir::framework::ApplyPasses(graph.get(), {"OpFusionPass", "FusionMergePass"});
+    }
+    auto scope = hlir::framework::BuildScope(target, graph);
+    GraphCompiler gc(target, scope, graph);
+    auto runtime_program = gc.Build();
+
+    std::mt19937 engine(0);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (const auto& var : program_.GetInputs()) {
+      auto tensor = scope->GetTensor(var->id);
+      auto* data  = tensor->mutable_data<float>(target);
+      for (int i = 0; i < tensor->shape().numel(); ++i) {
+        data[i] = dist(engine);
+      }
+    }
+
+    runtime_program->Execute();
+    utils::Timer timer;
+    timer.Start();
+    for (int i = 0; i < repeat_; ++i) {
+      runtime_program->Execute();
+    }
+    *cost = timer.Stop() / repeat_;
+
+    auto out    = scope->GetTensor(output_);
+    auto* begin = out->data<float>();
+    return std::vector<float>(begin, begin + out->shape().numel());
+  }
+
+  // Return the outputs of both paths and log their costs
+  std::pair<std::vector<float>, std::vector<float>> Compare(const std::string& name) {
+    double generated_cost = 0.0, custom_call_cost = 0.0;
+    auto generated_out   = Run(false, &generated_cost);
+    auto custom_call_out = Run(true, &custom_call_cost);
+    LOG(INFO) << name << ": generated code " << generated_cost << " ms, host custom call " << custom_call_cost
+              << " ms, speedup " << generated_cost / custom_call_cost;
+    return {generated_out, custom_call_out};
+  }
+
+ private:
+  frontend::Program program_;
+  std::string output_;
+  int repeat_;
+};
+
+TEST(HostCustomCall, matmul) {
+  frontend::NetBuilder builder("matmul");
+  auto x       = builder.CreateInput(Float(32), {256, 512}, "x");
+  auto y       = builder.CreateInput(Float(32), {512, 256}, "y");
+  auto out     = builder.Matmul(x, y);
+  auto results = HostCustomCallBenchmark(builder.Build(), out->id).Compare("matmul [256, 512] x [512, 256]");
+  ASSERT_EQ(results.first.size(), results.second.size());
+  for (int i = 0; i < results.first.size(); ++i) {
+    ASSERT_NEAR(results.first[i], results.second[i], 1e-3);
+  }
+}
+
+TEST(HostCustomCall, memset) {
+  frontend::NetBuilder builder("memset");
+  auto out     = builder.FillConstant<float>({1024, 1024}, 0.0f, "out");
+  auto results = HostCustomCallBenchmark(builder.Build(), out->id).Compare("fill_constant [1024, 1024] 0");
+  ASSERT_EQ(results.first, results.second);
+}
+
+TEST(HostCustomCall, memcpy) {
+  frontend::NetBuilder builder("memcpy");
+  auto x       = builder.CreateInput(Float(32), {1024, 1024}, "x");
+  auto out     = builder.Reshape(x, {1024 * 1024});
+  auto results = HostCustomCallBenchmark(builder.Build(), out->id).Compare("reshape [1024, 1024]");
+  ASSERT_EQ(results.first, results.second);
+}
+
+TEST(HostCustomCall, random) {
+  // the random ops have no generated code on host, the strategies of gaussian_random and uniform_random don't
+  // compute the output, so they are only benchmarked through the custom calls and checked by the statistics
+  auto check_moments = [](const std::vector<float>& values, double mean, double std) {
+    double sum = 0.0, square_sum = 0.0;
+    for (float v : values) {
+      sum += v;
+      square_sum += v * v;
+    }
+    double actual_mean = sum / values.size();
+    EXPECT_NEAR(actual_mean, mean, 0.05);
+    EXPECT_NEAR(std::sqrt(square_sum / values.size() - actual_mean * actual_mean), std, 0.05);
+  };
+  double cost = 0.0;
+  {
+    frontend::NetBuilder builder("gaussian_random");
+    auto out    = builder.GaussianRandom({1024, 1024}, 0.0f, 1.0f, 1);
+    auto values = HostCustomCallBenchmark(builder.Build(), out->id).Run(true, &cost);
+    LOG(INFO) << "gaussian_random [1024, 1024]: host custom call " << cost << " ms";
+    check_moments(values, 0.0, 1.0);
+  }
+  {
+    frontend::NetBuilder builder("uniform_random");
+    auto out    = builder.UniformRandom({1024, 1024}, 0.0f, 1.0f, 1);
+    auto values = HostCustomCallBenchmark(builder.Build(), out->id).Run(true, &cost);
+    LOG(INFO) << "uniform_random [1024, 1024]: host custom call " << cost << " ms";
+    check_moments(values, 0.5, std::sqrt(1.0 / 12));
+  }
+}
+
+}  // namespace tests
+}  // namespace cinn
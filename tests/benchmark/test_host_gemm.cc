@@ -0,0 +1,157 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/hlir/pe/schedule.h"
+#include "cinn/hlir/pe/transform.h"
+#include "cinn/runtime/cpu/host_gemm.h"
+#include "cinn/utils/timer.h"
+
+namespace cinn {
+namespace tests {
+
+struct GemmShape {
+  std::string name;
+  int batch;
+  int M;
+  int N;
+  int K;
+  bool trans_b;
+};
+
+// Measure the GFLOP/s of the built-in gemm of the host on the shape
+double MeasureGemm(const GemmShape& shape, int repeat = 10) {
+  std::vector<float> A(static_cast<size_t>(shape.batch) * shape.M * shape.K, 0.5f);
+  std::vector<float> B(static_cast<size_t>(shape.batch) * shape.K * shape.N, 0.25f);
+  std::vector<float> C(static_cast<size_t>(shape.batch) * shape.M * shape.N);
+  auto run = [&]() {
+    for (int i = 0; i < shape.batch; ++i) {
+      runtime::cpu::PackedGemm<float>(shape.M,
+                                      shape.N,
+                                      shape.K,
+                                      1.0f,
+                                      A.data() + static_cast<size_t>(i) * shape.M * shape.K,
+                                      shape.K,
+                                      1,
+                                      B.data() + static_cast<size_t>(i) * shape.K * shape.N,
+                                      shape.trans_b ? 1 : shape.N,
+                                      shape.trans_b ? shape.K : 1,
+                                      0.0f,
+                                      C.data() + static_cast<size_t>(i) * shape.M * shape.N,
+                                      shape.N,
+                                      1);
+    }
+  };
+  // warmup
+  run();
+  utils::Timer timer;
+  timer.Start();
+  for (int i = 0; i < repeat; ++i) {
+    run();
+  }
+  double cost = timer.Stop() / repeat;
+  CHECK_EQ(C.back(), 0.125f * shape.K);
+  return 2.0 * shape.batch * shape.M * shape.N * shape.K / cost * 1e-6;
+}
+
+// Measure the GFLOP/s of the code generated for the matmul of 2-D tensors on the shape, which packs B and is
+// scheduled by MatmulScheduleCPU as the matmul op on X86 without the custom call of the built-in gemm
+double MeasureGeneratedMatmul(const GemmShape& shape, int repeat = 3) {
+  CHECK_EQ(shape.batch, 1) << "Only the matmul of 2-D tensors is measured";
+  auto target = common::DefaultHostTarget();
+  Placeholder<float> A("A", {Expr(shape.M), Expr(shape.K)});
+  Placeholder<float> B("B", shape.trans_b ? std::vector<Expr>{Expr(shape.N), Expr(shape.K)}
+                                          : std::vector<Expr>{Expr(shape.K), Expr(shape.N)});
+  auto outs    = hlir::pe::MatmulV2(A.tensor(), B.tensor(), false, shape.trans_b, 1.0f, "C", target);
+  auto C       = outs[0];
+  auto packedB = outs[1];
+  auto stages  = CreateStages({C, packedB});
+  hlir::pe::MatmulScheduleCPU(stages, C, packedB, target);
+
+  Module::Builder builder("module_generated_matmul", target);
+  auto func = Lower("fn_generated_matmul", stages, {A, B, C, packedB});
+  builder.AddFunction(func);
+  auto jit = backends::ExecutionEngine::Create({});
+  jit->Link(builder.Build());
+  auto fn = reinterpret_cast<void (*)(void*, int32_t)>(jit->Lookup("fn_generated_matmul"));
+  CHECK(fn);
+
+  auto to_ints = [](const std::vector<Expr>& dims) {
+    std::vector<int> res;
+    for (const auto& dim : dims) {
+      res.push_back(dim.as_int32());
+    }
+    return res;
+  };
+  auto* a_buf       = common::BufferBuilder(Float(32), to_ints(A->shape)).set_align(64).set_zero().Build();
+  auto* b_buf       = common::BufferBuilder(Float(32), to_ints(B->shape)).set_align(64).set_zero().Build();
+  auto* c_buf       = common::BufferBuilder(Float(32), {shape.M, shape.N}).set_align(64).set_zero().Build();
+  auto* packed_buf  = common::BufferBuilder(Float(32), to_ints(packedB->shape)).set_align(64).set_zero().Build();
+  auto* a_data      = reinterpret_cast<float*>(a_buf->memory);
+  auto* b_data      = reinterpret_cast<float*>(b_buf->memory);
+  auto* c_data      = reinterpret_cast<float*>(c_buf->memory);
+  std::fill(a_data, a_data + static_cast<size_t>(shape.M) * shape.K, 0.5f);
+  std::fill(b_data, b_data + static_cast<size_t>(shape.K) * shape.N, 0.25f);
+  cinn_pod_value_t args[] = {
+      cinn_pod_value_t(a_buf), cinn_pod_value_t(b_buf), cinn_pod_value_t(c_buf), cinn_pod_value_t(packed_buf)};
+
+  // warmup
+  fn(args, 4);
+  utils::Timer timer;
+  timer.Start();
+  for (int i = 0; i < repeat; ++i) {
+    fn(args, 4);
+  }
+  double cost = timer.Stop() / repeat;
+  CHECK_EQ(c_data[static_cast<size_t>(shape.M) * shape.N - 1], 0.125f * shape.K);
+  for (auto* buf : {a_buf, b_buf, c_buf, packed_buf}) {
+    cinn_buffer_free(nullptr, buf);
+  }
+  return 2.0 * shape.M * shape.N * shape.K / cost * 1e-6;
+}
+
+TEST(HostGemm, transformer_shapes) {
+  // BERT-base with batch size 8 and sequence length 128, the heads of the attention are batched
+  std::vector<GemmShape> shapes = {{"qkv projection", 1, 1024, 2304, 768, false},
+                                   {"output projection", 1, 1024, 768, 768, false},
+                                   {"ffn up", 1, 1024, 3072, 768, false},
+                                   {"ffn down", 1, 1024, 768, 3072, false},
+                                   {"attention q * k^T", 96, 128, 128, 64, true},
+                                   {"attention score * v", 96, 128, 64, 128, false},
+                                   {"decoding step", 1, 8, 3072, 768, false}};
+  const auto& blocking = runtime::cpu::GetGemmBlocking<float>();
+  LOG(INFO) << "The gemm micro-kernel uses " << blocking.isa << " with mr=" << blocking.mr << ", nr=" << blocking.nr
+            << ", kc=" << blocking.kc << ", mc=" << blocking.mc << ", nc=" << blocking.nc;
+  for (const auto& shape : shapes) {
+    LOG(INFO) << shape.name << " [" << shape.batch << ", " << shape.M << ", " << shape.N << ", " << shape.K
+              << "]: " << MeasureGemm(shape) << " GFLOP/s";
+    // compare with the generated code on the 2-D shapes
+    if (shape.batch == 1) {
+      LOG(INFO) << shape.name << " by the generated code with MatmulScheduleCPU: " << MeasureGeneratedMatmul(shape)
+                << " GFLOP/s";
+    }
+  }
+}
+
+}  // namespace tests
+}  // namespace cinn